@@ -17,6 +17,7 @@ SOURCES += src/main.cpp \
     src/audio/format.cpp \
     src/audio/plugin.cpp \
     src/audio/stream.cpp \
+    src/audio/plugins/virtual.cpp \
     \
     src/chart/crestfactorplot.cpp \
     src/chart/cursorhelper.cpp \
@@ -26,6 +27,7 @@ SOURCES += src/main.cpp \
     src/chart/levelobject.cpp \
     src/chart/levelplot.cpp \
     src/chart/meterplot.cpp \
+    src/chart/minmaxpyramid.cpp \
     src/chart/nyquistplot.cpp \
     src/chart/palette.cpp \
     src/chart/phasedelayplot.cpp \
@@ -50,8 +52,8 @@ SOURCES += src/main.cpp \
     src/common/appearance.cpp \
     src/common/logger.cpp \
     src/common/notifier.cpp \
-    src/common/profiler.cpp \
     src/common/settings.cpp \
+    src/common/trace.cpp \
     \
     src/filesystem/dialog.cpp \
     src/filesystem/dialogPlugin.cpp \
@@ -78,6 +80,7 @@ SOURCES += src/main.cpp \
     src/shared/sourcelist_shared.cpp \
     src/source/equalizer.cpp \
     src/sourcelist.cpp \
+    src/headless.cpp \
     src/targettrace.cpp \
     \
     src/math/bandpass.cpp \
@@ -85,6 +88,7 @@ SOURCES += src/main.cpp \
     src/math/equalloudnesscontour.cpp \
     src/math/integration_tree.cpp \
     src/math/leq.cpp \
+    src/math/levelhistory.cpp \
     src/math/lowpassfilter.cpp \
     src/math/notch.cpp \
     src/math/weighting.cpp \
@@ -95,6 +99,12 @@ SOURCES += src/main.cpp \
     src/math/fouriertransform.cpp \
     src/math/windowfunction.cpp \
     src/math/deconvolution.cpp \
+    src/math/binmeter.cpp \
+    src/math/batchtransform.cpp \
+    src/math/delayfinder.cpp \
+    src/math/decimationtree.cpp \
+    src/math/spectrumkernel.cpp \
+    src/math/complexkernel.cpp \
     \
     src/meta/metabase.cpp \
     src/meta/metafilter.cpp \
@@ -105,6 +115,7 @@ SOURCES += src/main.cpp \
     src/model/metertablemodel.cpp \
     src/model/sourcemodel.cpp \
     \
+    src/remote/connection.cpp \
     src/remote/generatorremote.cpp \
     src/remote/item.cpp \
     src/remote/items/groupitem.cpp \
@@ -122,6 +133,8 @@ SOURCES += src/main.cpp \
     src/source/standardline.cpp \
     src/source/union.cpp \
     src/source/stored.cpp \
+    src/source/compactdata.cpp \
+    src/source/analysisscheduler.cpp \
     src/source/measurement.cpp \
     \
 
@@ -173,6 +186,7 @@ HEADERS += \
     src/audio/format.h \
     src/audio/plugin.h \
     src/audio/stream.h \
+    src/audio/plugins/virtual.h \
     src/chart/crestfactorplot.h \
     src/chart/cursorhelper.h \
     src/chart/frequencybasedplot.h \
@@ -181,6 +195,7 @@ HEADERS += \
     src/chart/levelobject.h \
     src/chart/levelplot.h \
     src/chart/meterplot.h \
+    src/chart/minmaxpyramid.h \
     src/chart/nyquistplot.h \
     src/chart/palette.h \
     src/chart/phasedelayplot.h \
@@ -214,7 +229,6 @@ HEADERS += \
     src/common/logger.h \
     src/generator/mnoise.h \
     src/common/notifier.h \
-    src/common/profiler.h \
     src/math/bandpass.h \
     src/math/bessellpf.h \
     src/math/biquad.h \
@@ -222,6 +236,7 @@ HEADERS += \
     src/math/filter.h \
     src/math/integration_tree.h \
     src/math/leq.h \
+    src/math/levelhistory.h \
     src/math/lowpassfilter.h \
     src/math/notch.h \
     src/math/weighting.h \
@@ -231,6 +246,7 @@ HEADERS += \
     src/meta/metameasurement.h \
     src/meta/metastored.h \
     src/meta/metawindowing.h \
+    src/remote/connection.h \
     src/remote/generatorremote.h \
     src/remote/item.h \
     src/remote/items/groupitem.h \
@@ -247,6 +263,7 @@ HEADERS += \
     src/model/metertablemodel.h \
     src/model/sourcemodel.h \
     src/source/standardline.h \
+    src/headless.h \
     src/targettrace.h \
     src/source/union.h \
     src/generator/generator.h \
@@ -258,11 +275,14 @@ HEADERS += \
     src/generator/sinsweep.h \
     src/generator/sample.h \
     src/source/stored.h \
+    src/source/compactdata.h \
     src/chart/axis.h \
     src/chart/painteditem.h \
     src/chart/type.h \
+    src/source/analysisscheduler.h \
     src/source/measurement.h \
     src/common/settings.h \
+    src/common/trace.h \
     src/chart/variablechart.h \
     src/chart/plot.h \
     src/chart/rtaplot.h \
@@ -276,11 +296,19 @@ HEADERS += \
     src/math/complex.h \
     src/math/fouriertransform.h \
     src/math/deconvolution.h \
+    src/math/delayfinder.h \
+    src/math/decimationtree.h \
+    src/math/spectrumkernel.h \
+    src/math/complexkernel.h \
+    src/math/binmeter.h \
+    src/math/batchtransform.h \
     src/math/windowfunction.h \
     src/math/deconvolution.h \
     src/container/fifo.h \
     src/container/circular.h \
-    src/container/array.h
+    src/container/array.h \
+    src/container/span.h \
+    src/container/sharedvector.h
 
 #math
 equals(QT_ARCH, "arm64")|equals(QT_ARCH, "arm") {
@@ -480,6 +508,7 @@ isEqual(GRAPH, "OPENGL") {
 
     HEADERS += \
         src/chart/opengl/seriesfbo.h \
+        src/chart/opengl/plotfbo.h \
         src/chart/opengl/rtaseriesrenderer.h \
         src/chart/opengl/seriesrenderer.h \
         src/chart/opengl/impulseseriesrenderer.h \
@@ -499,6 +528,7 @@ isEqual(GRAPH, "OPENGL") {
     SOURCES += \
         src/chart/opengl/plotseriescreator.cpp \
         src/chart/opengl/seriesfbo.cpp \
+        src/chart/opengl/plotfbo.cpp \
         src/chart/opengl/rtaseriesrenderer.cpp \
         src/chart/opengl/seriesrenderer.cpp \
         src/chart/opengl/impulseseriesrenderer.cpp \
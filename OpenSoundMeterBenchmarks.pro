@@ -0,0 +1,18 @@
+# Benchmarks of the DSP and data paths, built from the application sources without the UI entry point:
+#   qmake OpenSoundMeterBenchmarks.pro && make
+#   ./OpenSoundMeterBenchmarks --json results.json [--filter FourierTransform]
+include(OpenSoundMeter.pro)
+
+TARGET = OpenSoundMeterBenchmarks
+CONFIG += console
+CONFIG -= app_bundle
+
+SOURCES -= src/main.cpp
+SOURCES += \
+    benchmarks/benchmark.cpp \
+    benchmarks/main.cpp
+
+HEADERS += \
+    benchmarks/benchmark.h
+
+RESOURCES -= qml.qrc
@@ -0,0 +1,109 @@
+/**
+ *  OSM
+ *  Copyright (C) 2026  Pavel Smokotnin
+
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "benchmark.h"
+#include <algorithm>
+#include <numeric>
+#include <QDateTime>
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QSysInfo>
+#include <QTextStream>
+
+#ifndef APP_GIT_VERSION
+#define APP_GIT_VERSION "unknow"
+#endif
+
+namespace benchmark {
+
+Runner::Runner(const QString &filter) : m_filter(filter), m_results()
+{
+}
+
+void Runner::run(const QString &name, unsigned int iterations, const std::function<void ()> &body)
+{
+    if (!m_filter.isEmpty() && !name.contains(m_filter)) {
+        return;
+    }
+
+    constexpr unsigned int WARM_UP = 3;
+    for (unsigned int i = 0; i < WARM_UP; ++i) {
+        body();
+    }
+
+    std::vector<double> times(iterations);
+    QElapsedTimer timer;
+    for (auto &time : times) {
+        timer.start();
+        body();
+        time = timer.nsecsElapsed();
+    }
+
+    std::sort(times.begin(), times.end());
+    Result result {
+        name,
+        iterations,
+        times.front(),
+        times[times.size() / 2],
+        std::accumulate(times.begin(), times.end(), 0.0) / times.size()
+    };
+    m_results.push_back(result);
+
+    QTextStream(stdout) << qSetFieldWidth(40) << Qt::left << name << qSetFieldWidth(0)
+                        << " median " << result.median / 1000 << " us"
+                        << ", mean " << result.mean / 1000 << " us"
+                        << ", min " << result.min / 1000 << " us\n";
+}
+
+QJsonObject Runner::toJSON() const
+{
+    QJsonArray results;
+    for (auto &result : m_results) {
+        results.append(QJsonObject {
+            {"name",        result.name},
+            {"iterations",  static_cast<int>(result.iterations)},
+            {"min",         result.min},
+            {"median",      result.median},
+            {"mean",        result.mean}
+        });
+    }
+
+    return {
+        {"version",     APP_GIT_VERSION},
+        {"qt",          qVersion()},
+        {"cpu",         QSysInfo::currentCpuArchitecture()},
+        {"os",          QSysInfo::prettyProductName()},
+        {"date",        QDateTime::currentDateTimeUtc().toString(Qt::ISODate)},
+        {"unit",        "ns"},
+        {"results",     results}
+    };
+}
+
+bool Runner::save(const QString &fileName) const
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning() << "couldn't open" << fileName;
+        return false;
+    }
+    return file.write(QJsonDocument(toJSON()).toJson()) != -1;
+}
+
+} // namespace benchmark
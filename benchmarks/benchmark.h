@@ -0,0 +1,55 @@
+/**
+ *  OSM
+ *  Copyright (C) 2026  Pavel Smokotnin
+
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <functional>
+#include <vector>
+#include <QJsonObject>
+#include <QString>
+
+namespace benchmark {
+
+struct Result {
+    QString name;
+    unsigned int iterations;
+    double min, median, mean; //ns per iteration
+};
+
+/**
+ * @brief times named bodies
+ * Each body runs a few warm-up iterations first, then every iteration is timed on the monotonic clock.
+ */
+class Runner
+{
+public:
+    explicit Runner(const QString &filter = {});
+
+    void run(const QString &name, unsigned int iterations, const std::function<void()> &body);
+
+    QJsonObject toJSON() const;
+    bool save(const QString &fileName) const;
+
+private:
+    QString m_filter;
+    std::vector<Result> m_results;
+};
+
+} // namespace benchmark
+
+#endif // BENCHMARK_H
@@ -0,0 +1,399 @@
+/**
+ *  OSM
+ *  Copyright (C) 2026  Pavel Smokotnin
+
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <cmath>
+#include <memory>
+#include <random>
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QJsonDocument>
+
+#include "benchmark.h"
+#include "chart/minmaxpyramid.h"
+#include "math/averaging.h"
+#include "math/batchtransform.h"
+#include "math/bessellpf.h"
+#include "math/binmeter.h"
+#include "math/coherence.h"
+#include "math/complexkernel.h"
+#include "math/deconvolution.h"
+#include "math/delayfinder.h"
+#include "math/fouriertransform.h"
+#include "math/meter.h"
+#include "math/spectrumkernel.h"
+#include "math/weighting.h"
+#include "meta/metameasurement.h"
+#include "remote/network.h"
+#include "remote/server.h"
+#include "sourcelist.h"
+#include "source/group.h"
+#include "source/stored.h"
+#include "source/union.h"
+
+//! the same random signals on every run
+static std::mt19937 s_random(2025);
+//! results are written here, so the compiler keeps the loops
+static volatile float s_sink = 0;
+
+static float noise()
+{
+    static std::normal_distribution<float> distribution(0.f, 0.25f);
+    return distribution(s_random);
+}
+
+//! a FFT16 trace with random data
+static std::shared_ptr<Stored> makeStored()
+{
+    constexpr unsigned int size = 1 << 16;
+    constexpr float sampleRate = 48000;
+
+    std::vector<Abstract::Data::FTData> ftdata(size / 2);
+    for (unsigned int i = 0; i < ftdata.size(); ++i) {
+        Complex phase;
+        phase.polar(noise() * static_cast<float>(M_PI));
+        ftdata[i] = {i * sampleRate / size, std::abs(noise()), std::abs(noise()), phase, 0.9f, 1.f, 0.5f};
+    }
+
+    std::vector<Abstract::Data::TimeData> timeData(size);
+    for (unsigned int i = 0; i < size; ++i) {
+        timeData[i] = {(static_cast<float>(i) - size / 2 + 1) * 1000.f / sampleRate, noise()};
+    }
+
+    auto stored = std::make_shared<Stored>();
+    stored->setFrequencyDomainData(std::move(ftdata));
+    stored->setTimeDomainData(std::move(timeData));
+    stored->setActive(true);
+    return stored;
+}
+
+static void fill(FourierTransform &ft, Deconvolution *deconvolution = nullptr)
+{
+    for (unsigned int i = 0; i < ft.size(); ++i) {
+        auto d = noise(), r = noise();
+        ft.add(d, r);
+        if (deconvolution) {
+            deconvolution->add(d, r);
+        }
+    }
+}
+
+static void mathBenchmarks(benchmark::Runner &runner)
+{
+    const std::vector<std::pair<Meta::Measurement::Mode, QString>> modes = {
+        {Meta::Measurement::FFT10, "FFT10"}, {Meta::Measurement::FFT11, "FFT11"}, {Meta::Measurement::FFT12, "FFT12"},
+        {Meta::Measurement::FFT13, "FFT13"}, {Meta::Measurement::FFT14, "FFT14"}, {Meta::Measurement::FFT15, "FFT15"},
+        {Meta::Measurement::FFT16, "FFT16"}, {Meta::Measurement::LFT, "LFT"},
+        {Meta::Measurement::CQT, "CQT"}
+    };
+
+    //configured as Measurement::updateFftPower does
+    for (auto &[mode, name] : modes) {
+        FourierTransform ft;
+        if (mode == Meta::Measurement::LFT) {
+            ft.setSize(1 << 12);
+            ft.setType(FourierTransform::Log);
+        } else if (mode == Meta::Measurement::CQT) {
+            ft.setSize(1 << 12);
+            ft.setType(FourierTransform::MultiRate);
+        } else {
+            ft.setSize(1 << (10 + mode));
+            ft.setType(FourierTransform::Fast);
+        }
+        ft.setSampleRate(48000);
+        ft.prepare();
+        fill(ft);
+
+        runner.run("FourierTransform::transform/" + name, 100, [&ft]() {
+            ft.transform();
+        });
+    }
+
+    //a rig of 16 measurements at FFT14: one by one and as one batch
+    std::vector<std::unique_ptr<FourierTransform>> rig;
+    std::vector<FourierTransform *> batch;
+    for (unsigned int i = 0; i < 16; ++i) {
+        rig.push_back(std::make_unique<FourierTransform>(1 << 14));
+        rig.back()->setWindowFunctionType(WindowFunction::Hann);
+        rig.back()->prepareFast();
+        fill(*rig.back());
+        batch.push_back(rig.back().get());
+    }
+    runner.run("FourierTransform::transform/16xFFT14", 20, [&]() {
+        for (auto *instance : batch) {
+            instance->transform();
+        }
+    });
+    math::BatchTransform batchTransform;
+    runner.run("BatchTransform::transform/16xFFT14", 20, [&]() {
+        batchTransform.transform(batch);
+    });
+
+    FourierTransform ft(1 << 16);
+    ft.setType(FourierTransform::Fast);
+    ft.setSampleRate(48000);
+    ft.prepare();
+    Deconvolution deconvolution(1 << 16);
+    fill(ft, &deconvolution);
+    ft.transform();
+    runner.run("Deconvolution::transform/FFT16", 50, [&]() {
+        deconvolution.transform(&ft);
+    });
+
+    //one coarse and one refine stage, the former estimate was the FFT16 deconvolution above
+    math::DelayFinder delayFinder;
+    delayFinder.setSampleRate(48000);
+    for (unsigned int i = 0; i < math::DelayFinder::HISTORY; ++i) {
+        delayFinder.add(noise(), noise());
+    }
+    runner.run("DelayFinder::estimate", 50, [&]() {
+        for (unsigned int i = 0; i < math::DelayFinder::INTERVAL; ++i) {
+            delayFinder.step();
+        }
+    });
+
+    //steady cost of one estimate interval: 25 timer frames of 80 ms and the estimate itself,
+    //the former finder fed a 64k deconvolution and ran its transform pair once per interval
+    std::vector<std::pair<float, float>> interval(math::DelayFinder::INTERVAL * 3840);
+    for (auto &sample : interval) {
+        sample = {noise(), noise()};
+    }
+    Deconvolution formerFinder(1 << 16);
+    runner.run("DelayFinder::interval/Deconvolution", 20, [&]() {
+        for (auto &[d, r] : interval) {
+            formerFinder.add(d, r);
+        }
+        formerFinder.transform(nullptr);
+    });
+    runner.run("DelayFinder::interval/DecimationTree", 20, [&]() {
+        for (auto &[d, r] : interval) {
+            delayFinder.add(d, r);
+        }
+        for (unsigned int i = 0; i < math::DelayFinder::INTERVAL; ++i) {
+            delayFinder.step();
+        }
+    });
+
+    auto bins = static_cast<unsigned int>(ft.getFrequencies().size());
+    Coherence coherence;
+    coherence.setDepth(21);
+    coherence.setSize(bins);
+    std::vector<float> coherencePlane(bins);
+    runner.run("Coherence::calculate/FFT16", 100, [&]() {
+        coherence.calculate(coherencePlane.data(), &ft);
+    });
+
+    math::SpectrumKernel spectrumKernel;
+    spectrumKernel.setSize(bins);
+    std::vector<float> magnitudes(bins), modules(bins), squares(bins);
+    std::vector<Complex> phases(bins);
+    runner.run("SpectrumKernel::process/FFT16", 100, [&]() {
+        spectrumKernel.process(ft.afData(), ft.bfData(), 0, bins, true,
+                               magnitudes.data(), modules.data(), phases.data(), squares.data());
+    });
+
+    std::vector<float> arguments(bins);
+    runner.run("Complex::arg/FFT16", 100, [&]() {
+        for (unsigned int i = 0; i < bins; ++i) {
+            arguments[i] = phases[i].arg();
+        }
+    });
+    runner.run("ComplexKernel::arg/FFT16", 100, [&]() {
+        math::ComplexKernel::arg(phases, arguments);
+    });
+    auto frequencies = ft.getFrequencies();
+    runner.run("ComplexKernel::rotateByDelay/FFT16", 100, [&]() {
+        math::ComplexKernel::rotateByDelay(phases, frequencies, 1.5f, 0.f, phases);
+    });
+
+    std::vector<float> values(bins);
+    for (auto &value : values) {
+        value = std::abs(noise());
+    }
+
+    Averaging<float> fifo;
+    fifo.setSize(bins);
+    fifo.setDepth(16);
+    float sink = 0;
+    runner.run("Averaging::FIFO/FFT16", 100, [&]() {
+        for (unsigned int i = 0; i < bins; ++i) {
+            fifo.append(i, values[i]);
+            sink += fifo.value(i);
+        }
+    });
+
+    Container::array<Filter::BesselLPF<float>> lpfs;
+    lpfs.resize(bins);
+    runner.run("Averaging::LPF/FFT16", 100, [&]() {
+        for (unsigned int i = 0; i < bins; ++i) {
+            sink += lpfs[i](values[i]);
+        }
+    });
+
+    math::BinMeter binMeter;
+    binMeter.setSize(bins);
+    std::vector<float> peaks(bins), means(bins);
+    runner.run("BinMeter::add/FFT16", 100, [&]() {
+        binMeter.add(values.data(), peaks.data(), means.data());
+    });
+
+    //one 80 ms frame of the measurement timer
+    constexpr unsigned int frame = 3840;
+    std::vector<float> signal(frame);
+    for (auto &sample : signal) {
+        sample = noise();
+    }
+
+    Weighting weighting(Weighting::A, 48000);
+    runner.run("Weighting::A/frame", 500, [&]() {
+        for (auto &sample : signal) {
+            sink += weighting(sample);
+        }
+    });
+
+    Meter meter(Weighting(Weighting::A, 48000), Meter::Fast);
+    runner.run("Meter::add/frame", 500, [&]() {
+        for (auto &sample : signal) {
+            meter.add(sample);
+        }
+    });
+
+    //macro: a frame through the measurement transform path
+    Averaging<float> magnitudeAvg;
+    magnitudeAvg.setSize(bins);
+    magnitudeAvg.setDepth(16);
+    runner.run("Pipeline::frame/FFT16", 50, [&]() {
+        for (auto &sample : signal) {
+            ft.add(sample, sample);
+            deconvolution.add(sample, sample);
+        }
+        ft.transform();
+        deconvolution.transform(&ft);
+        for (unsigned int i = 0; i < bins; ++i) {
+            magnitudeAvg.append(i, ft.af(i).abs() / ft.bf(i).abs());
+        }
+        coherence.calculate(coherencePlane.data(), &ft);
+    });
+
+    s_sink = sink;
+}
+
+static void sourceBenchmarks(benchmark::Runner &runner)
+{
+    auto a = makeStored(), b = makeStored();
+    a->setGain(3);
+
+    Union sum;
+    sum.setCount(2);
+    sum.setSource(0, Shared::Source{a});
+    sum.setSource(1, Shared::Source{b});
+    sum.setActive(true);
+    const std::vector<std::pair<Union::Type, QString>> types = {
+        {Union::Vector, "Vector"}, {Union::Polar, "Polar"}, {Union::dB, "dB"}, {Union::Power, "Power"}
+    };
+    for (auto &[type, name] : types) {
+        sum.setType(type);
+        runner.run("Union::calc/" + name, 50, [&sum]() {
+            sum.calc();
+        });
+    }
+
+    QJsonObject json;
+    runner.run("Stored::toJSON/FFT16", 10, [&]() {
+        json = a->toJSON();
+    });
+    runner.run("Stored::save/FFT16", 10, [&]() {
+        QJsonDocument(a->toJSON()).toJson(QJsonDocument::Compact);
+    });
+    runner.run("Stored::fromJSON/FFT16", 10, [&]() {
+        Stored loaded;
+        loaded.fromJSON(json);
+    });
+
+    Chart::MinMaxPyramid pyramid;
+    runner.run("MinMaxPyramid::build/FFT16", 50, [&]() {
+        std::vector<float> times(a->timeDomainSize()), values(a->timeDomainSize());
+        for (unsigned int i = 0; i < a->timeDomainSize(); ++i) {
+            times[i]  = a->impulseTime(i);
+            values[i] = a->impulseValue(i);
+        }
+        pyramid.build(std::move(times), std::move(values));
+    });
+    runner.run("MinMaxPyramid::draw/FFT16", 500, [&]() {
+        float sink = 0;
+        pyramid.draw(pyramid.time(0), pyramid.time(pyramid.size() - 1), 1920, [&sink](float, float value) {
+            sink += value;
+        });
+        s_sink = sink;
+    });
+
+    //a session of stored libraries: 8 groups of 64 traces
+    SourceList list(nullptr, false);
+    QList<QUuid> uuids;
+    for (unsigned int g = 0; g < 8; ++g) {
+        auto group = std::dynamic_pointer_cast<Source::Group>(list.addGroup());
+        for (unsigned int i = 0; i < 64; ++i) {
+            Shared::Source stored{std::make_shared<Stored>()};
+            group->add(stored);
+            uuids.push_back(stored->uuid());
+        }
+    }
+    runner.run("SourceList::getByUUid/512", 100, [&]() {
+        float sink = 0;
+        for (auto &uuid : uuids) {
+            sink += list.getByUUid(uuid) ? 1 : 0;
+        }
+        s_sink = sink;
+    });
+
+    Shared::Source source{a};
+    remote::Server::Resolution full, banded;
+    banded.pointsPerOctave = 48;
+    runner.run("Server::sourceData/full", 10, [&]() {
+        auto data = QJsonDocument(remote::Server::sourceData(source, remote::Network::ALL_FIELDS, full)).toJson(
+                        QJsonDocument::Compact);
+        qCompress(data);
+    });
+    runner.run("Server::sourceData/48ppo", 50, [&]() {
+        auto data = QJsonDocument(remote::Server::sourceData(source, remote::Network::ALL_FIELDS & ~remote::Network::IMPULSE,
+                                                             banded)).toJson(QJsonDocument::Compact);
+        qCompress(data);
+    });
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("OpenSoundMeterBenchmarks");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Benchmarks of the DSP and data paths");
+    parser.addHelpOption();
+    QCommandLineOption jsonOption("json", "Write results to <file>.", "file");
+    QCommandLineOption filterOption("filter", "Run only benchmarks which names contain <name>.", "name");
+    parser.addOption(jsonOption);
+    parser.addOption(filterOption);
+    parser.process(app);
+
+    benchmark::Runner runner(parser.value(filterOption));
+    mathBenchmarks(runner);
+    sourceBenchmarks(runner);
+
+    if (parser.isSet(jsonOption) && !runner.save(parser.value(jsonOption))) {
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,83 @@
+/**
+ *  OSM
+ *  Copyright (C) 2026  Pavel Smokotnin
+
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+import QtQuick 2.9
+import QtQuick.Controls 2.2
+import QtQuick.Layouts 1.3
+
+Item {
+    id: diagnostics
+    property var dataObject
+    property var statistics: trace.toJSON()
+
+    function format(value) {
+        return Number(value).toLocaleString(locale, 'f', value < 100 ? 1 : 0);
+    }
+
+    Timer {
+        interval: 1000
+        running: diagnostics.visible
+        repeat: true
+        onTriggered: diagnostics.statistics = trace.toJSON();
+    }
+
+    RowLayout {
+        anchors.fill: parent
+        spacing: 10
+
+        ColumnLayout {
+            Layout.alignment: Qt.AlignTop
+            Label { text: qsTr("stage") }
+            Label { text: qsTr("p50, µs") }
+            Label { text: qsTr("p99, µs") }
+            Label { text: qsTr("max, µs") }
+            Label { text: qsTr("count") }
+        }
+
+        Repeater {
+            model: diagnostics.statistics.stages
+
+            ColumnLayout {
+                Layout.alignment: Qt.AlignTop
+                Layout.fillWidth: true
+                Label { text: modelData.stage; font.bold: true }
+                Label { text: diagnostics.format(modelData.p50) }
+                Label { text: diagnostics.format(modelData.p99) }
+                Label { text: diagnostics.format(modelData.max) }
+                Label { text: modelData.count }
+            }
+        }
+
+        ColumnLayout {
+            Layout.alignment: Qt.AlignTop
+
+            Button {
+                text: qsTr("reset")
+                onClicked: {
+                    trace.reset();
+                    diagnostics.statistics = trace.toJSON();
+                }
+            }
+
+            Label {
+                text: qsTr("dropped: %1").arg(diagnostics.statistics.dropped)
+                ToolTip.visible: hovered
+                ToolTip.text: qsTr("events overwritten before they were collected")
+            }
+        }
+    }
+}
@@ -0,0 +1,50 @@
+/**
+ *  OSM
+ *  Copyright (C) 2026  Pavel Smokotnin
+
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+import QtQuick 2.0
+import QtQuick.Controls 2.1
+import QtQuick.Layouts 1.3
+import QtQuick.Controls.Material 2.2
+
+Popup {
+    id: popup
+    width: 300
+    height: 100
+    x: (parent ? (parent.width  - width) / 2 : 100)
+    y: (parent ? (parent.height - height) / 2 : 100)
+
+    modal: false
+    closePolicy: Popup.NoAutoClose
+    visible: sourceList.ioActive
+
+    ColumnLayout {
+        anchors.fill: parent
+
+        ProgressBar {
+            Layout.fillWidth: true
+            from: 0
+            to: 1
+            value: sourceList.ioProgress
+        }
+
+        Button {
+            Layout.alignment: Qt.AlignHCenter
+            text: qsTr("Cancel")
+            onClicked: sourceList.cancelIO();
+        }
+    }
+}
@@ -167,6 +167,17 @@ ApplicationWindow {
         id: dialog
     }
 
+    SessionProgress {
+        id: sessionProgress
+
+        Connections {
+            target: sourceList
+            function onIoFailed(fileName) {
+                message.showError(qsTr("could not process the file"));
+            }
+        }
+    }
+
     Shortcuts {
         id:shortcutsPopup
         anchors.centerIn: parent
@@ -179,7 +190,11 @@ ApplicationWindow {
         folder: (typeof shortcuts !== 'undefined' ? shortcuts.home : Filesystem.StandardFolder.Home)
         defaultSuffix: "osm"
         nameFilters: ["Open Sound Meter (*.osm)"]
-        onAccepted: sourceList.save(saveDialog.fileUrl);
+        onAccepted: function() {
+            if (!sourceList.saveAsync(saveDialog.fileUrl)) {
+                message.showError(qsTr("could not save the file"));
+            }
+        }
     }
 
     FileDialog {
@@ -191,7 +206,7 @@ ApplicationWindow {
         nameFilters: ["Open Sound Meter (*.osm)"]
         onAccepted: function() {
             applicationWindow.properiesbar.clear();
-            if (!sourceList.load(openDialog.fileUrl)) {
+            if (!sourceList.loadAsync(openDialog.fileUrl)) {
                 message.showError(qsTr("could not open the file"));
             }
         }
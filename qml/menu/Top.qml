@@ -146,7 +146,7 @@ MenuBar {
                 model: recentFilesModel
                 MenuItem {
                     text: model.fileName
-                    onTriggered: sourceList.load(model.url)
+                    onTriggered: sourceList.loadAsync(model.url)
                 }
                 onObjectAdded: recentFilesMenu.insertItem(index, object);
                 onObjectRemoved: recentFilesMenu.removeItem(object)
@@ -236,6 +236,13 @@ MenuBar {
                 applicationWindow.properiesbar.open(null, "qrc:/Calculator.qml");
             }
         }
+        MenuItem {
+            text: qsTr("&Diagnostics")
+            checkable: false
+            onTriggered: {
+                applicationWindow.properiesbar.open(null, "qrc:/Diagnostics.qml");
+            }
+        }
         MenuItem {
             id: experimentFunctions
             text: qsTr("&Experiment functions")
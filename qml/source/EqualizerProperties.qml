@@ -42,7 +42,7 @@ Item {
                 id: modeSelect
                 model: dataObjectData.modes
                 currentIndex: dataObjectData.mode
-                displayText: (dataObjectData.mode === Measurement.LFT ? "LTW" : (modeSelect.width > 120 ? "Power:" : "") + currentText)
+                displayText: (dataObjectData.mode >= Measurement.LFT ? currentText : (modeSelect.width > 120 ? "Power:" : "") + currentText)
                 ToolTip.visible: hovered
                 ToolTip.text: qsTr("Transfrom mode")
                 onCurrentIndexChanged: dataObjectData.mode = currentIndex;
@@ -41,7 +41,7 @@ Item {
                 id: modeSelect
                 model: dataObjectData.modes
                 currentIndex: dataObjectData.mode
-                displayText: (dataObjectData.mode === Measurement.LFT ? "LTW" : (modeSelect.width > 120 ? "Power:" : "") + currentText)
+                displayText: (dataObjectData.mode >= Measurement.LFT ? currentText : (modeSelect.width > 120 ? "Power:" : "") + currentText)
                 enabled: !dataObjectData.limited
                 ToolTip.visible: hovered
                 ToolTip.text: qsTr("Transfrom mode")
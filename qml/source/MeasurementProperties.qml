@@ -268,7 +268,8 @@ Item {
 
                 ToolTip.visible: hovered
                 ToolTip.text: qsTr("estimated delay delta: <b>%L1ms</b>")
-                    .arg(Number(1000 * dataObjectData.estimatedDelta / dataObjectData.sampleRate).toLocaleString(locale, 'f', 2));
+                    .arg(Number(1000 * dataObjectData.estimatedDelta / dataObjectData.sampleRate).toLocaleString(locale, 'f', 2)) +
+                    (isLocal ? qsTr(", confidence: %L1%").arg(Number(100 * dataObjectData.estimatedConfidence).toLocaleString(locale, 'f', 0)) : "")
             }
 
             Button {
@@ -292,7 +293,7 @@ Item {
                 id: modeSelect
                 model: dataObjectData.modes
                 currentIndex: dataObjectData.mode
-                displayText: (dataObjectData.mode === Measurement.LFT ? "LTW" : (modeSelect.width > 120 ? "Power:" : "") + currentText)
+                displayText: (dataObjectData.mode >= Measurement.LFT ? currentText : (modeSelect.width > 120 ? "Power:" : "") + currentText)
                 ToolTip.visible: hovered
                 ToolTip.text: qsTr("Transfrom mode")
                 onCurrentIndexChanged: dataObjectData.mode = currentIndex;
@@ -309,6 +310,18 @@ Item {
                 Layout.preferredWidth: elementWidth
             }
 
+            DropDown {
+                id: overlapSelect
+                model: dataObjectData.overlaps
+                currentIndex: dataObjectData.overlap
+                enabled: dataObjectData.mode !== Measurement.LFT && dataObjectData.mode !== Measurement.CQT
+                displayText: (overlapSelect.width > 120 ? "Overlap: " : "") + currentText
+                onCurrentIndexChanged: dataObjectData.overlap = currentIndex
+                ToolTip.visible: hovered
+                ToolTip.text: qsTr("overlap of the transforms processed between two updates")
+                Layout.preferredWidth: elementWidth
+            }
+
             DropDown {
                 id: inputFilterSelect
                 model: dataObjectData.inputFilters
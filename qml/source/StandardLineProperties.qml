@@ -96,7 +96,7 @@ Item {
                 id: transformModeSelect
                 model: dataObjectData.transformModes
                 currentIndex: dataObjectData.transformMode
-                displayText: (dataObjectData.transformMode === Measurement.LFT ? "LTW" : (transformModeSelect.width > 120 ? "Power:" : "") + currentText)
+                displayText: (dataObjectData.transformMode >= Measurement.LFT ? currentText : (transformModeSelect.width > 120 ? "Power:" : "") + currentText)
                 enabled: !dataObjectData.limited
                 ToolTip.visible: hovered
                 ToolTip.text: qsTr("Transfrom mode")
@@ -121,6 +121,21 @@ Item {
                     ToolTip.text: qsTr("ignore coherence")
                 }
 
+                Button {
+                    text: qsTr("compact")
+                    checkable: true
+                    checked: dataObjectData.compact
+                    onCheckedChanged: dataObjectData.compact = checked
+
+                    Material.background: parent.Material.background
+
+                    ToolTip.visible: hovered
+                    ToolTip.text: qsTr("keep %1 points per octave to save memory").arg(dataObjectData.compactPointsPerOctave)
+
+                    enabled: dataObjectData.objectName === "Stored"
+                    visible: dataObjectData.objectName === "Stored"
+                }
+
                 DropDown {
                     displayText: qsTr("Save data as");
 
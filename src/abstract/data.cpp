@@ -16,31 +16,41 @@
  *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <QHash>
 #include "data.h"
 
 namespace Abstract {
 
-Data::Data()  = default;
+Data::Data() : m_frequency(), m_module(), m_magnitude(), m_coherence(), m_peakSquared(), m_meanSquared(),
+    m_phase(), m_impulse(), m_impulseStart(0), m_impulseStep(0)
+{
+}
 Data::~Data() = default;
 
 unsigned int Data::frequencyDomainSize() const noexcept
 {
-    return m_ftdata.size();
+    return m_frequency.size();
 }
 
 void Data::setFrequencyDomainSize(unsigned int size)
 {
-    m_ftdata.resize(size);
+    m_frequency.resize(size, 0);
+    m_module.resize(size, 0);
+    m_magnitude.resize(size, 0);
+    m_phase.resize(size, 0);
+    m_coherence.resize(size, 0);
+    m_peakSquared.resize(size, 0);
+    m_meanSquared.resize(size, NAN);
 }
 
 unsigned int Data::timeDomainSize() const noexcept
 {
-    return m_impulseData.size();
+    return m_impulse.size();
 }
 
 void Data::setTimeDomainSize(unsigned int size)
 {
-    m_impulseData.resize(size);
+    m_impulse.resize(size, 0);
 }
 
 void Data::lock()
@@ -56,7 +66,7 @@ void Data::unlock()
 float Data::frequency(unsigned int i) const noexcept
 {
     if (i < frequencyDomainSize()) {
-        return m_ftdata[i].frequency;
+        return m_frequency[i];
     }
     return 0;
 }
@@ -64,7 +74,7 @@ float Data::frequency(unsigned int i) const noexcept
 float Data::module (unsigned int i) const noexcept {
     if (i < frequencyDomainSize())
     {
-        return m_ftdata[i].module;
+        return m_module[i];
     }
     return 0;
 }
@@ -72,7 +82,7 @@ float Data::module (unsigned int i) const noexcept {
 float Data::magnitude(unsigned int i) const noexcept
 {
     if (i < frequencyDomainSize()) {
-        return 20.f * log10f(m_ftdata[i].magnitude);
+        return 20.f * log10f(m_magnitude[i]);
     }
     return 0;
 }
@@ -80,7 +90,7 @@ float Data::magnitude(unsigned int i) const noexcept
 float Data::magnitudeRaw(unsigned int i) const noexcept
 {
     if (i < frequencyDomainSize()) {
-        return m_ftdata[i].magnitude;
+        return m_magnitude[i];
     }
     return 0;
 }
@@ -88,7 +98,7 @@ float Data::magnitudeRaw(unsigned int i) const noexcept
 Complex Data::phase(unsigned int i) const noexcept
 {
     if (i < frequencyDomainSize()) {
-        return m_ftdata[i].phase;
+        return m_phase[i];
     }
     return 0;
 }
@@ -96,7 +106,7 @@ Complex Data::phase(unsigned int i) const noexcept
 float Data::coherence(unsigned int i) const noexcept
 {
     if (i < frequencyDomainSize()) {
-        return m_ftdata[i].coherence;
+        return m_coherence[i];
     }
     return 0;
 }
@@ -104,7 +114,7 @@ float Data::coherence(unsigned int i) const noexcept
 float Data::peakSquared(unsigned int i) const noexcept
 {
     if (i < frequencyDomainSize()) {
-        return m_ftdata[i].peakSquared;
+        return m_peakSquared[i];
     }
     return 0;
 }
@@ -112,7 +122,7 @@ float Data::peakSquared(unsigned int i) const noexcept
 float Data::crestFactor(unsigned int i) const noexcept
 {
     if (i < frequencyDomainSize()) {
-        return 10.f * std::log10(m_ftdata[i].peakSquared / m_ftdata[i].meanSquared);
+        return 10.f * std::log10(m_peakSquared[i] / m_meanSquared[i]);
     }
     return -INFINITY;
 }
@@ -120,7 +130,7 @@ float Data::crestFactor(unsigned int i) const noexcept
 float Data::impulseTime(unsigned int i) const noexcept
 {
     if (i < timeDomainSize()) {
-        return m_impulseData[i].time;
+        return m_impulseStart + i * m_impulseStep;
     }
     return 0;
 }
@@ -128,11 +138,67 @@ float Data::impulseTime(unsigned int i) const noexcept
 float Data::impulseValue(unsigned int i) const noexcept
 {
     if (i < timeDomainSize()) {
-        return m_impulseData[i].value.real;
+        return m_impulse[i];
     }
     return 0;
 }
 
+Container::span<const float> Data::frequencies() const noexcept
+{
+    return m_frequency;
+}
+
+Container::span<const float> Data::modules() const noexcept
+{
+    return m_module;
+}
+
+Container::span<const float> Data::magnitudesRaw() const noexcept
+{
+    return m_magnitude;
+}
+
+Container::span<const Complex> Data::phases() const noexcept
+{
+    return m_phase;
+}
+
+Container::span<const float> Data::coherences() const noexcept
+{
+    return m_coherence;
+}
+
+Container::span<const float> Data::peaksSquared() const noexcept
+{
+    return m_peakSquared;
+}
+
+Container::span<const float> Data::meansSquared() const noexcept
+{
+    return m_meanSquared;
+}
+
+Container::span<const float> Data::impulseValues() const noexcept
+{
+    return m_impulse;
+}
+
+float Data::impulseStart() const noexcept
+{
+    return m_impulseStart;
+}
+
+float Data::impulseStep() const noexcept
+{
+    return m_impulseStep;
+}
+
+void Data::setImpulseTimeAxis(float start, float step) noexcept
+{
+    m_impulseStart = start;
+    m_impulseStep  = step;
+}
+
 float Data::level(const Weighting::Curve curve, const Meter::Time time) const
 {
     if (m_levelsData.m_data.find({curve, time}) == m_levelsData.m_data.end()) {
@@ -156,27 +222,95 @@ float Data::referenceLevel() const
     return m_levelsData.m_referenceLevel;
 }
 
+const math::LevelHistory *Data::levelHistory() const noexcept
+{
+    return nullptr;
+}
+
 void Data::copyTo(Data &dist) const
 {
     std::lock_guard<std::mutex> guard(m_dataMutex);
     dist.lock();
 
-    dist.setFrequencyDomainSize(frequencyDomainSize());
-    dist.setTimeDomainSize(timeDomainSize());
-    std::copy_n(m_ftdata.data(), frequencyDomainSize(), dist.m_ftdata.data());
-    std::copy_n(m_impulseData.data(), timeDomainSize(), dist.m_impulseData.data());
+    dist.m_frequency    = m_frequency;
+    dist.m_module       = m_module;
+    dist.m_magnitude    = m_magnitude;
+    dist.m_phase        = m_phase;
+    dist.m_coherence    = m_coherence;
+    dist.m_peakSquared  = m_peakSquared;
+    dist.m_meanSquared  = m_meanSquared;
+    dist.m_impulse      = m_impulse;
+    dist.m_impulseStart = m_impulseStart;
+    dist.m_impulseStep  = m_impulseStep;
 
     dist.unlock();
 }
 
 void Data::setFrequencyDomainData(std::vector<FTData> &&data)
 {
-    m_ftdata = data;
+    setFrequencyDomainSize(data.size());
+    for (unsigned int i = 0; i < data.size(); ++i) {
+        m_frequency[i]   = data[i].frequency;
+        m_module[i]      = data[i].module;
+        m_magnitude[i]   = data[i].magnitude;
+        m_phase[i]       = data[i].phase;
+        m_coherence[i]   = data[i].coherence;
+        m_peakSquared[i] = data[i].peakSquared;
+        m_meanSquared[i] = data[i].meanSquared;
+    }
+    internFrequencies();
+}
+
+void Data::internFrequencies()
+{
+    //sources of one size and sample rate have equal axes, one copy of each is kept.
+    //The registry owns a reference, so a registered axis is never written in place: writers detach
+    static std::mutex mutex;
+    static std::unordered_multimap<uint, std::shared_ptr<std::vector<float>>> axes;
+
+    const auto &axis = m_frequency;
+    if (axis.empty()) {
+        return;
+    }
+    auto key = qHashBits(axis.data(), axis.size() * sizeof(float));
+
+    std::lock_guard<std::mutex> guard(mutex);
+    for (auto it = axes.begin(); it != axes.end();) {
+        if (it->second.use_count() == 1) {
+            it = axes.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    auto range = axes.equal_range(key);
+    for (auto it = range.first; it != range.second; ++it) {
+        if (it->second == axis.buffer()) {
+            return;
+        }
+        if (*it->second == *axis.buffer()) {
+            m_frequency = Container::SharedVector<float>(it->second);
+            return;
+        }
+    }
+    axes.emplace(key, axis.buffer());
+}
+
+void Data::shareFrequencies(const Data &source)
+{
+    if (m_frequency.buffer() != source.m_frequency.buffer()) {
+        m_frequency = source.m_frequency;
+    }
 }
 
 void Data::setTimeDomainData(std::vector<TimeData> &&data)
 {
-    m_impulseData = data;
+    setTimeDomainSize(data.size());
+    for (unsigned int i = 0; i < data.size(); ++i) {
+        m_impulse[i] = data[i].value.real;
+    }
+    setImpulseTimeAxis(data.empty() ? 0 : data.front().time,
+                       data.size() > 1 ? (data.back().time - data.front().time) / (data.size() - 1) : 0);
 }
 
 }
@@ -24,8 +24,14 @@
 #include <vector>
 
 #include "abstract/levelsdata.h"
+#include "container/sharedvector.h"
+#include "container/span.h"
 #include "math/complex.h"
 
+namespace math {
+class LevelHistory;
+}
+
 namespace Abstract {
 
 struct Data {
@@ -33,6 +39,7 @@ struct Data {
     explicit Data();
     virtual ~Data();
 
+    //! one row of the frequency domain, used to build data from imported files
     struct FTData {
         float   frequency   = 0;
         float   module      = 0;
@@ -43,6 +50,7 @@ struct Data {
         float   meanSquared = NAN;
     };
 
+    //! one row of the time domain, rows must be equally spaced in time
     struct TimeData {
         float   time  = 0; //ms
         Complex value = 0;
@@ -63,22 +71,53 @@ struct Data {
     virtual float   peakSquared( unsigned int i) const noexcept;
     virtual float   crestFactor( unsigned int i) const noexcept;
 
-    unsigned int    timeDomainSize() const noexcept;
+    virtual unsigned int timeDomainSize() const noexcept;
     void            setTimeDomainSize(unsigned int size);
     virtual float   impulseTime( unsigned int i) const noexcept;
     virtual float   impulseValue(unsigned int i) const noexcept;
 
+    //! bulk access to the stored planes, values are not adjusted as virtual accessors do, call under lock()
+    //! the impulse plane is empty when a source keeps the impulse in other form (compact Stored)
+    Container::span<const float>    frequencies()   const noexcept;
+    Container::span<const float>    modules()       const noexcept;
+    Container::span<const float>    magnitudesRaw() const noexcept;
+    Container::span<const Complex>  phases()        const noexcept;
+    Container::span<const float>    coherences()    const noexcept;
+    Container::span<const float>    peaksSquared()  const noexcept;
+    Container::span<const float>    meansSquared()  const noexcept;
+    Container::span<const float>    impulseValues() const noexcept;
+
+    //! impulse time axis: impulseTime(i) = start + i * step, ms
+    float           impulseStart() const noexcept;
+    float           impulseStep()  const noexcept;
+    void            setImpulseTimeAxis(float start, float step) noexcept;
+
     virtual float   level(const Weighting::Curve curve = Weighting::Z, const Meter::Time time = Meter::Fast) const;
     virtual float   peak( const Weighting::Curve curve = Weighting::Z, const Meter::Time time = Meter::Fast) const;
     virtual float   referenceLevel() const;
+    //! level log integrated on the audio path, only sources with their own input have it
+    virtual const math::LevelHistory *levelHistory() const noexcept;
 
+    //! dist shares the planes until one of them is written, no samples are copied
     void            copyTo(Data &dist) const;
     void            setFrequencyDomainData(std::vector<FTData> &&data);
     void            setTimeDomainData(std::vector<TimeData> &&data);
 
 protected:
-    std::vector<FTData>     m_ftdata;
-    std::vector<TimeData>   m_impulseData;
+    //! the axis is replaced by an equal one used by other sources, call after the axis is written
+    void            internFrequencies();
+    //! the axis of source is used without a copy, call under both locks
+    void            shareFrequencies(const Data &source);
+
+    //frequency domain planes, one value per bin, shared between copies until written
+    //the frequency axis is also shared between sources with equal axes, see internFrequencies()
+    Container::SharedVector<float>      m_frequency, m_module, m_magnitude, m_coherence, m_peakSquared, m_meanSquared;
+    Container::SharedVector<Complex>    m_phase;
+
+    //time domain: impulse values on the implicit axis
+    Container::SharedVector<float>      m_impulse;
+    float                   m_impulseStart, m_impulseStep;
+
     LevelsData              m_levelsData;
 
     mutable std::mutex      m_dataMutex;
@@ -26,9 +26,13 @@ Source::Source(QObject *parent) : QObject{ parent },
     m_uuid          { QUuid::createUuid() },
     m_sampleRate    { 48000 },
     m_active        { false },
-    m_cloneable     { true  }
+    m_cloneable     { true  },
+    m_dataRevision  { 0 }
 {
     qRegisterMetaType<::Abstract::Source *>("AbstractSource*");
+    connect(this, &Source::readyRead, this, [this]() {
+        ++m_dataRevision;
+    }, Qt::DirectConnection);
 }
 
 Source::~Source() = default;
@@ -183,6 +187,11 @@ bool Source::cloneable() const
     return m_cloneable;
 }
 
+unsigned int Source::dataRevision() const noexcept
+{
+    return m_dataRevision;
+}
+
 void Source::setGlobalColor(int globalValue)
 {
     if (globalValue < 19) {
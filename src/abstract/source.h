@@ -75,6 +75,9 @@ public:
 
     virtual bool     cloneable() const;
 
+    //! counts readyRead() signals, readers compare it to skip rebuilding unchanged data
+    unsigned int     dataRevision() const noexcept;
+
 public slots:
     void    setGlobalColor(int globalValue);
 
@@ -93,6 +96,7 @@ private:
     std::atomic<unsigned>   m_sampleRate;
     std::atomic<bool>       m_active;
     bool                    m_cloneable;
+    std::atomic<unsigned>   m_dataRevision;
 };
 
 } // namespace Abstract
@@ -85,6 +85,72 @@ __attribute__((aligned(16))) inline v4sf _mm_load_ps( float *source )
     return _mm_set_ps(source[3], source[2], source[1], source[0]);
 }
 
+inline v4sf _mm_loadu_ps(const float *source)
+{
+    return vld1q_f32(source);
+}
+
+inline void _mm_storeu_ps(float *dest, const v4sf &source)
+{
+    vst1q_f32(dest, source);
+}
+
+inline v4sf _mm_max_ps(const v4sf &left, const v4sf &right)
+{
+    return vmaxq_f32(left, right);
+}
+
+inline v4sf _mm_sqrt_ps(const v4sf &source)
+{
+    return vsqrtq_f32(source);
+}
+
+inline v4sf _mm_cmplt_ps(const v4sf &left, const v4sf &right)
+{
+    return vreinterpretq_f32_u32(vcltq_f32(left, right));
+}
+
+inline v4sf _mm_and_ps(const v4sf &left, const v4sf &right)
+{
+    return vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(left), vreinterpretq_u32_f32(right)));
+}
+
+inline v4sf _mm_unpacklo_ps(const v4sf &left, const v4sf &right)
+{
+    return vzip1q_f32(left, right);
+}
+
+inline v4sf _mm_unpackhi_ps(const v4sf &left, const v4sf &right)
+{
+    return vzip2q_f32(left, right);
+}
+
+inline v4sf _mm_min_ps(const v4sf &left, const v4sf &right)
+{
+    return vminq_f32(left, right);
+}
+
+inline v4sf _mm_cmpgt_ps(const v4sf &left, const v4sf &right)
+{
+    return vreinterpretq_f32_u32(vcgtq_f32(left, right));
+}
+
+inline v4sf _mm_or_ps(const v4sf &left, const v4sf &right)
+{
+    return vreinterpretq_f32_u32(vorrq_u32(vreinterpretq_u32_f32(left), vreinterpretq_u32_f32(right)));
+}
+
+inline v4sf _mm_xor_ps(const v4sf &left, const v4sf &right)
+{
+    return vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(left), vreinterpretq_u32_f32(right)));
+}
+
+//! ~left & right, as SSE does
+inline v4sf _mm_andnot_ps(const v4sf &left, const v4sf &right)
+{
+    return vreinterpretq_f32_u32(vbicq_u32(vreinterpretq_u32_f32(right), vreinterpretq_u32_f32(left)));
+}
+
 
 #define _mm_shuffle_ps(a, b, imm8) \
 __extension__({ \
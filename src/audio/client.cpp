@@ -39,6 +39,8 @@
 #include "plugins/asioplugin.h"
 #endif
 
+#include "plugins/virtual.h"
+
 namespace audio {
 
 QSharedPointer<Client> Client::m_instance = nullptr;
@@ -89,6 +91,10 @@ void Client::initPlugins()
     m_plugins.push_back(QSharedPointer<Plugin>(new AlsaPlugin()));
 #endif
 
+    if (VirtualPlugin::enabled()) {
+        m_plugins.push_back(QSharedPointer<Plugin>(new VirtualPlugin()));
+    }
+
     for (auto &&plugin : m_plugins) {
         connect(plugin.data(), &Plugin::deviceListChanged, this, [this]() {
             refreshDeviceList();
@@ -17,7 +17,10 @@
  */
 #include "alsa.h"
 #include <cstring>
-#include <QCoreApplication>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include "common/trace.h"
 #define ALSA_BUFFER_SIZE 1024
 #define ALSA_PERIOD_SIZE 64
 
@@ -199,12 +202,15 @@ Stream *AlsaPlugin::open(const DeviceInfo::Id &id, const Plugin::Direction &mode
 
     auto stream = new Stream(device->format());
     endpoint->open(mode == Input ? QIODevice::WriteOnly : QIODevice::ReadOnly);
+    connect(stream, &Stream::subscriptionChanged, device, [stream, device]() {
+        device->setSubscription(stream, stream->channels(), stream->channelsCallback());
+    }, Qt::DirectConnection);
     connect(stream, &Stream::closeMe, device, [endpoint, stream, device]() {
+        //the callback isn't called after removeCallback returns
+        device->removeCallback(stream);
         if (endpoint->isOpen()) {
             endpoint->close();
         }
-        QMetaObject::invokeMethod(device, "removeCallback", Qt::QueuedConnection, Q_ARG(Stream *, stream));
-        usleep(30'000);//30ms
         stream->deleteLater();
     }, Qt::DirectConnection);
 
@@ -226,9 +232,7 @@ Stream *AlsaPlugin::open(const DeviceInfo::Id &id, const Plugin::Direction &mode
         break;
     }
 
-    QMetaObject::invokeMethod(device, "addCallback", Qt::QueuedConnection,
-                              Q_ARG(Stream *, stream),
-                              Q_ARG(audio::AlsaPCMDevice::Callback, endpointCallback));
+    device->addCallback(stream, endpointCallback);
 
     while (!device->active()) {
         usleep(10'000);
@@ -247,17 +251,27 @@ bool checkStatus(int errorCode, QString message, std::list<int> goodCodes)
 
 AlsaPCMDevice::AlsaPCMDevice(const DeviceInfo::Id &id, const Plugin::Direction &mode,
                              const Format &format, std::mutex &mutex) : QObject(), m_thread(nullptr), m_callbacks(),
-    m_buffer(), m_id(id), m_mode(mode), m_format(format), m_mutex(mutex), m_keepAlive(false), m_threadActive(false)
+    m_subscriptions(), m_subscribedChannels(format.channelCount, false), m_devicePlanes(format.channelCount, nullptr),
+    m_callbacksMutex(), m_buffer(), m_planes(), m_locked(false), m_mmap(false), m_periodSize(ALSA_PERIOD_SIZE),
+    m_id(id), m_mode(mode), m_format(format), m_mutex(mutex), m_keepAlive(false), m_threadActive(false)
 {
     m_buffer.resize(ALSA_BUFFER_SIZE * format.channelCount);
+    m_planes.resize(ALSA_BUFFER_SIZE * format.channelCount);
+    //keep the buffers in RAM: a page fault in the audio thread is an overrun
+    m_locked = (mlock(m_buffer.data(), m_buffer.size() * sizeof(float)) == 0) &&
+               (mlock(m_planes.data(), m_planes.size() * sizeof(float)) == 0);
 }
 
 AlsaPCMDevice::~AlsaPCMDevice()
 {
-    if (m_thread->isRunning()) {
+    if (m_thread && m_thread->isRunning()) {
         m_thread->quit();
         m_thread->wait();
     }
+    if (m_locked) {
+        munlock(m_buffer.data(), m_buffer.size() * sizeof(float));
+        munlock(m_planes.data(), m_planes.size() * sizeof(float));
+    }
 }
 
 void AlsaPCMDevice::setKeepAlive()
@@ -280,7 +294,12 @@ bool AlsaPCMDevice::start()
 
     checkCall(snd_pcm_hw_params_any(pcm.handle, hw), false);
     checkCall(snd_pcm_hw_params_set_rate_resample(pcm.handle, hw, 1), false);
-    checkCall(snd_pcm_hw_params_set_access(pcm.handle, hw, SND_PCM_ACCESS_RW_INTERLEAVED), false);
+    m_mmap = (m_mode == Plugin::Input) &&
+             (snd_pcm_hw_params_set_access(pcm.handle, hw, SND_PCM_ACCESS_MMAP_INTERLEAVED) == 0 ||
+              snd_pcm_hw_params_set_access(pcm.handle, hw, SND_PCM_ACCESS_MMAP_NONINTERLEAVED) == 0);
+    if (!m_mmap) {
+        checkCall(snd_pcm_hw_params_set_access(pcm.handle, hw, SND_PCM_ACCESS_RW_INTERLEAVED), false);
+    }
     checkCall(snd_pcm_hw_params_set_format(pcm.handle, hw, SND_PCM_FORMAT_FLOAT_LE), false);
     checkCall(snd_pcm_hw_params_set_channels(pcm.handle, hw, streamFormat.channelCount), false);
     checkCall(snd_pcm_hw_params_set_rate_near(pcm.handle, hw, &sr, 0), false);
@@ -303,40 +322,34 @@ bool AlsaPCMDevice::start()
     checkCall(snd_pcm_sw_params_set_start_threshold(pcm.handle, sw, periodSize), false);
     checkCall(snd_pcm_sw_params(pcm.handle, sw), false);
 
+    m_periodSize = periodSize;
     m_thread = QThread::create(
     [handle = pcm.handle, samples = m_buffer.data(), this]() {
+        setRealtimePriority();
+        if (m_mmap) {
+            snd_pcm_start(handle);
+        }
+
         while (true) {
             snd_pcm_sframes_t frameCount = 0;
-            if (m_mode == Plugin::Input) {
-                frameCount = snd_pcm_readi(handle, samples, ALSA_BUFFER_SIZE);
-            }
-            for (auto &callback : m_callbacks) {
-                callback(m_buffer.data(), m_buffer.size());
-            }
-            if (m_mode == Plugin::Output) {
-                frameCount = snd_pcm_writei(handle, samples, ALSA_BUFFER_SIZE);
+            if (m_mmap) {
+                frameCount = readMMap(handle);
+            } else {
+                if (m_mode == Plugin::Input) {
+                    frameCount = snd_pcm_readi(handle, samples, ALSA_BUFFER_SIZE);
+                }
+                callCallbacks(m_buffer.data(), m_buffer.size());
+                if (m_mode == Plugin::Output) {
+                    frameCount = snd_pcm_writei(handle, samples, ALSA_BUFFER_SIZE);
+                }
             }
             if (frameCount < 0) {
-                switch (-frameCount) {
-                case EPIPE:
-                    snd_pcm_prepare(handle);
-                    break;
-                case ESTRPIPE:
-                    while (snd_pcm_resume(handle) == -EAGAIN) {
-                        sleep(1);
-                        if (snd_pcm_prepare(handle) < 0) {
-                            qCritical("can't resume");
-                            break;
-                        }
-                    }
-                }
+                recover(handle, frameCount);
             }
-            QCoreApplication::processEvents();
-            if (m_callbacks.empty()) {
-                m_mutex.lock();
-                if (m_keepAlive) {
-                    QCoreApplication::processEvents();
-                } else {
+
+            //the list mutex is held while the plugin opens a stream, a new callback is on the way then
+            if (callbacksEmpty() && m_mutex.try_lock()) {
+                if (!m_keepAlive) {
                     m_threadActive = false;
                     break;
                 }
@@ -384,17 +397,190 @@ bool AlsaPCMDevice::active() const
 
 void AlsaPCMDevice::addCallback(Stream *stream, Callback callback)
 {
+    std::lock_guard<std::mutex> guard(m_callbacksMutex);
     m_callbacks[stream] = callback;
 }
 
 void AlsaPCMDevice::removeCallback(Stream *stream)
 {
-    for (auto it = m_callbacks.begin(); it != m_callbacks.end();) {
-        if (it.key() == stream) {
-            it = m_callbacks.erase(it);
-            return;
+    std::lock_guard<std::mutex> guard(m_callbacksMutex);
+    m_callbacks.remove(stream);
+    m_subscriptions.remove(stream);
+    updateSubscribedChannels();
+}
+
+void AlsaPCMDevice::setSubscription(Stream *stream, const std::vector<unsigned int> &channels,
+                                    const Stream::ChannelsCallback &callback)
+{
+    std::lock_guard<std::mutex> guard(m_callbacksMutex);
+    if (callback && m_mode == Plugin::Input) {
+        m_subscriptions[stream] = {channels, callback, std::vector<const float *>(channels.size(), nullptr)};
+    } else {
+        m_subscriptions.remove(stream);
+    }
+    updateSubscribedChannels();
+}
+
+void AlsaPCMDevice::updateSubscribedChannels()
+{
+    std::fill(m_subscribedChannels.begin(), m_subscribedChannels.end(), false);
+    for (auto &subscription : m_subscriptions) {
+        for (auto &channel : subscription.channels) {
+            if (channel < m_subscribedChannels.size()) {
+                m_subscribedChannels[channel] = true;
+            }
+        }
+    }
+}
+
+void AlsaPCMDevice::callCallbacks(float *buffer, size_t size)
+{
+    Trace::Scope trace(Trace::AudioCallback);
+    std::lock_guard<std::mutex> guard(m_callbacksMutex);
+    auto channels = m_format.channelCount;
+
+    if (!m_subscriptions.empty() && channels) {
+        auto frames = size / channels;
+        for (size_t chunk = 0; chunk < frames; chunk += ALSA_BUFFER_SIZE) {
+            auto chunkFrames = std::min<size_t>(ALSA_BUFFER_SIZE, frames - chunk);
+            const float *source = buffer + chunk * channels;
+            for (unsigned int channel = 0; channel < channels; ++channel) {
+                if (!m_subscribedChannels[channel]) {
+                    m_devicePlanes[channel] = nullptr;
+                    continue;
+                }
+                auto plane = m_planes.data() + channel * ALSA_BUFFER_SIZE;
+                for (size_t frame = 0; frame < chunkFrames; ++frame) {
+                    plane[frame] = source[frame * channels + channel];
+                }
+                m_devicePlanes[channel] = plane;
+            }
+            callSubscriptions(chunkFrames);
+        }
+    }
+
+    for (auto it = m_callbacks.cbegin(); it != m_callbacks.cend(); ++it) {
+        if (!m_subscriptions.contains(it.key())) {
+            it.value()(buffer, size);
+        }
+    }
+}
+
+void AlsaPCMDevice::callSubscriptions(size_t frames)
+{
+    for (auto &subscription : m_subscriptions) {
+        for (size_t i = 0; i < subscription.channels.size(); ++i) {
+            auto channel = subscription.channels[i];
+            subscription.pointers[i] = (channel < m_devicePlanes.size() ? m_devicePlanes[channel] : nullptr);
+        }
+        subscription.callback(subscription.pointers.data(), frames);
+    }
+}
+
+bool AlsaPCMDevice::callbacksEmpty() const
+{
+    std::lock_guard<std::mutex> guard(m_callbacksMutex);
+    return m_callbacks.empty();
+}
+
+bool AlsaPCMDevice::callbacksSubscribed() const
+{
+    std::lock_guard<std::mutex> guard(m_callbacksMutex);
+    return m_subscriptions.size() == m_callbacks.size();
+}
+
+snd_pcm_sframes_t AlsaPCMDevice::readMMap(snd_pcm_t *handle)
+{
+    auto avail = snd_pcm_avail_update(handle);
+    if (avail < 0) {
+        return avail;
+    }
+    if (static_cast<snd_pcm_uframes_t>(avail) < m_periodSize) {
+        auto ready = snd_pcm_wait(handle, 1000);
+        return ready < 0 ? ready : 0;
+    }
+
+    const snd_pcm_channel_area_t *areas;
+    snd_pcm_uframes_t offset, frames = avail;
+    auto result = snd_pcm_mmap_begin(handle, &areas, &offset, &frames);
+    if (result < 0) {
+        return result;
+    }
+
+    auto channels = m_format.channelCount;
+    auto sampleAddress = [areas](unsigned int channel, snd_pcm_uframes_t frame) {
+        auto &area = areas[channel];
+        return reinterpret_cast<float *>(static_cast<char *>(area.addr) + (area.first + frame * area.step) / 8);
+    };
+
+    bool interleaved = true;
+    for (unsigned int channel = 0; channel < channels && interleaved; ++channel) {
+        interleaved = (areas[channel].step == 32 * channels) &&
+                      (sampleAddress(channel, offset) == sampleAddress(0, offset) + channel);
+    }
+
+    bool planar = !interleaved;
+    for (unsigned int channel = 0; channel < channels && planar; ++channel) {
+        planar = (areas[channel].step == 32);
+    }
+
+    if (interleaved) {
+        //consumers read the mapped ring buffer directly
+        callCallbacks(sampleAddress(0, offset), frames * channels);
+    } else if (planar && callbacksSubscribed()) {
+        Trace::Scope trace(Trace::AudioCallback);
+        std::lock_guard<std::mutex> guard(m_callbacksMutex);
+        for (unsigned int channel = 0; channel < channels; ++channel) {
+            m_devicePlanes[channel] = sampleAddress(channel, offset);
+        }
+        callSubscriptions(frames);
+    } else {
+        for (snd_pcm_uframes_t chunk = 0; chunk < frames; chunk += ALSA_BUFFER_SIZE) {
+            auto chunkFrames = std::min<snd_pcm_uframes_t>(ALSA_BUFFER_SIZE, frames - chunk);
+            for (unsigned int channel = 0; channel < channels; ++channel) {
+                for (snd_pcm_uframes_t frame = 0; frame < chunkFrames; ++frame) {
+                    m_buffer[frame * channels + channel] = *sampleAddress(channel, offset + chunk + frame);
+                }
+            }
+            callCallbacks(m_buffer.data(), chunkFrames * channels);
+        }
+    }
+
+    return snd_pcm_mmap_commit(handle, offset, frames);
+}
+
+void AlsaPCMDevice::recover(snd_pcm_t *handle, snd_pcm_sframes_t error)
+{
+    switch (-error) {
+    case EPIPE:
+        snd_pcm_prepare(handle);
+        break;
+    case ESTRPIPE:
+        while (snd_pcm_resume(handle) == -EAGAIN) {
+            sleep(1);
+            if (snd_pcm_prepare(handle) < 0) {
+                qCritical("can't resume");
+                break;
+            }
         }
     }
+    if (m_mmap) {
+        snd_pcm_start(handle);
+    }
+}
+
+void AlsaPCMDevice::setRealtimePriority()
+{
+    sched_param param {};
+    auto min = sched_get_priority_min(SCHED_FIFO);
+    auto max = sched_get_priority_max(SCHED_FIFO);
+    param.sched_priority = min + (max - min) * 3 / 4;
+    if (pthread_setschedparam(pthread_self(), SCHED_FIFO, &param) != 0) {
+        qInfo() << "ALSA: SCHED_FIFO isn't permitted, the audio thread runs with the default policy";
+    }
+    if (!m_locked) {
+        qInfo() << "ALSA: couldn't lock the audio buffer in memory";
+    }
 }
 
 } // namespace audio
@@ -67,16 +67,44 @@ public:
     void setKeepAlive();
 
 public slots:
+    //! thread safe, the audio thread doesn't process events
     void addCallback(Stream *stream, audio::AlsaPCMDevice::Callback callback);
     void removeCallback(Stream *stream);
+    void setSubscription(Stream *stream, const std::vector<unsigned int> &channels,
+                         const audio::Stream::ChannelsCallback &callback);
 
 signals:
     void closed();
 
 private:
+    snd_pcm_sframes_t readMMap(snd_pcm_t *handle);
+    void callCallbacks(float *buffer, size_t size);
+    void callSubscriptions(size_t frames);
+    void updateSubscribedChannels();
+    bool callbacksEmpty() const;
+    //! every stream reads planes, interleaving isn't needed
+    bool callbacksSubscribed() const;
+    void recover(snd_pcm_t *handle, snd_pcm_sframes_t error);
+    void setRealtimePriority();
+
     QThread *m_thread;
     QHash<Stream *, Callback> m_callbacks;
-    std::vector<float> m_buffer;
+
+    //! streams which read planes of their channels, the device is demultiplexed once per period for all of them
+    struct Subscription {
+        std::vector<unsigned int> channels;
+        Stream::ChannelsCallback callback;
+        std::vector<const float *> pointers;
+    };
+    QHash<Stream *, Subscription> m_subscriptions;
+    std::vector<bool> m_subscribedChannels;
+    std::vector<const float *> m_devicePlanes;
+    mutable std::mutex m_callbacksMutex;
+    std::vector<float> m_buffer, m_planes;
+    bool m_locked;
+    //! capture reads the ring buffer in place through snd_pcm_mmap_begin
+    bool m_mmap;
+    snd_pcm_uframes_t m_periodSize;
     DeviceInfo::Id m_id;
     Plugin::Direction m_mode;
     Format m_format;
@@ -20,6 +20,7 @@
 #include <future>
 #include <limits>
 #include <QMetaType>
+#include "common/trace.h"
 
 namespace audio {
 
@@ -327,6 +328,7 @@ void ASIOPlugin::stopAllStreams()
 
 void ASIOPlugin::processInputStreams(const QVector<float> &buffer)
 {
+    Trace::Scope trace(Trace::AudioCallback);
     for (auto it = m_inputCallbacks.begin(); it != m_inputCallbacks.end();) {
         if (Q_UNLIKELY(!it.key()->active())) {
             it.key()->deleteLater();
@@ -19,6 +19,7 @@
 #include <cstdlib>
 #include <AudioToolbox/AudioToolbox.h>
 #include <QtCore>
+#include "common/trace.h"
 
 template <typename T> struct malloc_guard {
     malloc_guard()
@@ -270,6 +271,7 @@ Stream *CoreaudioPlugin::open(const DeviceInfo::Id &id, const Plugin::Direction
         auto endpoint = reinterpret_cast<QIODevice *>(inUserData);
         if (endpoint && endpoint->isWritable())
         {
+            Trace::Scope trace(Trace::AudioCallback);
             endpoint->write(reinterpret_cast<char *>(inBuffer->mAudioData), inBuffer->mAudioDataByteSize);
             checkStatus(AudioQueueEnqueueBuffer(queue, inBuffer, 0, NULL), "AudioQueueEnqueueBuffer", {noErr, kAudioQueueErr_EnqueueDuringReset});
         }
@@ -0,0 +1,485 @@
+/**
+ *  OSM
+ *  Copyright (C) 2026  Pavel Smokotnin
+
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "virtual.h"
+#include <chrono>
+#include <cmath>
+#include <QtMath>
+#include <QDebug>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include "common/trace.h"
+#include "common/wavfile.h"
+#include "math/lowpassfilter.h"
+
+namespace audio {
+
+namespace {
+constexpr unsigned int DEFAULT_SAMPLE_RATE = 48000;
+constexpr unsigned int DEFAULT_CHANNELS = 2;
+constexpr std::size_t DEFAULT_PERIOD = 1024;
+
+float gainFromDB(double dB)
+{
+    return static_cast<float>(std::pow(10, dB / 20));
+}
+
+//! the clock divides by the sample rate, the period and channel counts size the buffers:
+//! zero and negative values are replaced by the default
+unsigned int positive(const QJsonObject &config, const QString &key, unsigned int defaultValue)
+{
+    auto value = config[key].toInt(static_cast<int>(defaultValue));
+    if (value <= 0) {
+        qWarning() << "virtual audio:" << key << value << "is invalid, used" << defaultValue;
+        return defaultValue;
+    }
+    return static_cast<unsigned int>(value);
+}
+}
+
+bool VirtualPlugin::enabled()
+{
+    return qEnvironmentVariableIsSet(CONFIG_VARIABLE);
+}
+
+VirtualPlugin::VirtualPlugin() : Plugin(), m_devices()
+{
+    auto config = defaultConfig();
+    auto fileName = qEnvironmentVariable(CONFIG_VARIABLE);
+    QFile file(fileName);
+    if (!fileName.isEmpty() && file.exists()) {
+        QJsonParseError error;
+        if (file.open(QIODevice::ReadOnly)) {
+            auto document = QJsonDocument::fromJson(file.readAll(), &error);
+            if (document.isObject()) {
+                config = document.object();
+            } else {
+                qWarning() << "virtual audio config error:" << error.errorString();
+            }
+        } else {
+            qWarning() << "can't open virtual audio config" << fileName;
+        }
+    }
+
+    auto devices = config["devices"].toArray();
+    for (int i = 0; i < devices.size(); ++i) {
+        auto deviceConfig = devices[i].toObject();
+        auto deviceName = deviceConfig["name"].toString(QString("Virtual %1").arg(i + 1));
+        deviceConfig["name"] = deviceName;
+        m_devices.push_back(std::make_unique<VirtualDevice>("virtual:" + deviceName, name(), deviceConfig));
+    }
+}
+
+VirtualPlugin::~VirtualPlugin() = default;
+
+QString VirtualPlugin::name() const
+{
+    return "Virtual";
+}
+
+DeviceInfo::List VirtualPlugin::getDeviceInfoList() const
+{
+    DeviceInfo::List list;
+    for (auto &device : m_devices) {
+        list.push_back(device->info());
+    }
+    return list;
+}
+
+DeviceInfo::Id VirtualPlugin::defaultDeviceId(const Direction &mode) const
+{
+    for (auto &device : m_devices) {
+        if (device->format(mode).channelCount) {
+            return device->info().id();
+        }
+    }
+    return {};
+}
+
+Format VirtualPlugin::deviceFormat(const DeviceInfo::Id &id, const Direction &mode) const
+{
+    auto virtualDevice = device(id);
+    return virtualDevice ? virtualDevice->format(mode) : Format{};
+}
+
+Stream *VirtualPlugin::open(const DeviceInfo::Id &id, const Direction &mode, [[maybe_unused]] const Format &format,
+                            QIODevice *endpoint)
+{
+    auto virtualDevice = device(id);
+    if (!virtualDevice || !virtualDevice->format(mode).channelCount) {
+        return nullptr;
+    }
+
+    auto stream = new Stream(virtualDevice->format(mode));
+    if (endpoint->openMode() == QIODevice::NotOpen) {
+        endpoint->open(mode == Input ? QIODevice::WriteOnly : QIODevice::ReadOnly);
+    }
+    connect(stream, &Stream::subscriptionChanged, virtualDevice, [stream, virtualDevice]() {
+        virtualDevice->setSubscription(stream, stream->channels(), stream->channelsCallback());
+    }, Qt::DirectConnection);
+    connect(stream, &Stream::closeMe, virtualDevice, [endpoint, stream, virtualDevice]() {
+        virtualDevice->removeStream(stream);
+        if (endpoint->isOpen()) {
+            endpoint->close();
+        }
+        stream->deleteLater();
+    }, Qt::DirectConnection);
+
+    virtualDevice->addStream(stream, mode, endpoint);
+    return stream;
+}
+
+QJsonObject VirtualPlugin::defaultConfig()
+{
+    //measurement channel is the generator through a delay and a lowpass, reference is the generator itself
+    QJsonObject measurement {
+        {"type",    "loopback"},
+        {"output",  0},
+        {"delay",   0.005},
+        {"lowpass", 8000},
+    };
+    QJsonObject reference {
+        {"type",    "loopback"},
+        {"output",  0},
+    };
+    QJsonObject device {
+        {"name",        "Virtual loopback"},
+        {"sampleRate",  static_cast<int>(DEFAULT_SAMPLE_RATE)},
+        {"inputs",      static_cast<int>(DEFAULT_CHANNELS)},
+        {"outputs",     static_cast<int>(DEFAULT_CHANNELS)},
+        {"channels",    QJsonArray{measurement, reference}},
+    };
+    return QJsonObject{{"devices", QJsonArray{device}}};
+}
+
+VirtualDevice *VirtualPlugin::device(const DeviceInfo::Id &id) const
+{
+    for (auto &device : m_devices) {
+        if (device->info().id() == id) {
+            return device.get();
+        }
+    }
+    return nullptr;
+}
+
+VirtualDevice::VirtualDevice(const DeviceInfo::Id &id, const QString &pluginName, const QJsonObject &config) :
+    QObject(), m_id(id), m_name(config["name"].toString()), m_pluginName(pluginName),
+    m_sampleRate(positive(config, "sampleRate", DEFAULT_SAMPLE_RATE)),
+    m_inputs(positive(config, "inputs", DEFAULT_CHANNELS)),
+    m_outputs(positive(config, "outputs", DEFAULT_CHANNELS)),
+    m_period(positive(config, "period", DEFAULT_PERIOD)),
+    m_clock(config["clock"].toString() == "fast" ? Fast : RealTime),
+    m_channels(m_inputs), m_delayLines(m_outputs), m_delayMask(0), m_written(0),
+    m_outputBuffer(m_period * m_outputs), m_inputBuffer(m_period * m_inputs),
+    m_scratch(m_period * m_outputs), m_streamsMutex(), m_streams(), m_thread(), m_running(false)
+{
+    auto channels = config["channels"].toArray();
+    std::size_t maxDelay = 0;
+    for (unsigned int i = 0; i < m_inputs; ++i) {
+        auto &channel = m_channels[i];
+        channel.random.seed(i);
+        channel.buffer.resize(m_period, 0.f);
+        if (!channels.isEmpty()) {
+            readChannel(channels[i % channels.size()].toObject(), channel);
+        }
+        if (channel.type == Channel::Loopback) {
+            maxDelay = std::max(maxDelay, channel.delay);
+        }
+    }
+
+    std::size_t delayLineSize = 1;
+    while (delayLineSize < maxDelay + m_period) {
+        delayLineSize <<= 1;
+    }
+    m_delayMask = delayLineSize - 1;
+    for (auto &line : m_delayLines) {
+        line.resize(delayLineSize, 0.f);
+    }
+}
+
+VirtualDevice::~VirtualDevice()
+{
+    m_running = false;
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+}
+
+void VirtualDevice::readChannel(const QJsonObject &config, Channel &channel) const
+{
+    static const QHash<QString, Channel::Type> types = {
+        {"silence",  Channel::Silence},
+        {"sine",     Channel::Sine},
+        {"noise",    Channel::Noise},
+        {"wav",      Channel::Wav},
+        {"loopback", Channel::Loopback},
+    };
+    channel.type = types.value(config["type"].toString(), Channel::Silence);
+    channel.gain = gainFromDB(config["gain"].toDouble(0));
+
+    switch (channel.type) {
+    case Channel::Silence:
+        break;
+
+    case Channel::Sine:
+        channel.frequency = config["frequency"].toDouble(1000);
+        break;
+
+    case Channel::Noise:
+        if (config.contains("seed")) {
+            channel.random.seed(config["seed"].toInt());
+        }
+        break;
+
+    case Channel::Wav: {
+        //decoded once, the clock mustn't wait for the disk
+        WavFile file;
+        auto fileName = config["file"].toString();
+        if (!file.load(fileName)) {
+            qWarning() << "virtual audio: can't load" << fileName;
+            channel.type = Channel::Silence;
+            break;
+        }
+        if (static_cast<unsigned int>(file.sampleRate()) != m_sampleRate) {
+            qWarning() << "virtual audio:" << fileName << "is played at" << m_sampleRate << "Hz";
+        }
+        bool finished = false;
+        for (auto sample = file.nextSample(false, &finished); !finished && !std::isnan(sample);
+                sample = file.nextSample(false, &finished)) {
+            channel.samples.push_back(sample);
+        }
+        if (channel.samples.empty()) {
+            channel.type = Channel::Silence;
+        }
+        break;
+    }
+
+    case Channel::Loopback: {
+        channel.output = config["output"].toInt(0);
+        if (channel.output >= m_outputs) {
+            qWarning() << "virtual audio: output" << channel.output << "doesn't exist";
+            channel.type = Channel::Silence;
+            break;
+        }
+        channel.delay = static_cast<std::size_t>(std::round(config["delay"].toDouble(0) * m_sampleRate));
+        auto lowpass = config["lowpass"].toDouble(0);
+        if (lowpass > 0) {
+            channel.filter = std::make_shared<math::LowPassFilter>(lowpass, M_SQRT1_2, m_sampleRate);
+        }
+        break;
+    }
+    }
+}
+
+DeviceInfo VirtualDevice::info() const
+{
+    DeviceInfo info(m_id, m_pluginName);
+    info.setName(m_name);
+    info.setDefaultSampleRate(m_sampleRate);
+
+    QStringList inputs, outputs;
+    for (unsigned int i = 0; i < m_inputs; ++i) {
+        inputs << QString("In %1").arg(i + 1);
+    }
+    for (unsigned int i = 0; i < m_outputs; ++i) {
+        outputs << QString("Out %1").arg(i + 1);
+    }
+    info.setInputChannels(inputs);
+    info.setOutputChannels(outputs);
+    return info;
+}
+
+Format VirtualDevice::format(const Plugin::Direction &mode) const
+{
+    Format format;
+    format.sampleRate = m_sampleRate;
+    format.channelCount = (mode == Plugin::Input ? m_inputs : m_outputs);
+    return format;
+}
+
+void VirtualDevice::addStream(Stream *stream, const Plugin::Direction &mode, QIODevice *endpoint)
+{
+    {
+        std::lock_guard<std::mutex> guard(m_streamsMutex);
+        m_streams[stream] = {mode, endpoint, {}, nullptr, {}};
+    }
+    if (!m_running.exchange(true)) {
+        if (m_thread.joinable()) {
+            m_thread.join();
+        }
+        m_thread = std::thread(&VirtualDevice::run, this);
+    }
+}
+
+void VirtualDevice::removeStream(Stream *stream)
+{
+    std::lock_guard<std::mutex> guard(m_streamsMutex);
+    m_streams.remove(stream);
+}
+
+void VirtualDevice::setSubscription(Stream *stream, const std::vector<unsigned int> &channels,
+                                    const Stream::ChannelsCallback &callback)
+{
+    std::lock_guard<std::mutex> guard(m_streamsMutex);
+    auto it = m_streams.find(stream);
+    if (it == m_streams.end()) {
+        return;
+    }
+    it->channels = callback ? channels : std::vector<unsigned int>();
+    it->callback = callback;
+    it->pointers.resize(it->channels.size());
+}
+
+void VirtualDevice::run()
+{
+    auto periodDuration = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                              std::chrono::duration<double>(static_cast<double>(m_period) / m_sampleRate));
+    auto next = std::chrono::steady_clock::now();
+
+    while (m_running) {
+        bool idle;
+        {
+            std::lock_guard<std::mutex> guard(m_streamsMutex);
+            idle = m_streams.isEmpty();
+            if (!idle) {
+                pullOutputs();
+                generateInputs();
+                pushInputs();
+            }
+        }
+
+        if (m_clock == Fast && !idle) {
+            //let closing streams take the mutex between the periods
+            std::this_thread::yield();
+            continue;
+        }
+        next += periodDuration;
+        auto now = std::chrono::steady_clock::now();
+        if (next < now - periodDuration) {
+            //too late, don't try to catch up
+            next = now;
+        }
+        std::this_thread::sleep_until(next);
+    }
+}
+
+void VirtualDevice::pullOutputs()
+{
+    std::fill(m_outputBuffer.begin(), m_outputBuffer.end(), 0.f);
+    for (auto &stream : m_streams) {
+        if (stream.mode != Plugin::Output || !stream.endpoint->isReadable()) {
+            continue;
+        }
+        auto read = stream.endpoint->read(reinterpret_cast<char *>(m_scratch.data()),
+                                          m_scratch.size() * sizeof(float));
+        auto count = std::max<qint64>(read, 0) / static_cast<qint64>(sizeof(float));
+        for (qint64 i = 0; i < count; ++i) {
+            m_outputBuffer[i] += m_scratch[i];
+        }
+    }
+
+    for (unsigned int output = 0; output < m_outputs; ++output) {
+        auto &line = m_delayLines[output];
+        for (std::size_t frame = 0; frame < m_period; ++frame) {
+            line[(m_written + frame) & m_delayMask] = m_outputBuffer[frame * m_outputs + output];
+        }
+    }
+    m_written += m_period;
+}
+
+void VirtualDevice::generateInputs()
+{
+    for (auto &channel : m_channels) {
+        auto &buffer = channel.buffer;
+        switch (channel.type) {
+        case Channel::Silence:
+            std::fill(buffer.begin(), buffer.end(), 0.f);
+            break;
+
+        case Channel::Sine: {
+            auto step = static_cast<float>(2 * M_PI * channel.frequency / m_sampleRate);
+            for (auto &sample : buffer) {
+                sample = channel.gain * std::sin(channel.phase);
+                channel.phase = std::fmod(channel.phase + step, static_cast<float>(2 * M_PI));
+            }
+            break;
+        }
+
+        case Channel::Noise: {
+            std::uniform_real_distribution<float> distribution(-1.f, 1.f);
+            for (auto &sample : buffer) {
+                sample = channel.gain * distribution(channel.random);
+            }
+            break;
+        }
+
+        case Channel::Wav:
+            for (auto &sample : buffer) {
+                sample = channel.gain * channel.samples[channel.position];
+                channel.position = (channel.position + 1) % channel.samples.size();
+            }
+            break;
+
+        case Channel::Loopback: {
+            auto &line = m_delayLines[channel.output];
+            auto start = m_written - m_period - channel.delay;
+            for (std::size_t frame = 0; frame < m_period; ++frame) {
+                auto sample = channel.gain * line[(start + frame) & m_delayMask];
+                buffer[frame] = channel.filter ? (*channel.filter)(sample) : sample;
+            }
+            break;
+        }
+        }
+    }
+}
+
+void VirtualDevice::pushInputs()
+{
+    Trace::Scope trace(Trace::AudioCallback);
+    bool interleaved = false;
+    for (auto &stream : m_streams) {
+        if (stream.mode != Plugin::Input) {
+            continue;
+        }
+
+        if (stream.callback) {
+            for (std::size_t i = 0; i < stream.channels.size(); ++i) {
+                auto channel = stream.channels[i];
+                stream.pointers[i] = channel < m_inputs ? m_channels[channel].buffer.data() : nullptr;
+            }
+            stream.callback(stream.pointers.data(), m_period);
+            continue;
+        }
+
+        if (!stream.endpoint->isWritable()) {
+            continue;
+        }
+        if (!interleaved) {
+            for (unsigned int input = 0; input < m_inputs; ++input) {
+                auto &buffer = m_channels[input].buffer;
+                for (std::size_t frame = 0; frame < m_period; ++frame) {
+                    m_inputBuffer[frame * m_inputs + input] = buffer[frame];
+                }
+            }
+            interleaved = true;
+        }
+        stream.endpoint->write(reinterpret_cast<char *>(m_inputBuffer.data()), m_inputBuffer.size() * sizeof(float));
+    }
+}
+
+} // namespace audio
@@ -0,0 +1,140 @@
+/**
+ *  OSM
+ *  Copyright (C) 2026  Pavel Smokotnin
+
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef AUDIO_VIRTUALPLUGIN_H
+#define AUDIO_VIRTUALPLUGIN_H
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+#include <QHash>
+#include <QJsonObject>
+#include "../plugin.h"
+
+namespace math {
+class Filter;
+}
+
+namespace audio {
+
+class VirtualDevice;
+
+//! Sound card emulation for load tests and machines without audio hardware.
+//! Enabled by OSM_VIRTUAL_AUDIO: a path to a JSON configuration, any other value gives the default loopback device.
+class VirtualPlugin : public Plugin
+{
+    Q_OBJECT
+
+public:
+    static constexpr const char *CONFIG_VARIABLE = "OSM_VIRTUAL_AUDIO";
+    static bool enabled();
+
+    VirtualPlugin();
+    ~VirtualPlugin();
+
+    QString name() const override;
+    DeviceInfo::List getDeviceInfoList() const override;
+    DeviceInfo::Id defaultDeviceId(const Direction &mode) const override;
+
+    Format deviceFormat(const DeviceInfo::Id &id, const Direction &mode) const override;
+    Stream *open(const DeviceInfo::Id &id, const Direction &mode, const Format &format, QIODevice *endpoint) override;
+
+private:
+    static QJsonObject defaultConfig();
+    VirtualDevice *device(const DeviceInfo::Id &id) const;
+
+    std::vector<std::unique_ptr<VirtualDevice>> m_devices;
+};
+
+//! N inputs and M outputs on one clock.
+//! Every period the outputs are pulled from the playing streams, then the inputs are synthesised and pushed.
+class VirtualDevice : public QObject
+{
+    Q_OBJECT
+
+public:
+    VirtualDevice(const DeviceInfo::Id &id, const QString &pluginName, const QJsonObject &config);
+    ~VirtualDevice();
+
+    DeviceInfo info() const;
+    Format format(const Plugin::Direction &mode) const;
+
+    //! thread safe, the clock thread doesn't process events
+    void addStream(Stream *stream, const Plugin::Direction &mode, QIODevice *endpoint);
+    void removeStream(Stream *stream);
+    void setSubscription(Stream *stream, const std::vector<unsigned int> &channels,
+                         const audio::Stream::ChannelsCallback &callback);
+
+private:
+    //! realtime sleeps until the next period, fast runs periods back to back
+    enum Clock {RealTime, Fast};
+
+    //! a generated input channel
+    struct Channel {
+        enum Type {Silence, Sine, Noise, Wav, Loopback};
+        Type type = Silence;
+        float gain = 1.f;
+        float frequency = 1000.f;
+        float phase = 0.f;
+        std::mt19937 random;
+        std::vector<float> samples;
+        std::size_t position = 0;
+        unsigned int output = 0;
+        std::size_t delay = 0;
+        std::shared_ptr<math::Filter> filter;
+        std::vector<float> buffer;
+    };
+    void readChannel(const QJsonObject &config, Channel &channel) const;
+
+    struct Endpoint {
+        Plugin::Direction mode;
+        QIODevice *endpoint;
+        std::vector<unsigned int> channels;
+        Stream::ChannelsCallback callback;
+        std::vector<const float *> pointers;
+    };
+
+    void run();
+    void pullOutputs();
+    void generateInputs();
+    void pushInputs();
+
+    DeviceInfo::Id m_id;
+    QString m_name, m_pluginName;
+    unsigned int m_sampleRate, m_inputs, m_outputs;
+    std::size_t m_period;
+    Clock m_clock;
+
+    std::vector<Channel> m_channels;
+    //! loopback delay lines of the outputs, a power of two long
+    std::vector<std::vector<float>> m_delayLines;
+    std::size_t m_delayMask, m_written;
+    std::vector<float> m_outputBuffer, m_inputBuffer, m_scratch;
+
+    std::mutex m_streamsMutex;
+    QHash<Stream *, Endpoint> m_streams;
+
+    std::thread m_thread;
+    std::atomic<bool> m_running;
+};
+
+} // namespace audio
+
+#endif // AUDIO_VIRTUALPLUGIN_H
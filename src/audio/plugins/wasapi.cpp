@@ -24,6 +24,7 @@
 #include <functiondiscoverykeys.h>
 #include <QThread>
 #include <QCoreApplication>
+#include "common/trace.h"
 
 namespace audio {
 
@@ -348,6 +349,7 @@ Stream *WasapiPlugin::open(const DeviceInfo::Id &id, const Plugin::Direction &mo
                     continue;
                 }
                 if (checkStatus(captureClient->GetBuffer(&data, &availableFramesCount, &flags, NULL, NULL), "GetBuffer")) {
+                    Trace::Scope trace(Trace::AudioCallback);
                     if (!(flags & AUDCLNT_BUFFERFLAGS_SILENT)) {
                         endpoint->write(reinterpret_cast<char *>(data), availableFramesCount * bytesPerFrame);
                     }
@@ -19,7 +19,7 @@
 
 namespace audio {
 
-Stream::Stream(const Format &format) : QObject(), m_active(true), m_depth(2)
+Stream::Stream(const Format &format) : QObject(), m_active(true), m_depth(2), m_channels(), m_channelsCallback()
 {
     m_format = format;
 }
@@ -56,4 +56,26 @@ void Stream::setDepth(const size_t &depth)
     m_depth = depth;
 }
 
+void Stream::subscribe(const std::vector<unsigned int> &channels, const ChannelsCallback &callback)
+{
+    m_channels = channels;
+    m_channelsCallback = callback;
+    emit subscriptionChanged();
+}
+
+void Stream::unsubscribe()
+{
+    subscribe({}, nullptr);
+}
+
+const std::vector<unsigned int> &Stream::channels() const
+{
+    return m_channels;
+}
+
+const Stream::ChannelsCallback &Stream::channelsCallback() const
+{
+    return m_channelsCallback;
+}
+
 } // namespace audio
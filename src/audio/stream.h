@@ -19,6 +19,8 @@
 #define AUDIO_STREAM_H
 
 #include <atomic>
+#include <functional>
+#include <vector>
 #include <QObject>
 #include "format.h"
 
@@ -31,6 +33,9 @@ class Stream : public QObject
 public:
     Stream(const Format &format);
 
+    //! channels[i] points to frames samples of the subscribed channel i, nullptr if the device hasn't it
+    using ChannelsCallback = std::function<void(const float *const *channels, size_t frames)>;
+
     void close();
     Format format() const;
     bool active() const;
@@ -39,14 +44,24 @@ public:
     size_t depth() const;
     void setDepth(const size_t &depth);
 
+    //! Planar delivery of the selected channels instead of the interleaved endpoint.
+    //! Used by plugins which demultiplex a device once per period, others keep writing to the endpoint.
+    void subscribe(const std::vector<unsigned int> &channels, const ChannelsCallback &callback);
+    void unsubscribe();
+    const std::vector<unsigned int> &channels() const;
+    const ChannelsCallback &channelsCallback() const;
+
 signals:
     void closeMe();
     void sampleRateChanged();
+    void subscriptionChanged();
 
 private:
     Format m_format;
     std::atomic<bool> m_active;
     size_t m_depth;
+    std::vector<unsigned int> m_channels;
+    ChannelsCallback m_channelsCallback;
 };
 
 } // namespace audio
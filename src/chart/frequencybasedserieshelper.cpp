@@ -27,6 +27,17 @@ FrequencyBasedSeriesHelper::FrequencyBasedSeriesHelper()
 void FrequencyBasedSeriesHelper::iterate(const unsigned int &pointsPerOctave,
                                          const std::function<void (const unsigned int &)> &accumulate,
                                          const std::function<void (const float &, const float &, const unsigned int &)> &collected)
+{
+    if (!source()) {
+        return;
+    }
+    iterate(*source(), pointsPerOctave, accumulate, collected);
+}
+
+void FrequencyBasedSeriesHelper::iterate(const Abstract::Data &data,
+                                         const unsigned int &pointsPerOctave,
+                                         const std::function<void (const unsigned int &)> &accumulate,
+                                         const std::function<void (const float &, const float &, const unsigned int &)> &collected)
 {
     unsigned int count = 0;
 
@@ -38,12 +49,12 @@ void FrequencyBasedSeriesHelper::iterate(const unsigned int &pointsPerOctave,
           lastBandEnd = bandStart,
           frequency;
 
-    if (!source() || _frequencyFactor < 1) {
+    if (_frequencyFactor < 1) {
         return;
     }
 
-    for (unsigned int i = 1; i < source()->frequencyDomainSize(); ++i) {
-        frequency = source()->frequency(i);
+    for (unsigned int i = 1; i < data.frequencyDomainSize(); ++i) {
+        frequency = data.frequency(i);
         if (frequency < bandStart) continue;
 
         if (pointsPerOctave > 0) {
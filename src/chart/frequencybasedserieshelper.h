@@ -28,6 +28,13 @@ class FrequencyBasedSeriesHelper
 public:
     explicit FrequencyBasedSeriesHelper();
 
+    //! group frequency bins of the data into bands of 1/pointsPerOctave octave, 0 - bin by bin
+    static void iterate(const Abstract::Data &data,
+                        const unsigned int &pointsPerOctave,
+                        const std::function<void(const unsigned int &)> &accumulate,
+                        const std::function<void(const float &start, const float &end, const unsigned int &count)> &collected
+                       );
+
 protected:
     constexpr const static float LEVEL_NORMALIZATION = 0;
 
@@ -163,6 +163,34 @@ void LevelPlot::setType(const Type &newType)
     }
 }
 
+std::uint64_t LevelPlot::readHistory(const math::LevelHistory &history, std::uint64_t after, Type type,
+                                     Weighting::Curve curve, Meter::Time time, Mode mode, std::size_t leqSeconds,
+                                     const std::function<void (float, float)> &append)
+{
+    auto curveIndex = math::LevelHistory::curveIndex(curve);
+    auto frames = history.frames(after);
+    if (frames.empty() || curveIndex < 0) {
+        return frames.empty() ? after : frames.back().index;
+    }
+
+    switch (type) {
+    case RMS:
+        for (auto &frame : frames) {
+            auto level = (time == Meter::Fast ? frame.fast : frame.slow)[curveIndex];
+            if (mode == SPL) {
+                level += SPL_OFFSET;
+            }
+            append(math::LevelHistory::FRAME_INTERVAL, level);
+        }
+        break;
+
+    case Leq:
+        append(frames.size() * math::LevelHistory::FRAME_INTERVAL, history.leq(curve, leqSeconds) + SPL_OFFSET);
+        break;
+    }
+    return frames.back().index;
+}
+
 void LevelPlot::setType(const QString &type)
 {
     std::find_if(m_typesMap.cbegin(), m_typesMap.cend(),
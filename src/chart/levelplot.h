@@ -18,11 +18,13 @@
 #ifndef CHART_LEVELPLOT_H
 #define CHART_LEVELPLOT_H
 
+#include <functional>
 #include "xyplot.h"
 #include "levelobject.h"
 #include "math/weighting.h"
 #include "math/meter.h"
 #include "math/leq.h"
+#include "math/levelhistory.h"
 
 namespace Chart {
 
@@ -62,6 +64,11 @@ public:
     void setType(const Type &newType);
     void setType(const QString &type);
 
+    //! appends {interval, level} of the frames logged after the frame `after`, returns the last read frame
+    static std::uint64_t readHistory(const math::LevelHistory &history, std::uint64_t after, Type type,
+                                     Weighting::Curve curve, Meter::Time time, Mode mode, std::size_t leqSeconds,
+                                     const std::function<void(float, float)> &append);
+
 signals:
     void curveChanged(QString) override;
     void timeChanged(QString) override;
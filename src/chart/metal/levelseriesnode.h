@@ -51,6 +51,7 @@ private:
     LevelPlot::Type m_type;
     QElapsedTimer m_timer;
     math::Leq m_leq;
+    std::uint64_t m_lastFrame;
 
     bool m_pause;
 
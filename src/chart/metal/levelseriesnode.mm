@@ -24,7 +24,7 @@ namespace Chart {
 #define id_cast(T, t) static_cast<id<T>>(t)
 
 LevelSeriesNode::LevelSeriesNode(QQuickItem *item): XYSeriesNode(item),
-    m_timer(), m_history(0)
+    m_timer(), m_lastFrame(0), m_history(0)
 {
     m_timer.restart();
 }
@@ -62,6 +62,7 @@ void LevelSeriesNode::synchronizeSeries()
                 m_leq.setTime(m_timeName);
             }
             m_history.clear();
+            m_lastFrame = 0;
         }
         m_pause = levelPlot->pause();
     }
@@ -75,27 +76,34 @@ void LevelSeriesNode::renderSeries()
     }
 
     if (!m_pause) {
-        switch (m_type) {
-        case LevelPlot::Type::RMS:
-            if (m_timer.elapsed() >= Measurement::TIMER_INTERVAL) {
-                auto time = static_cast<float>(m_timer.restart()) / 1000.f;
-                auto level = m_source->level(m_curve, m_time);
-                if (m_mode == LevelPlot::SPL) {
-                    level += LevelPlot::SPL_OFFSET;
-                }
-                m_history.push_back( {time, level});
-            }
-        case LevelPlot::Type::Leq:
-            if (m_timer.elapsed() >= 1000) {
-                auto time = static_cast<float>(m_timer.restart()) / 1000.f;
-                m_leq.addOneSecondValue(m_source->level(m_curve, Meter::Time::Fast));
-                auto level = m_leq.value() + LevelPlot::SPL_OFFSET;
+        if (auto history = m_source->levelHistory()) {
+            m_lastFrame = LevelPlot::readHistory(*history, m_lastFrame, m_type, m_curve, m_time, m_mode,
+                                                 m_leq.seconds(), [this](float time, float level) {
                 m_history.push_back( {time, level});
+            });
+        } else {
+            switch (m_type) {
+            case LevelPlot::Type::RMS:
+                if (m_timer.elapsed() >= Measurement::TIMER_INTERVAL) {
+                    auto time = static_cast<float>(m_timer.restart()) / 1000.f;
+                    auto level = m_source->level(m_curve, m_time);
+                    if (m_mode == LevelPlot::SPL) {
+                        level += LevelPlot::SPL_OFFSET;
+                    }
+                    m_history.push_back( {time, level});
+                }
+            case LevelPlot::Type::Leq:
+                if (m_timer.elapsed() >= 1000) {
+                    auto time = static_cast<float>(m_timer.restart()) / 1000.f;
+                    m_leq.addOneSecondValue(m_source->level(m_curve, Meter::Time::Fast));
+                    auto level = m_leq.value() + LevelPlot::SPL_OFFSET;
+                    m_history.push_back( {time, level});
+                }
             }
         }
     }
 
-    if (m_history.size() > MAX_HISTORY_SIZE) {
+    while (m_history.size() > MAX_HISTORY_SIZE) {
         m_history.pop_front();
     }
 
@@ -18,6 +18,7 @@
 #include "seriesnode.h"
 #include "seriesitem.h"
 #include "../plot.h"
+#include "common/trace.h"
 
 #include <QScreen>
 #include <QQuickWindow>
@@ -309,6 +310,7 @@ void *SeriesNode::allocPipelineStateDescriptor()
 
 void SeriesNode::render()
 {
+    Trace::Scope trace(Trace::Render);
     std::lock_guard guard(m_active);
     if (!m_initialized)
         return;
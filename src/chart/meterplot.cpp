@@ -132,7 +132,14 @@ QString MeterPlot::dBValue() const
         level = m_source->peak(curve(), time()) - m_source->level(curve(), time());
         break;
     case Leq:
-        level = m_leq.value() + SPL_OFFSET;
+        if (auto history = m_source->levelHistory()) {
+            level = history->leq(curve(), m_leq.seconds()) + SPL_OFFSET;
+            if (std::isnan(level)) {
+                return "-";
+            }
+        } else {
+            level = m_leq.value() + SPL_OFFSET;
+        }
         break;
     case Gain:
         level = m_source->level(Weighting::Z, Meter::Slow) - m_source->referenceLevel();
@@ -340,7 +347,10 @@ void MeterPlot::sourceReadyRead()
 void MeterPlot::timeReadyRead()
 {
     if (m_source && m_source->active() && m_type == Leq) {
-        m_leq.addOneSecondValue(m_source->level(curve(), Meter::Time::Fast));
+        //sources with the level history integrate Leq on their own
+        if (!m_source->levelHistory()) {
+            m_leq.addOneSecondValue(m_source->level(curve(), Meter::Time::Fast));
+        }
         emit valueChanged();
     } else if (m_type == Time) {
         emit valueChanged();
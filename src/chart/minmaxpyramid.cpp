@@ -0,0 +1,104 @@
+/**
+ *  OSM
+ *  Copyright (C) 2026  Pavel Smokotnin
+
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "minmaxpyramid.h"
+
+namespace Chart {
+
+MinMaxPyramid::MinMaxPyramid() : m_times(), m_values(), m_levels()
+{
+}
+
+void MinMaxPyramid::build(std::vector<float> &&times, std::vector<float> &&values)
+{
+    m_times  = std::move(times);
+    m_values = std::move(values);
+    m_values.resize(m_times.size());
+
+    auto merge = [](const Bucket & a, const Bucket & b) {
+        Bucket r = a;
+        if (b.min < r.min) {
+            r.min     = b.min;
+            r.minTime = b.minTime;
+        }
+        if (b.max > r.max) {
+            r.max     = b.max;
+            r.maxTime = b.maxTime;
+        }
+        return r;
+    };
+
+    unsigned int level = 0;
+    for (std::size_t count = m_values.size(); count > 2; count = (count + 1) / 2, ++level) {
+        if (m_levels.size() <= level) {
+            m_levels.emplace_back();
+        }
+        auto &buckets = m_levels[level];
+        buckets.resize((count + 1) / 2);
+
+        if (level == 0) {
+            for (std::size_t i = 0; i < buckets.size(); ++i) {
+                Bucket a = {m_times[2 * i], m_values[2 * i], m_times[2 * i], m_values[2 * i]};
+                if (2 * i + 1 < count) {
+                    Bucket b = {m_times[2 * i + 1], m_values[2 * i + 1], m_times[2 * i + 1], m_values[2 * i + 1]};
+                    a = merge(a, b);
+                }
+                buckets[i] = a;
+            }
+        } else {
+            auto &lower = m_levels[level - 1];
+            for (std::size_t i = 0; i < buckets.size(); ++i) {
+                buckets[i] = 2 * i + 1 < count ? merge(lower[2 * i], lower[2 * i + 1]) : lower[2 * i];
+            }
+        }
+    }
+    m_levels.resize(level);
+}
+
+void MinMaxPyramid::clear()
+{
+    m_times.clear();
+    m_values.clear();
+    m_levels.clear();
+}
+
+unsigned int MinMaxPyramid::size() const noexcept
+{
+    return static_cast<unsigned int>(m_values.size());
+}
+
+float MinMaxPyramid::time(unsigned int i) const noexcept
+{
+    return i < m_times.size() ? m_times[i] : 0;
+}
+
+float MinMaxPyramid::value(unsigned int i) const noexcept
+{
+    return i < m_values.size() ? m_values[i] : 0;
+}
+
+unsigned int MinMaxPyramid::lowerBound(float time) const noexcept
+{
+    return static_cast<unsigned int>(std::lower_bound(m_times.cbegin(), m_times.cend(), time) - m_times.cbegin());
+}
+
+unsigned int MinMaxPyramid::maxVertices(unsigned int columns) noexcept
+{
+    return 2 * (columns + 2);
+}
+
+} // namespace Chart
@@ -0,0 +1,109 @@
+/**
+ *  OSM
+ *  Copyright (C) 2026  Pavel Smokotnin
+
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef CHART_MINMAXPYRAMID_H
+#define CHART_MINMAXPYRAMID_H
+
+#include <algorithm>
+#include <vector>
+
+namespace Chart {
+
+/**
+ * @brief min/max level of detail for long time-domain series
+ *
+ * Level 0 keeps the samples, every next level merges pairs of buckets of the previous one
+ * and keeps the lowest and the highest value with their times. A draw picks the coarsest
+ * level that still has a bucket per screen column in the visible range, so the vertex
+ * count is bounded by the plot width, not by the series length. Peaks are kept at any level.
+ */
+class MinMaxPyramid
+{
+public:
+    MinMaxPyramid();
+
+    //! times must be ascending, sizes equal
+    void build(std::vector<float> &&times, std::vector<float> &&values);
+    void clear();
+
+    unsigned int size() const noexcept;
+    float time(unsigned int i) const noexcept;
+    float value(unsigned int i) const noexcept;
+    //! first sample not before time
+    unsigned int lowerBound(float time) const noexcept;
+
+    //! the upper limit of vertices passed by draw() for the columns
+    static unsigned int maxVertices(unsigned int columns) noexcept;
+
+    /**
+     * @brief passes vertices of [from, to] in time order to vertex(x, y)
+     * one sample beyond each edge is added so the line reaches the plot borders
+     * @return count of vertices
+     */
+    template<typename Callback>
+    unsigned int draw(float from, float to, unsigned int columns, Callback &&vertex) const
+    {
+        if (m_values.empty()) {
+            return 0;
+        }
+        unsigned int first = lowerBound(from);
+        unsigned int last  = lowerBound(to);
+        first = first > 0 ? first - 1 : 0;
+        last  = std::min(last + 1, size());
+
+        unsigned int level = 0;
+        while (level < m_levels.size() && ((last - first) >> level) > columns) {
+            ++level;
+        }
+
+        unsigned int count = 0;
+        if (level == 0) {
+            for (unsigned int i = first; i < last; ++i, ++count) {
+                vertex(m_times[i], m_values[i]);
+            }
+            return count;
+        }
+
+        auto &buckets = m_levels[level - 1];
+        unsigned int end = std::min(static_cast<unsigned int>(buckets.size()), ((last - 1) >> level) + 1);
+        for (unsigned int i = (first >> level); i < end; ++i) {
+            auto &bucket = buckets[i];
+            if (bucket.minTime < bucket.maxTime) {
+                vertex(bucket.minTime, bucket.min);
+                vertex(bucket.maxTime, bucket.max);
+            } else {
+                vertex(bucket.maxTime, bucket.max);
+                vertex(bucket.minTime, bucket.min);
+            }
+            count += 2;
+        }
+        return count;
+    }
+
+private:
+    struct Bucket {
+        float minTime, min, maxTime, max;
+    };
+
+    std::vector<float> m_times, m_values;
+    //! level n is at n - 1, a bucket of it covers 2^n samples
+    std::vector<std::vector<Bucket>> m_levels;
+};
+
+} // namespace Chart
+
+#endif // CHART_MINMAXPYRAMID_H
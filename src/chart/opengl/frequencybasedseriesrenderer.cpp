@@ -17,6 +17,7 @@
  */
 #include "frequencybasedseriesrenderer.h"
 #include "../xyplot.h"
+#include "math/complexkernel.h"
 
 using namespace Chart;
 
@@ -54,3 +55,15 @@ const Shared::Source &FrequencyBasedSeriesRenderer::source() const
 {
     return m_source;
 }
+
+const std::vector<float> &FrequencyBasedSeriesRenderer::phaseArguments()
+{
+    auto size = m_source->frequencyDomainSize();
+    m_phases.resize(size);
+    m_arguments.resize(size);
+    for (unsigned int i = 0; i < size; ++i) {
+        m_phases[i] = m_source->phase(i);
+    }
+    math::ComplexKernel::arg(m_phases, m_arguments);
+    return m_arguments;
+}
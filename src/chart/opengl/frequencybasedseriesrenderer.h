@@ -32,6 +32,8 @@ protected:
     virtual void updateMatrix() override;
     void setUniforms();
     const Shared::Source &source() const override;
+    //! argument of the source phase for every bin, refilled on each call
+    const std::vector<float> &phaseArguments();
 
 public:
     explicit FrequencyBasedSeriesRenderer();
@@ -40,6 +42,10 @@ protected:
     int m_minmaxUniform,
         m_screenUniform,
         m_widthUniform;
+
+private:
+    std::vector<Complex> m_phases;
+    std::vector<float> m_arguments;
 };
 }
 #endif // FREQUENCYBASEDSERIESRENDERER_H
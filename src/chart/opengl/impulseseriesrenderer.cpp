@@ -20,7 +20,8 @@
 using namespace Chart;
 
 ImpulseSeriesRenderer::ImpulseSeriesRenderer() : XYSeriesRenderer(false, false),
-    m_widthUniform(0), m_screenUniform(0), m_mode(ImpulsePlot::Mode::Linear)
+    m_widthUniform(0), m_screenUniform(0), m_normalized(false), m_mode(ImpulsePlot::Mode::Linear),
+    m_pyramid(), m_revision(0), m_rebuild(true)
 {
 }
 void ImpulseSeriesRenderer::init()
@@ -48,57 +49,78 @@ void ImpulseSeriesRenderer::init()
         m_matrixUniform = m_program.uniformLocation("matrix");
     }
 }
-void ImpulseSeriesRenderer::renderSeries()
+void ImpulseSeriesRenderer::buildPyramid()
 {
-    if (!m_source->active() || !m_source->timeDomainSize())
-        return;
-
-    unsigned int maxBufferSize = m_source->timeDomainSize() * (m_openGL33CoreFunctions ? 4 : VERTEX_PER_SEGMENT *
-                                                            LINE_VERTEX_SIZE), verticiesCount = 0;
-    if (m_vertices.size() != maxBufferSize) {
-        m_vertices.resize(maxBufferSize);
-        m_refreshBuffers = true;
-    }
-
+    auto size = m_source->timeDomainSize();
     float max = 0;
     if (m_normalized) {
-        for (unsigned int i = 0; i < m_source->timeDomainSize(); ++i) {
+        for (unsigned int i = 0; i < size; ++i) {
             max = std::max(max, std::abs(m_source->impulseValue(i)));
         }
     } else {
         max = 1;
     }
 
-    float dc =  (m_source->impulseValue(0) + m_source->impulseValue(m_source->timeDomainSize() - 1)) / 2;
+    float dc =  (m_source->impulseValue(0) + m_source->impulseValue(size - 1)) / 2;
     dc /= max;
-    float value = 0, lastValue = 0, lastTime = 0;
-    for (unsigned int i = 0, j = 0; i < m_source->timeDomainSize(); ++i) {
 
+    std::vector<float> times(size), values(size);
+    for (unsigned int i = 0; i < size; ++i) {
+        auto value = m_source->impulseValue(i) / max - dc;
         switch (m_mode) {
         case ImpulsePlot::Linear:
-            value = m_source->impulseValue(i) / max - dc;
+            values[i] = value;
             break;
         case ImpulsePlot::Log:
-            value = 10 * std::log10(std::pow(m_source->impulseValue(i) / max - dc, 2));
+            values[i] = 10 * std::log10(value * value);
             break;
         }
+        times[i] = m_source->impulseTime(i);
+    }
+    m_pyramid.build(std::move(times), std::move(values));
+}
 
+void ImpulseSeriesRenderer::renderSeries()
+{
+    if (!m_source->active() || !m_source->timeDomainSize())
+        return;
+
+    auto revision = m_source->dataRevision();
+    if (m_rebuild || m_revision != revision || m_pyramid.size() != m_source->timeDomainSize()) {
+        buildPyramid();
+        m_revision = revision;
+        m_rebuild = false;
+    }
+
+    auto columns = static_cast<unsigned int>(std::max(m_width, 1));
+    unsigned int maxBufferSize = MinMaxPyramid::maxVertices(columns) * (m_openGL33CoreFunctions ? 2 : VERTEX_PER_SEGMENT *
+                                                                        LINE_VERTEX_SIZE), verticiesCount = 0;
+    if (m_vertices.size() < maxBufferSize) {
+        m_vertices.resize(maxBufferSize);
+        m_refreshBuffers = true;
+    }
+
+    unsigned int j = 0;
+    bool first = true;
+    float lastValue = 0, lastTime = 0;
+    m_pyramid.draw(m_xMin, m_xMax, columns, [&](float time, float value) {
         if (m_openGL33CoreFunctions) {
-            m_vertices[j]     = m_source->impulseTime(i);
+            m_vertices[j]     = time;
             m_vertices[j + 1] = value;
             verticiesCount += 1;
             j += 2;
         } else {
-            if (i > 0) {
+            if (!first) {
                 addLineSegment(j, verticiesCount,
-                               lastTime,                 lastValue,
-                               m_source->impulseTime(i), value,
+                               lastTime, lastValue,
+                               time,     value,
                                1, 1);
             }
             lastValue = value;
-            lastTime = m_source->impulseTime(i);
+            lastTime = time;
+            first = false;
         }
-    }
+    });
 
     m_program.setUniformValue(m_matrixUniform, m_matrix);
     m_program.setUniformValue(m_screenUniform, m_width, m_height);
@@ -112,7 +134,8 @@ void ImpulseSeriesRenderer::renderSeries()
         m_openGL33CoreFunctions->glBindVertexArray(m_vertexArrayId);
         m_openGL33CoreFunctions->glBindBuffer(GL_ARRAY_BUFFER, m_vertexBufferId);
         if (m_refreshBuffers) {
-            m_openGL33CoreFunctions->glBufferData(GL_ARRAY_BUFFER, sizeof(GLfloat) * maxBufferSize, nullptr, GL_DYNAMIC_DRAW);
+            m_openGL33CoreFunctions->glBufferData(GL_ARRAY_BUFFER, sizeof(GLfloat) * m_vertices.size(), nullptr,
+                                                  GL_DYNAMIC_DRAW);
             m_openGL33CoreFunctions->glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(GLfloat),
                                                            reinterpret_cast<const void *>(0));
         }
@@ -133,8 +156,11 @@ void ImpulseSeriesRenderer::synchronize(QQuickFramebufferObject *item)
     XYSeriesRenderer::synchronize(item);
 
     if (auto *plot = dynamic_cast<ImpulsePlot *>(m_item ? m_item->parent() : nullptr)) {
-        m_mode = plot->mode();
-        m_normalized = plot->normalized();
+        if (m_mode != plot->mode() || m_normalized != plot->normalized()) {
+            m_mode = plot->mode();
+            m_normalized = plot->normalized();
+            m_rebuild = true;
+        }
     }
 
 }
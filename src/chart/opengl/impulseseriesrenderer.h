@@ -20,6 +20,7 @@
 
 #include "xyseriesrenderer.h"
 #include "../impulseplot.h"
+#include "chart/minmaxpyramid.h"
 
 namespace Chart {
 class ImpulseSeriesRenderer : public XYSeriesRenderer
@@ -34,9 +35,16 @@ protected:
     virtual void updateMatrix() override;
 
 private:
+    //! plotted values of the whole impulse, call under the source lock
+    void buildPyramid();
+
     int m_widthUniform, m_screenUniform;
     bool m_normalized;
     ImpulsePlot::Mode m_mode;
+
+    MinMaxPyramid m_pyramid;
+    unsigned int m_revision;
+    bool m_rebuild;
 };
 
 }
@@ -21,7 +21,8 @@
 
 namespace Chart {
 
-LevelSeriesRenderer::LevelSeriesRenderer(): XYSeriesRenderer(false, false), m_timer(), m_history(0)
+LevelSeriesRenderer::LevelSeriesRenderer(): XYSeriesRenderer(false, false), m_timer(), m_lastFrame(0), m_history(0),
+    m_pyramid(), m_rebuild(true)
 {
     m_timer.restart();
 }
@@ -78,6 +79,8 @@ void LevelSeriesRenderer::synchronize(QQuickFramebufferObject *item)
                 m_leq.setTime(m_timeName);
             }
             m_history.clear();
+            m_lastFrame = 0;
+            m_rebuild = true;
         }
         m_pause = plot->pause();
     }
@@ -95,56 +98,75 @@ void LevelSeriesRenderer::renderSeries()
         return;
     }
 
+    auto historySize = m_history.size();
     if (!m_pause) {
-        switch (m_type) {
-        case LevelPlot::Type::RMS:
-            if (m_timer.elapsed() >= Measurement::TIMER_INTERVAL) {
-                auto time = static_cast<float>(m_timer.restart()) / 1000.f;
-                auto level = m_source->level(m_curve, m_time);
-                if (m_mode == LevelPlot::SPL) {
-                    level += LevelPlot::SPL_OFFSET;
-                }
-                m_history.push_back( {time, level});
-            }
-        case LevelPlot::Type::Leq:
-            if (m_timer.elapsed() >= 1000) {
-                auto time = static_cast<float>(m_timer.restart()) / 1000.f;
-                m_leq.addOneSecondValue(m_source->level(m_curve, Meter::Time::Fast));
-                auto level = m_leq.value() + LevelPlot::SPL_OFFSET;
+        if (auto history = m_source->levelHistory()) {
+            m_lastFrame = LevelPlot::readHistory(*history, m_lastFrame, m_type, m_curve, m_time, m_mode,
+                                                 m_leq.seconds(), [this](float time, float level) {
                 m_history.push_back( {time, level});
+            });
+        } else {
+            switch (m_type) {
+            case LevelPlot::Type::RMS:
+                if (m_timer.elapsed() >= Measurement::TIMER_INTERVAL) {
+                    auto time = static_cast<float>(m_timer.restart()) / 1000.f;
+                    auto level = m_source->level(m_curve, m_time);
+                    if (m_mode == LevelPlot::SPL) {
+                        level += LevelPlot::SPL_OFFSET;
+                    }
+                    m_history.push_back( {time, level});
+                }
+            case LevelPlot::Type::Leq:
+                if (m_timer.elapsed() >= 1000) {
+                    auto time = static_cast<float>(m_timer.restart()) / 1000.f;
+                    m_leq.addOneSecondValue(m_source->level(m_curve, Meter::Time::Fast));
+                    auto level = m_leq.value() + LevelPlot::SPL_OFFSET;
+                    m_history.push_back( {time, level});
+                }
             }
         }
     }
 
-    if (m_history.size() > MAX_HISTORY_SIZE) {
+    m_rebuild = m_rebuild || m_history.size() != historySize;
+    while (m_history.size() > MAX_HISTORY_SIZE) {
         m_history.pop_front();
     }
 
+    if (m_rebuild) {
+        std::vector<float> times(m_history.size()), values(m_history.size());
+        float time = 0;
+        auto i = m_history.size();
+        for (auto point = m_history.crbegin(); point != m_history.crend(); ++point) {
+            --i;
+            time -= point->time;
+            times[i] = time;
+            values[i] = point->value;
+        }
+        m_pyramid.build(std::move(times), std::move(values));
+        m_rebuild = false;
+    }
+
+    auto columns = static_cast<unsigned int>(std::max(m_width, 1));
     unsigned int maxBufferSize =
-        MAX_HISTORY_SIZE * (m_openGL33CoreFunctions ? 4 : VERTEX_PER_SEGMENT * LINE_VERTEX_SIZE),
+        MinMaxPyramid::maxVertices(columns) * (m_openGL33CoreFunctions ? 2 : VERTEX_PER_SEGMENT * LINE_VERTEX_SIZE),
         verticiesCount = 0;
 
-    if (m_vertices.size() != maxBufferSize) {
+    if (m_vertices.size() < maxBufferSize) {
         m_vertices.resize(maxBufferSize);
         m_refreshBuffers = true;
     }
 
-    float time = 0, level = 0;
-    unsigned int j = 0, i = 0;
+    unsigned int j = 0;
+    bool first = true;
     timePoint lastPoint = {0, 0};
-
-    for (auto point = m_history.crbegin(); point != m_history.crend(); ++point) {
-        time -= point->time;
-        level = point->value;
-        ++i;
-
+    m_pyramid.draw(m_xMin, m_xMax, columns, [&](float time, float level) {
         if (m_openGL33CoreFunctions) {
             m_vertices[j] = time;
             m_vertices[j + 1] = level;
             verticiesCount += 1;
             j += 2;
         } else {
-            if (lastPoint.time < 0) {
+            if (!first) {
                 addLineSegment(j, verticiesCount,
                                lastPoint.time, lastPoint.value,
                                time, level,
@@ -152,8 +174,9 @@ void LevelSeriesRenderer::renderSeries()
             }
             lastPoint.time = time;
             lastPoint.value = level;
+            first = false;
         }
-    }
+    });
 
     m_program.setUniformValue(m_matrixUniform, m_matrix);
     m_program.setUniformValue(m_screenUniform, m_width, m_height);
@@ -167,7 +190,8 @@ void LevelSeriesRenderer::renderSeries()
         m_openGL33CoreFunctions->glBindVertexArray(m_vertexArrayId);
         m_openGL33CoreFunctions->glBindBuffer(GL_ARRAY_BUFFER, m_vertexBufferId);
         if (m_refreshBuffers) {
-            m_openGL33CoreFunctions->glBufferData(GL_ARRAY_BUFFER, sizeof(GLfloat) * maxBufferSize, nullptr, GL_DYNAMIC_DRAW);
+            m_openGL33CoreFunctions->glBufferData(GL_ARRAY_BUFFER, sizeof(GLfloat) * m_vertices.size(), nullptr,
+                                                  GL_DYNAMIC_DRAW);
             m_openGL33CoreFunctions->glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(GLfloat),
                                                            reinterpret_cast<const void *>(0));
         }
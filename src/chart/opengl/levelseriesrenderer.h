@@ -23,6 +23,7 @@
 
 #include "xyseriesrenderer.h"
 #include "chart/levelplot.h"
+#include "chart/minmaxpyramid.h"
 #include "math/weighting.h"
 #include "math/meter.h"
 
@@ -49,6 +50,7 @@ private:
     LevelPlot::Type m_type;
     QElapsedTimer m_timer;
     math::Leq m_leq;
+    std::uint64_t m_lastFrame;
 
     bool m_pause;
 
@@ -58,6 +60,9 @@ private:
     };
     static const unsigned int MAX_HISTORY_SIZE = 750;
     std::deque<timePoint> m_history;
+    //! the history on the plot time axis, rebuilt when a point is added
+    MinMaxPyramid m_pyramid;
+    bool m_rebuild;
 };
 
 } // namespace chart
@@ -85,12 +85,13 @@ void PhaseDelaySeriesRenderer::renderSeries()
     xadd = -1.0f * logf(m_xMin);
     xmul = m_width / logf(m_xMax / m_xMin);
     int periods = 0;
+    const auto &arguments = phaseArguments();
 
     auto accumulate = [ &, this] (const unsigned int &i) {
-        auto v = m_source->phase(i).arg() + periods * 2.0 * M_PI;
+        auto v = arguments[i] + periods * 2.0 * M_PI;
         if (std::abs(lastValue - v) > M_PI) {
             periods += (lastValue - v) > 0 ? 1 : -1;
-            v = m_source->phase(i).arg() + periods * 2.0 * M_PI;
+            v = arguments[i] + periods * 2.0 * M_PI;
         }
         value +=  v;
         lastValue = v;
@@ -25,7 +25,7 @@ using namespace Chart;
 
 PhaseSeriesRenderer::PhaseSeriesRenderer() : FrequencyBasedSeriesRenderer(),
     m_coherenceThresholdU(0), m_coherenceAlpha(0),
-    m_pointsPerOctave(0), m_rotate(0),
+    m_pointsPerOctave(0), m_rotation(1),
     m_coherenceThreshold(0), m_coherence(false)
 {
 }
@@ -65,7 +65,7 @@ void PhaseSeriesRenderer::synchronize(QQuickFramebufferObject *item)
         m_pointsPerOctave = phasePlot->pointsPerOctave();
         m_coherence = phasePlot->coherence();
         constexpr float pk = static_cast<float>(-M_PI / 180.0);
-        m_rotate = phasePlot->rotate() *  pk;
+        m_rotation.polar(phasePlot->rotate() *  pk);
         m_coherenceThreshold = phasePlot->coherenceThreshold();
     }
 }
@@ -94,7 +94,7 @@ void PhaseSeriesRenderer::renderSeries()
         coherence += m_source->coherence(i);
     };
     auto beforeSpline = [this] (const auto * value, auto, const auto & count) {
-        return value->rotate(m_rotate) / count;
+        return (*value) * m_rotation / count;
     };
     auto collected = [ &, this] (const float & f1, const float & f2, const Complex ac[4], const float c[4]) {
         if (i + 16 > maxBufferSize) {
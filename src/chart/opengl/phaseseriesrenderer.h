@@ -32,7 +32,9 @@ public:
 private:
     int  m_coherenceThresholdU, m_coherenceAlpha;
     unsigned int m_pointsPerOctave;
-    float m_rotate, m_coherenceThreshold;
+    //! the plot rotation as a unit vector, applied to every band without sin/cos
+    Complex m_rotation;
+    float m_coherenceThreshold;
     bool m_coherence;
 };
 }
@@ -0,0 +1,133 @@
+/**
+ *  OSM
+ *  Copyright (C) 2026  Pavel Smokotnin
+
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "plotfbo.h"
+
+#include <QQuickWindow>
+#include "seriesfbo.h"
+#include "seriesrenderer.h"
+#include "chart/seriesesitem.h"
+#include "common/trace.h"
+
+using namespace Chart;
+
+PlotFBO::PlotFBO(SeriesesItem *serieses) : QQuickFramebufferObject(serieses)
+{
+    setFlag(QQuickItem::ItemHasContents);
+}
+
+bool PlotFBO::enabled()
+{
+    static const bool enabled = !qEnvironmentVariableIsSet(DISABLE_VARIABLE);
+    return enabled;
+}
+
+QQuickFramebufferObject::Renderer *PlotFBO::createRenderer() const
+{
+    return new PlotRenderer();
+}
+
+std::vector<SeriesFBO *> PlotFBO::serieses() const
+{
+    std::vector<SeriesFBO *> list;
+    if (parentItem()) {
+        collect(parentItem(), list);
+    }
+    return list;
+}
+
+void PlotFBO::collect(const QQuickItem *parent, std::vector<SeriesFBO *> &list)
+{
+    auto children = parent->childItems();
+    std::stable_sort(children.begin(), children.end(), [](auto a, auto b) {
+        return a->z() < b->z();
+    });
+    for (auto *child : children) {
+        if (!child->isVisible()) {
+            continue;
+        }
+        if (auto *series = qobject_cast<SeriesFBO *>(child)) {
+            list.push_back(series);
+        } else if (qobject_cast<SeriesesItem *>(child)) {
+            collect(child, list);
+        }
+    }
+}
+
+PlotRenderer::PlotRenderer() : m_item(nullptr), m_children(), m_openGLFunctions(nullptr)
+{
+}
+
+PlotRenderer::~PlotRenderer() = default;
+
+QOpenGLFramebufferObject *PlotRenderer::createFramebufferObject(const QSize &size)
+{
+    QOpenGLFramebufferObjectFormat format;
+    format.setAttachment(QOpenGLFramebufferObject::CombinedDepthStencil);
+    if (!m_openGLFunctions) {
+        m_openGLFunctions = QOpenGLContext::currentContext()->functions();
+        m_openGLFunctions->initializeOpenGLFunctions();
+    }
+    return new QOpenGLFramebufferObject(size, format);
+}
+
+void PlotRenderer::synchronize(QQuickFramebufferObject *item)
+{
+    m_item = qobject_cast<PlotFBO *>(item);
+    auto serieses = m_item ? m_item->serieses() : std::vector<SeriesFBO *> {};
+
+    std::vector<Child> children;
+    children.reserve(serieses.size());
+    for (auto *series : serieses) {
+        auto it = std::find_if(m_children.begin(), m_children.end(), [series](const auto & child) {
+            return child.item == series;
+        });
+
+        std::unique_ptr<SeriesRenderer> renderer;
+        if (it != m_children.end()) {
+            renderer = std::move(it->renderer);
+        } else {
+            renderer.reset(static_cast<SeriesRenderer *>(series->createRenderer()));
+        }
+        renderer->synchronize(series);
+        children.push_back({series, std::move(renderer)});
+    }
+    //renderers of removed series are released here
+    m_children = std::move(children);
+}
+
+void PlotRenderer::render()
+{
+    Trace::Scope trace(Trace::Render);
+    if (!m_item || !m_openGLFunctions) {
+        return;
+    }
+
+    auto size = framebufferObject()->size();
+    m_openGLFunctions->glViewport(0, 0, size.width(), size.height());
+    m_openGLFunctions->glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+    m_openGLFunctions->glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
+
+    for (auto &child : m_children) {
+        child.renderer->initializeGL();
+        child.renderer->draw();
+    }
+
+    if (m_item->window()) {
+        m_item->window()->resetOpenGLState();
+    }
+}
@@ -0,0 +1,84 @@
+/**
+ *  OSM
+ *  Copyright (C) 2026  Pavel Smokotnin
+
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef PLOTFBO_H
+#define PLOTFBO_H
+
+#include <QQuickFramebufferObject>
+#include <QOpenGLFunctions>
+#include <QPointer>
+
+namespace Chart {
+
+class SeriesesItem;
+class SeriesFBO;
+class SeriesRenderer;
+
+/**
+ * @brief draws every series of a plot into one framebuffer
+ *
+ * Owned by the root SeriesesItem and placed over the plot area. SeriesFBO items keep their
+ * state but have no contents: their updates are forwarded here and the scene graph merges
+ * them into one render per frame. Each series keeps its own SeriesRenderer, they draw one
+ * after another into the shared framebuffer after a single clear.
+ *
+ * OSM_SERIES_FBO environment variable restores a framebuffer per series.
+ */
+class PlotFBO : public QQuickFramebufferObject
+{
+    Q_OBJECT
+
+public:
+    static constexpr const char *DISABLE_VARIABLE = "OSM_SERIES_FBO";
+
+    explicit PlotFBO(SeriesesItem *serieses);
+    static bool enabled();
+
+    QQuickFramebufferObject::Renderer *createRenderer() const override;
+
+    //! visible series in the scene graph paint order
+    std::vector<SeriesFBO *> serieses() const;
+
+private:
+    static void collect(const QQuickItem *parent, std::vector<SeriesFBO *> &list);
+};
+
+class PlotRenderer : public QQuickFramebufferObject::Renderer
+{
+public:
+    PlotRenderer();
+    ~PlotRenderer() override;
+
+    QOpenGLFramebufferObject *createFramebufferObject(const QSize &size) override;
+    void synchronize(QQuickFramebufferObject *item) override;
+    void render() override;
+
+private:
+    struct Child {
+        QPointer<SeriesFBO> item;
+        std::unique_ptr<SeriesRenderer> renderer;
+    };
+
+    QPointer<PlotFBO> m_item;
+    //! in the draw order
+    std::vector<Child> m_children;
+    QOpenGLFunctions *m_openGLFunctions;
+};
+
+} // namespace Chart
+
+#endif // PLOTFBO_H
@@ -17,13 +17,14 @@
  */
 #include "seriesfbo.h"
 #include "seriesrenderer.h"
+#include "plotfbo.h"
 
 using namespace Chart;
 
 SeriesFBO::SeriesFBO(Shared::Source source, RendererCreator rc, QQuickItem *parent):
     QQuickFramebufferObject(parent),
     m_rendererCreator(std::move(rc)),
-    m_source(source), m_highlighted(false)
+    m_source(source), m_highlighted(false), m_batch(nullptr)
 {
     setFlag(QQuickItem::ItemHasContents);
     connect(source.get(), SIGNAL(colorChanged(QColor)), SLOT(update()));
@@ -31,8 +32,11 @@ SeriesFBO::SeriesFBO(Shared::Source source, RendererCreator rc, QQuickItem *pare
     connect(source.get(), SIGNAL(activeChanged()),      SLOT(update()));
 }
 
-SeriesFBO::~SeriesFBO() {
-
+SeriesFBO::~SeriesFBO()
+{
+    if (m_batch) {
+        m_batch->update();
+    }
 }
 
 const Shared::Source &SeriesFBO::source() const noexcept
@@ -56,6 +60,9 @@ QQuickFramebufferObject::Renderer *SeriesFBO::createRenderer() const
 void SeriesFBO::setZIndex(qreal index)
 {
     setZ(index);
+    if (m_batch) {
+        m_batch->update();
+    }
 }
 bool SeriesFBO::highlighted() const noexcept
 {
@@ -68,3 +75,24 @@ void SeriesFBO::setHighlighted(bool highlighted)
         update();
     }
 }
+void SeriesFBO::setBatch(PlotFBO *batch)
+{
+    m_batch = batch;
+    QQuickItem::update();
+}
+void SeriesFBO::update()
+{
+    if (m_batch) {
+        m_batch->update();
+    } else {
+        QQuickFramebufferObject::update();
+    }
+}
+QSGNode *SeriesFBO::updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *data)
+{
+    if (m_batch) {
+        delete oldNode;
+        return nullptr;
+    }
+    return QQuickFramebufferObject::updatePaintNode(oldNode, data);
+}
@@ -19,10 +19,13 @@
 #define SERIESFBO_H
 
 #include <QQuickFramebufferObject>
+#include <QPointer>
 #include "abstract/source.h"
 
 namespace Chart {
 
+class PlotFBO;
+
 typedef std::function<QQuickFramebufferObject::Renderer* (void)> RendererCreator;
 
 class SeriesFBO : public QQuickFramebufferObject
@@ -39,13 +42,22 @@ public:
     bool highlighted() const noexcept;
     void setHighlighted(bool highlighted);
 
+    //! the series is drawn by the plot framebuffer and has no own one
+    void setBatch(PlotFBO *batch);
+
+public slots:
+    void update();
+
 signals:
     void preSourceDeleted();
 
 protected:
+    QSGNode *updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *data) override;
+
     RendererCreator m_rendererCreator;
     Shared::Source m_source;
     bool m_highlighted;
+    QPointer<PlotFBO> m_batch;
 };
 }
 #endif // SERIESFBO_H
@@ -20,7 +20,7 @@
 #include <QQuickWindow>
 #include "seriesfbo.h"
 #include "../plot.h"
-#include "common/profiler.h"
+#include "common/trace.h"
 #include "chart/seriesesitem.h"
 using namespace Chart;
 
@@ -46,6 +46,11 @@ QOpenGLFramebufferObject *SeriesRenderer::createFramebufferObject(const QSize &s
 {
     QOpenGLFramebufferObjectFormat format;
     format.setAttachment(QOpenGLFramebufferObject::CombinedDepthStencil);
+    initializeGL();
+    return new QOpenGLFramebufferObject(size, format);
+}
+void SeriesRenderer::initializeGL()
+{
     if (!m_openGLFunctions) {
         m_openGLFunctions = QOpenGLContext::currentContext()->functions();
         m_openGLFunctions->initializeOpenGLFunctions();
@@ -58,7 +63,6 @@ QOpenGLFramebufferObject *SeriesRenderer::createFramebufferObject(const QSize &s
         }
         init();
     }
-    return new QOpenGLFramebufferObject(size, format);
 }
 void SeriesRenderer::synchronize(QQuickFramebufferObject *item)
 {
@@ -171,9 +175,7 @@ void SeriesRenderer::setOnDelete(const std::function<void ()> &newOnDelete)
 
 void SeriesRenderer::render()
 {
-#ifdef QT_DEBUG
-    Profiler p("SeriesRender");
-#endif
+    Trace::Scope trace(Trace::Render);
     std::lock_guard<std::mutex> guard(m_active);
     if (!m_item) {
         return;
@@ -194,6 +196,20 @@ void SeriesRenderer::render()
 
     m_openGLFunctions->glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
     m_openGLFunctions->glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
+
+    drawSeries();
+    plot->window()->resetOpenGLState();
+}
+void SeriesRenderer::draw()
+{
+    std::lock_guard<std::mutex> guard(m_active);
+    if (!m_item || !m_source || !m_program.isLinked()) {
+        return;
+    }
+    drawSeries();
+}
+void SeriesRenderer::drawSeries()
+{
     m_openGLFunctions->glEnable(GL_BLEND);
     m_openGLFunctions->glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
@@ -215,7 +231,6 @@ void SeriesRenderer::render()
     }
 
     m_program.release();
-    plot->window()->resetOpenGLState();
 }
 void SeriesRenderer::setWeight(unsigned int weight)
 {
@@ -57,6 +57,11 @@ public:
     void render() override final;
     virtual void renderSeries() = 0;
 
+    //! loads the GL functions and calls init() once, needs the current context
+    void initializeGL();
+    //! draws the series into the bound framebuffer without clearing it
+    void draw();
+
     virtual void setWeight(unsigned int weight);
 
     QOpenGLFramebufferObject *createFramebufferObject(const QSize &size) override;
@@ -98,6 +103,8 @@ protected:
     constexpr static const unsigned int PPO_BUFFER_MUL = 13 * VERTEX_PER_SEGMENT * LINE_VERTEX_SIZE * MAX_LINE_SPLITF;
 
 private:
+    void drawSeries();
+
     std::mutex m_active;
     std::function<void()> m_onDelete = nullptr;
 };
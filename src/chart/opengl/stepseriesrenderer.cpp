@@ -20,7 +20,8 @@
 #include "common/notifier.h"
 using namespace Chart;
 
-StepSeriesRenderer::StepSeriesRenderer() : XYSeriesRenderer(false, false), m_window(WindowFunction::Hann)
+StepSeriesRenderer::StepSeriesRenderer() : XYSeriesRenderer(false, false), m_window(WindowFunction::Hann),
+    m_zero(0), m_pyramid(), m_revision(0), m_rebuild(true)
 {
 }
 
@@ -49,44 +50,71 @@ void StepSeriesRenderer::init()
     }
 }
 
+void StepSeriesRenderer::buildPyramid()
+{
+    auto size = m_source->timeDomainSize();
+    float res = 0.f;
+    float dcOffset = 0;
+    for (unsigned int i = 1; i < size / 4; ++i) {
+        dcOffset += m_source->impulseValue(i);
+    }
+    dcOffset /= size / 4.0;
+
+    std::vector<float> times, values;
+    times.reserve(size);
+    values.reserve(size);
+    for (unsigned int i = 1; i < size - 1; ++i) {
+        res += m_source->impulseValue(i) - dcOffset;
+        times.push_back(m_source->impulseTime(i));
+        values.push_back(res);
+    }
+    m_pyramid.build(std::move(times), std::move(values));
+}
+
 void StepSeriesRenderer::renderSeries()
 {
     if (!m_source->active() || !m_source->timeDomainSize())
         return;
 
-    unsigned int maxBufferSize = m_source->timeDomainSize() * (m_openGL33CoreFunctions ? 4 : VERTEX_PER_SEGMENT *
-                                                            LINE_VERTEX_SIZE), verticiesCount = 0;
-    if (m_vertices.size() != maxBufferSize) {
-        m_vertices.resize(maxBufferSize);
-        m_refreshBuffers = true;
+    auto revision = m_source->dataRevision();
+    if (m_rebuild || m_revision != revision) {
+        buildPyramid();
+        m_revision = revision;
+        m_rebuild = false;
     }
 
-    float res = 0.f;
-    float offsetValue = 0;
-    float dcOffset = 0;
-    for (unsigned int i = 1; i < m_source->timeDomainSize() / 4; ++i) {
-        dcOffset += m_source->impulseValue(i);
+    auto columns = static_cast<unsigned int>(std::max(m_width, 1));
+    unsigned int maxBufferSize = MinMaxPyramid::maxVertices(columns) * (m_openGL33CoreFunctions ? 2 : VERTEX_PER_SEGMENT *
+                                                                        LINE_VERTEX_SIZE), verticiesCount = 0;
+    if (m_vertices.size() < maxBufferSize) {
+        m_vertices.resize(maxBufferSize);
+        m_refreshBuffers = true;
     }
-    dcOffset /= m_source->timeDomainSize() / 4.0;
-    for (unsigned int i = 1, j = 0; i < m_source->timeDomainSize() - 1; ++i) {
-        res += m_source->impulseValue(i) - dcOffset;
 
+    unsigned int j = 0;
+    bool first = true;
+    float lastValue = 0, lastTime = 0;
+    m_pyramid.draw(m_xMin, m_xMax, columns, [&](float time, float value) {
         if (m_openGL33CoreFunctions) {
-            m_vertices[j] = m_source->impulseTime(i);
-            m_vertices[j + 1] = res;
+            m_vertices[j] = time;
+            m_vertices[j + 1] = value;
             verticiesCount += 1;
             j += 2;
         } else {
-            addLineSegment(j, verticiesCount,
-                           m_source->impulseTime(i), res,
-                           m_source->impulseTime(i + 1), res + m_source->impulseValue(i + 1) - dcOffset,
-                           1, 1);
+            if (!first) {
+                addLineSegment(j, verticiesCount,
+                               lastTime, lastValue,
+                               time,     value,
+                               1, 1);
+            }
+            lastValue = value;
+            lastTime = time;
+            first = false;
         }
+    });
 
-        if (m_source->impulseTime(i) < m_zero) {
-            offsetValue = res;
-        }
-    }
+    auto zero = m_pyramid.lowerBound(m_zero);
+    float offsetValue = zero > 0 ? m_pyramid.value(zero - 1) : 0;
 
     updateMatrix();
     m_matrix.translate(QVector3D(0, -offsetValue, 0));
@@ -102,7 +130,8 @@ void StepSeriesRenderer::renderSeries()
         m_openGL33CoreFunctions->glBindVertexArray(m_vertexArrayId);
         m_openGL33CoreFunctions->glBindBuffer(GL_ARRAY_BUFFER, m_vertexBufferId);
         if (m_refreshBuffers) {
-            m_openGL33CoreFunctions->glBufferData(GL_ARRAY_BUFFER, sizeof(GLfloat) * maxBufferSize, nullptr, GL_DYNAMIC_DRAW);
+            m_openGL33CoreFunctions->glBufferData(GL_ARRAY_BUFFER, sizeof(GLfloat) * m_vertices.size(), nullptr,
+                                                  GL_DYNAMIC_DRAW);
             m_openGL33CoreFunctions->glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(GLfloat),
                                                            reinterpret_cast<const void *>(0));
         }
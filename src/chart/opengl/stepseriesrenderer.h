@@ -20,6 +20,7 @@
 
 #include "xyseriesrenderer.h"
 #include "math/windowfunction.h"
+#include "chart/minmaxpyramid.h"
 
 namespace Chart {
 
@@ -35,10 +36,17 @@ protected:
     virtual void updateMatrix() override;
 
 private:
+    //! integrated impulse, call under the source lock
+    void buildPyramid();
+
     int m_widthUniform, m_screenUniform;
     WindowFunction m_window;
     std::vector<float> m_windowed;
     float m_zero;
+
+    MinMaxPyramid m_pyramid;
+    unsigned int m_revision;
+    bool m_rebuild;
 };
 
 } // namespace chart
@@ -21,6 +21,9 @@
 #include "chart/plot.h"
 #include "source/group.h"
 #include "remote/items/groupitem.h"
+#ifdef GRAPH_OPENGL
+#include "chart/opengl/plotfbo.h"
+#endif
 
 namespace Chart {
 
@@ -31,6 +34,14 @@ SeriesesItem::SeriesesItem(QQuickItem *parent, Plot *plot) : QQuickItem(parent),
     connect(parent, &QQuickItem::heightChanged, this, &SeriesesItem::parentHeightChanged);
     setWidth(parent->width());
     setHeight(parent->height());
+
+#ifdef GRAPH_OPENGL
+    if (plot && parent == plot && PlotFBO::enabled()) {
+        m_batch = new PlotFBO(this);
+        applyWidthForSeries(m_batch);
+        applyHeightForSeries(m_batch);
+    }
+#endif
 }
 
 SeriesesItem::~SeriesesItem()
@@ -157,6 +168,9 @@ bool SeriesesItem::appendDataSource(const Shared::Source &source)
             return false;
         }
         sourceItem->setParentItem(this);
+#ifdef GRAPH_OPENGL
+        sourceItem->setBatch(batch());
+#endif
         m_serieses.append(sourceItem);
         item = static_cast<QQuickItem *>(sourceItem);
     }
@@ -225,6 +239,11 @@ void SeriesesItem::parentWidthChanged()
     for (auto &&series : m_serieses) {
         applyWidthForSeries(series);
     }
+#ifdef GRAPH_OPENGL
+    if (m_batch) {
+        applyWidthForSeries(m_batch);
+    }
+#endif
 }
 
 void SeriesesItem::parentHeightChanged()
@@ -236,6 +255,11 @@ void SeriesesItem::parentHeightChanged()
     for (auto &&series : m_serieses) {
         applyHeightForSeries(series);
     }
+#ifdef GRAPH_OPENGL
+    if (m_batch) {
+        applyHeightForSeries(m_batch);
+    }
+#endif
 }
 
 void SeriesesItem::applyWidthForSeries(QQuickItem *s)
@@ -266,6 +290,19 @@ void SeriesesItem::applyHeightForSeries(QQuickItem *s)
     s->setHeight(height);
 }
 
+#ifdef GRAPH_OPENGL
+PlotFBO *SeriesesItem::batch() const
+{
+    if (m_batch) {
+        return m_batch;
+    }
+    if (auto *parent = dynamic_cast<SeriesesItem *>(parentItem())) {
+        return parent->batch();
+    }
+    return nullptr;
+}
+#endif
+
 QUuid SeriesesItem::groupUuid() const
 {
     return m_groupUuid;
@@ -279,6 +316,11 @@ void SeriesesItem::setGroupUuid(const QUuid &newUuid)
 void SeriesesItem::update()
 {
     QQuickItem::update();
+#ifdef GRAPH_OPENGL
+    if (m_batch) {
+        m_batch->update();
+    }
+#endif
 
     foreach (SeriesItem *series, m_serieses) {
         series->update();
@@ -28,6 +28,9 @@
 namespace Chart {
 
 class Plot;
+#ifdef GRAPH_OPENGL
+class PlotFBO;
+#endif
 
 class SeriesesItem : public QQuickItem
 {
@@ -66,6 +69,12 @@ private:
     void applyWidthForSeries(QQuickItem *s);
     void applyHeightForSeries(QQuickItem *s);
 
+#ifdef GRAPH_OPENGL
+    //! the plot framebuffer of the root item, nullptr when series have their own
+    PlotFBO *batch() const;
+    PlotFBO *m_batch = nullptr;
+#endif
+
     QList<SeriesItem *> m_serieses;
     Plot *m_plot = nullptr;
     bool m_selectAppended = false;
@@ -59,14 +59,37 @@ void AutoSaver::load()
     m_settings->setValue(FILE_KEY, "");
     m_settings->flush();
     QUrl url(file);
-    if (m_sourceList && m_sourceList->load(url)) {
+    if (!m_sourceList) {
+        return;
+    }
+
+    auto connections = std::make_shared<std::pair<QMetaObject::Connection, QMetaObject::Connection>>();
+    connections->first = connect(m_sourceList.get(), &SourceList::loaded, this, [this, connections](QUrl url) {
+        disconnect(connections->first);
+        disconnect(connections->second);
         //restore if we still alive
         m_settings->setValue(FILE_KEY, url);
+    });
+    //failed and cancelled loads don't emit loaded, the url is recorded only for a complete one
+    connections->second = connect(m_sourceList.get(), &SourceList::ioActiveChanged, this, [this, connections]() {
+        if (!m_sourceList->ioActive()) {
+            disconnect(connections->first);
+            disconnect(connections->second);
+        }
+    });
+    if (!m_sourceList->loadAsync(url)) {
+        disconnect(connections->first);
+        disconnect(connections->second);
     }
 }
 
 void AutoSaver::save()
 {
+    //the list is replaced or written by the user right now
+    if (m_sourceList && m_sourceList->ioActive()) {
+        return;
+    }
+
     auto url = fileName();
     if (m_sourceList && m_sourceList->save(url)) {
         m_settings->setValue(FILE_KEY, url);
@@ -0,0 +1,196 @@
+/**
+ *  OSM
+ *  Copyright (C) 2026  Pavel Smokotnin
+
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "trace.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <QJsonArray>
+
+namespace {
+constexpr unsigned int STAGE_SHIFT = 56;
+constexpr std::uint64_t DURATION_MASK = (std::uint64_t(1) << STAGE_SHIFT) - 1;
+}
+
+Trace::Trace() : QObject(nullptr), m_rings(), m_histograms(), m_dropped(0)
+{
+}
+
+Trace *Trace::getInstance()
+{
+    static Trace instance;
+    return &instance;
+}
+
+void Trace::record(Stage stage, Clock::duration duration) noexcept
+{
+    auto nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+    auto value = std::min<std::uint64_t>(std::max<decltype(nanoseconds)>(nanoseconds, 0), DURATION_MASK);
+
+    auto &ring = localRing();
+    auto head = ring.head.load(std::memory_order_relaxed);
+    ring.events[head & Ring::MASK].store((std::uint64_t(stage) << STAGE_SHIFT) | value, std::memory_order_relaxed);
+    ring.head.store(head + 1, std::memory_order_release);
+}
+
+QString Trace::stageName(Stage stage)
+{
+    switch (stage) {
+    case AudioCallback:
+        return "audio callback";
+    case WriteData:
+        return "writeData";
+    case Transform:
+        return "transform";
+    case Averaging:
+        return "averaging";
+    case UnionCalc:
+        return "union calc";
+    case Render:
+        return "render";
+    case RemoteSerialisation:
+        return "remote serialisation";
+    case StagesCount:
+        break;
+    }
+    return {};
+}
+
+QJsonObject Trace::toJSON()
+{
+    std::lock_guard<std::mutex> guard(m_collectMutex);
+    collect();
+
+    auto microseconds = [](std::uint64_t value) {
+        return static_cast<double>(value) / 1000.;
+    };
+
+    QJsonArray stages;
+    for (unsigned int i = 0; i < StagesCount; ++i) {
+        auto &histogram = m_histograms[i];
+        QJsonObject stage;
+        stage["stage"] = stageName(static_cast<Stage>(i));
+        stage["count"] = static_cast<double>(histogram.count);
+        stage["p50"]   = microseconds(histogram.percentile(0.50f));
+        stage["p99"]   = microseconds(histogram.percentile(0.99f));
+        stage["max"]   = microseconds(histogram.max);
+        stages.append(stage);
+    }
+
+    QJsonObject object;
+    object["stages"]  = stages;
+    object["dropped"] = static_cast<double>(m_dropped);
+    return object;
+}
+
+void Trace::reset()
+{
+    std::lock_guard<std::mutex> guard(m_collectMutex);
+    collect();
+    m_histograms = {};
+    m_dropped = 0;
+}
+
+Trace::Ring &Trace::localRing() noexcept
+{
+    thread_local std::shared_ptr<Ring> ring = getInstance()->registerRing();
+    return *ring;
+}
+
+std::shared_ptr<Trace::Ring> Trace::registerRing()
+{
+    auto ring = std::make_shared<Ring>();
+    std::lock_guard<std::mutex> guard(m_ringsMutex);
+    m_rings.push_back(ring);
+    return ring;
+}
+
+void Trace::collect()
+{
+    std::lock_guard<std::mutex> guard(m_ringsMutex);
+    for (auto it = m_rings.begin(); it != m_rings.end();) {
+        auto &ring = **it;
+        auto head = ring.head.load(std::memory_order_acquire);
+        if (head - ring.tail > Ring::SIZE) {
+            m_dropped += head - ring.tail - Ring::SIZE;
+            ring.tail = head - Ring::SIZE;
+        }
+        for (; ring.tail < head; ++ring.tail) {
+            auto event = ring.events[ring.tail & Ring::MASK].load(std::memory_order_relaxed);
+            auto stage = event >> STAGE_SHIFT;
+            if (stage < StagesCount) {
+                m_histograms[stage].add(event & DURATION_MASK);
+            }
+        }
+
+        //the owner thread has finished
+        if (it->use_count() == 1) {
+            it = m_rings.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void Trace::Histogram::add(std::uint64_t value) noexcept
+{
+    ++buckets[bucket(value)];
+    ++count;
+    max = std::max(max, value);
+}
+
+std::uint64_t Trace::Histogram::percentile(float p) const noexcept
+{
+    if (!count) {
+        return 0;
+    }
+    auto target = static_cast<std::uint64_t>(std::ceil(p * count));
+    std::uint64_t sum = 0;
+    for (unsigned int i = 0; i < BUCKETS; ++i) {
+        sum += buckets[i];
+        if (sum >= target) {
+            return std::min(bucketValue(i), max);
+        }
+    }
+    return max;
+}
+
+unsigned int Trace::Histogram::bucket(std::uint64_t value) noexcept
+{
+    if (value < 2 * SUB_BUCKETS) {
+        return value;
+    }
+    unsigned int exponent = 4;
+    while (value >> (exponent + 1)) {
+        ++exponent;
+    }
+    return (exponent - 2) * SUB_BUCKETS + ((value >> (exponent - 3)) & (SUB_BUCKETS - 1));
+}
+
+std::uint64_t Trace::Histogram::bucketValue(unsigned int index) noexcept
+{
+    if (index < 2 * SUB_BUCKETS) {
+        return index;
+    }
+    //the upper bound of the bucket
+    unsigned int exponent = index / SUB_BUCKETS + 2;
+    std::uint64_t mantissa = SUB_BUCKETS + index % SUB_BUCKETS + 1;
+    if (mantissa == 2 * SUB_BUCKETS && exponent == 63) {
+        return std::numeric_limits<std::uint64_t>::max();
+    }
+    return (mantissa << (exponent - 3)) - 1;
+}
@@ -0,0 +1,117 @@
+/**
+ *  OSM
+ *  Copyright (C) 2026  Pavel Smokotnin
+
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <QObject>
+#include <QJsonObject>
+
+//! Always-on timing of the hot path stages.
+//! Every thread writes scoped events to its own lock-free ring, the readers drain the rings
+//! into fixed log-scale histograms on request.
+class Trace : public QObject
+{
+    Q_OBJECT
+
+public:
+    using Clock = std::chrono::steady_clock;
+
+    enum Stage : unsigned int {
+        AudioCallback,
+        WriteData,
+        Transform,
+        Averaging,
+        UnionCalc,
+        Render,
+        RemoteSerialisation,
+        StagesCount
+    };
+    Q_ENUM(Stage)
+
+    class Scope
+    {
+    public:
+        explicit Scope(Stage stage) noexcept : m_stage(stage), m_begin(Clock::now()) {}
+        ~Scope() noexcept
+        {
+            record(m_stage, Clock::now() - m_begin);
+        }
+        Scope(const Scope &) = delete;
+        Scope &operator=(const Scope &) = delete;
+
+    private:
+        Stage m_stage;
+        Clock::time_point m_begin;
+    };
+
+    static Trace *getInstance();
+    static void record(Stage stage, Clock::duration duration) noexcept;
+    static QString stageName(Stage stage);
+
+    //! {stages: [{stage, count, p50, p99, max}], dropped}, times in microseconds
+    Q_INVOKABLE QJsonObject toJSON();
+    Q_INVOKABLE void reset();
+
+private:
+    explicit Trace();
+
+    //! single producer ring: the owner thread writes, collect() reads under m_collectMutex
+    struct Ring {
+        static constexpr std::size_t SIZE = 4096;
+        static constexpr std::size_t MASK = SIZE - 1;
+
+        std::array<std::atomic<std::uint64_t>, SIZE> events;
+        std::atomic<std::uint64_t> head {0};
+        std::uint64_t tail = 0;
+    };
+    static Ring &localRing() noexcept;
+    std::shared_ptr<Ring> registerRing();
+
+    //! 8 buckets per octave of nanoseconds, the error of a percentile is below 12.5%
+    struct Histogram {
+        static constexpr unsigned int SUB_BUCKETS = 8;
+        static constexpr unsigned int BUCKETS = 62 * SUB_BUCKETS;
+
+        std::array<std::uint64_t, BUCKETS> buckets {};
+        std::uint64_t count = 0;
+        std::uint64_t max = 0;
+
+        void add(std::uint64_t value) noexcept;
+        std::uint64_t percentile(float p) const noexcept;
+        static unsigned int bucket(std::uint64_t value) noexcept;
+        static std::uint64_t bucketValue(unsigned int index) noexcept;
+    };
+
+    void collect();
+
+    std::mutex m_ringsMutex;
+    std::vector<std::shared_ptr<Ring>> m_rings;
+
+    std::mutex m_collectMutex;
+    std::array<Histogram, StagesCount> m_histograms;
+    //! events overwritten before they were collected
+    std::uint64_t m_dropped;
+};
+
+#endif // TRACE_H
@@ -0,0 +1,124 @@
+/**
+ *  OSM
+ *  Copyright (C) 2026  Pavel Smokotnin
+
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef CONTAINER_SHAREDVECTOR_H
+#define CONTAINER_SHAREDVECTOR_H
+
+#include <memory>
+#include <vector>
+#include <QtGlobal>
+
+namespace Container {
+
+/**
+ * @brief copy-on-write vector
+ * Copies share one buffer, a non-const access detaches the buffer if it's still shared.
+ * Copy and detach must be synchronized by the owners: the copy is made under the source lock,
+ * writes are made under the owner lock.
+ */
+template<typename T> class SharedVector
+{
+public:
+    SharedVector() : m_data(std::make_shared<std::vector<T>>()) {}
+    //! shares the buffer of an equal vector
+    explicit SharedVector(std::shared_ptr<std::vector<T>> buffer) : m_data(std::move(buffer)) {}
+
+    size_t size() const noexcept
+    {
+        return m_data->size();
+    }
+
+    bool empty() const noexcept
+    {
+        return m_data->empty();
+    }
+
+    //! true if the buffer is used by another copy
+    bool shared() const noexcept
+    {
+        return m_data.use_count() > 1;
+    }
+
+    void resize(size_t size, const T &value = T())
+    {
+        if (size != m_data->size()) {
+            detach();
+            m_data->resize(size, value);
+        }
+    }
+
+    const T &operator[](size_t i) const noexcept
+    {
+        Q_ASSERT(i < m_data->size());
+        return (*m_data)[i];
+    }
+
+    T &operator[](size_t i)
+    {
+        Q_ASSERT(i < m_data->size());
+        detach();
+        return (*m_data)[i];
+    }
+
+    const T *data() const noexcept
+    {
+        return m_data->data();
+    }
+
+    T *data()
+    {
+        detach();
+        return m_data->data();
+    }
+
+    const T *begin() const noexcept
+    {
+        return m_data->data();
+    }
+    const T *end() const noexcept
+    {
+        return m_data->data() + m_data->size();
+    }
+    T *begin()
+    {
+        return data();
+    }
+    T *end()
+    {
+        return data() + m_data->size();
+    }
+
+    //! the buffer, to look for equal vectors
+    const std::shared_ptr<std::vector<T>> &buffer() const noexcept
+    {
+        return m_data;
+    }
+
+private:
+    void detach()
+    {
+        if (m_data.use_count() > 1) {
+            m_data = std::make_shared<std::vector<T>>(*m_data);
+        }
+    }
+
+    std::shared_ptr<std::vector<T>> m_data;
+};
+
+} // namespace Container
+
+#endif // CONTAINER_SHAREDVECTOR_H
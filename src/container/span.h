@@ -0,0 +1,78 @@
+/**
+ *  OSM
+ *  Copyright (C) 2026  Pavel Smokotnin
+
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef CONTAINER_SPAN_H
+#define CONTAINER_SPAN_H
+
+#include <cstddef>
+#include <vector>
+#include <QtGlobal>
+
+namespace Container {
+
+//! non-owning view of contiguous elements
+template<typename T> class span
+{
+public:
+    span() noexcept : m_data(nullptr), m_size(0) {}
+    span(T *data, size_t size) noexcept : m_data(data), m_size(size) {}
+
+    template<typename V>
+    span(V &vector) noexcept : m_data(vector.data()), m_size(vector.size()) {}
+
+    T *data() const noexcept
+    {
+        return m_data;
+    }
+    size_t size() const noexcept
+    {
+        return m_size;
+    }
+    bool empty() const noexcept
+    {
+        return m_size == 0;
+    }
+
+    T &operator[](size_t i) const noexcept
+    {
+        Q_ASSERT(i < m_size);
+        return m_data[i];
+    }
+
+    T *begin() const noexcept
+    {
+        return m_data;
+    }
+    T *end() const noexcept
+    {
+        return m_data + m_size;
+    }
+
+    span subspan(size_t offset, size_t count) const noexcept
+    {
+        Q_ASSERT(offset + count <= m_size);
+        return {m_data + offset, count};
+    }
+
+private:
+    T *m_data;
+    size_t m_size;
+};
+
+} // namespace Container
+
+#endif // CONTAINER_SPAN_H
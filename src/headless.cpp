@@ -0,0 +1,143 @@
+/**
+ *  OSM
+ *  Copyright (C) 2026  Pavel Smokotnin
+
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "headless.h"
+
+#include <atomic>
+#include <csignal>
+#include <cstring>
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QDebug>
+#include <QFileInfo>
+#include <QTimer>
+#include <QUrl>
+#include "common/settings.h"
+#include "common/trace.h"
+#include "audio/client.h"
+#include "audio/plugins/virtual.h"
+#include "generator/generator.h"
+#include "remote/server.h"
+#include "sourcelist.h"
+
+#ifndef APP_GIT_VERSION
+#define APP_GIT_VERSION "unknow"
+#endif
+
+namespace headless {
+
+namespace {
+constexpr const char *HEADLESS_OPTION = "--headless";
+constexpr int QUIT_CHECK_INTERVAL = 250; //ms
+
+std::atomic<bool> s_quitRequested {false};
+
+void onSignal(int)
+{
+    //only lock-free atomics are safe in a signal handler, the event loop polls the flag
+    s_quitRequested = true;
+}
+}
+
+bool requested(int argc, char *argv[])
+{
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], HEADLESS_OPTION) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+int run(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("OpenSoundMeter");
+    QCoreApplication::setApplicationVersion(APP_GIT_VERSION);
+    QCoreApplication::setOrganizationName("opensoundmeter");
+    QCoreApplication::setOrganizationDomain("opensoundmeter.com");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Open Sound Meter headless analysis daemon");
+    parser.addHelpOption();
+    parser.addVersionOption();
+    parser.addPositionalArgument("session", "Session file to load.");
+    parser.addOptions({
+        {"headless", "Run without the user interface."},
+        {"generator", "Start the generator with the saved settings."},
+        {"remote-generator", "Allow remote clients to control the generator."},
+        {"virtual-audio", "Add virtual sound cards described by the JSON file.", "config"},
+    });
+    parser.process(app);
+
+    //must be set before audio::Client is created
+    if (parser.isSet("virtual-audio")) {
+        qputenv(audio::VirtualPlugin::CONFIG_VARIABLE, parser.value("virtual-audio").toLocal8Bit());
+    }
+
+    auto arguments = parser.positionalArguments();
+    if (arguments.size() != 1) {
+        qCritical("headless mode requires a session file");
+        parser.showHelp(1);
+    }
+    QFileInfo session(arguments.first());
+    if (!session.isReadable()) {
+        qCritical() << "can't read session file" << session.filePath();
+        return 1;
+    }
+
+    Settings settings;
+    audio::Client::getInstance();
+    Trace::getInstance();
+    auto generator = std::make_shared<Generator>(settings.getGroup("generator"));
+    auto sourceList = std::make_shared<SourceList>(nullptr, false);
+    if (!sourceList->load(QUrl::fromLocalFile(session.absoluteFilePath()))) {
+        qCritical() << "can't load session file" << session.filePath();
+        return 1;
+    }
+    qInfo() << "session loaded:" << session.filePath() << sourceList->count() << "sources";
+
+    auto server = remote::Server(generator);
+    server.setSourceList(sourceList);
+    server.setGeneratorEnable(parser.isSet("remote-generator"));
+    if (!server.start()) {
+        qCritical("can't start remote server");
+        return 1;
+    }
+
+    if (parser.isSet("generator")) {
+        generator->setEnabled(true);
+    }
+
+    std::signal(SIGINT,  onSignal);
+    std::signal(SIGTERM, onSignal);
+    QTimer quitTimer;
+    quitTimer.setInterval(QUIT_CHECK_INTERVAL);
+    QObject::connect(&quitTimer, &QTimer::timeout, &app, []() {
+        if (s_quitRequested) {
+            QCoreApplication::quit();
+        }
+    });
+    quitTimer.start();
+
+    auto result = QCoreApplication::exec();
+    generator->setEnabled(false);
+    server.stop();
+    return result;
+}
+
+} // namespace headless
@@ -1,6 +1,6 @@
 /**
  *  OSM
- *  Copyright (C) 2021  Pavel Smokotnin
+ *  Copyright (C) 2026  Pavel Smokotnin
 
  *  This program is free software: you can redistribute it and/or modify
  *  it under the terms of the GNU General Public License as published by
@@ -15,26 +15,16 @@
  *  You should have received a copy of the GNU General Public License
  *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
-#ifndef PROFILER_H
-#define PROFILER_H
+#ifndef HEADLESS_H
+#define HEADLESS_H
 
-#include <QString>
-#include <QMap>
-#include <chrono>
+//! Analysis without the QML UI: a session is loaded on QCoreApplication and served by remote::Server.
+//! No scene graph, chart renderers or fonts are created.
+namespace headless {
 
-class Profiler
-{
-    using time_type = std::chrono::time_point<std::chrono::system_clock>;
-    using time_interval = std::chrono::microseconds;
-public:
-    explicit Profiler(QString name, unsigned int divider = 60);
-    ~Profiler();
+bool requested(int argc, char *argv[]);
+int run(int argc, char *argv[]);
 
-private:
-    time_type m_begin;
-    unsigned int m_divider;
-    QString m_name;
-    static QMap<QString, std::pair<int, time_interval>> m_calls;
-};
+} // namespace headless
 
-#endif // PROFILER_H
+#endif // HEADLESS_H
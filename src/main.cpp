@@ -24,6 +24,7 @@
 #include "common/settings.h"
 #include "common/logger.h"
 #include "common/notifier.h"
+#include "common/trace.h"
 #include "src/generator/generator.h"
 #include "src/targettrace.h"
 #include "src/source/union.h"
@@ -43,6 +44,7 @@
 #include "remote/server.h"
 #include "remote/remoteclient.h"
 #include "chart/meterplot.h"
+#include "headless.h"
 
 #ifdef GRAPH_METAL
 #include "src/chart/metal/seriesnode.h"
@@ -55,6 +57,9 @@
 int main(int argc, char *argv[])
 {
     qInstallMessageHandler(logger::messageHandler);
+    if (headless::requested(argc, argv)) {
+        return headless::run(argc, argv);
+    }
 
 #ifdef GRAPH_METAL
     QQuickWindow::setSceneGraphBackend(Chart::SeriesNode::chooseRhi());
@@ -92,6 +97,7 @@ int main(int argc, char *argv[])
     AutoSaver autoSaver(settings.getGroup("autosaver"), sourceList);
     auto t = new TargetTrace(settings.getGroup("targettrace"));
     auto notifier = Notifier::getInstance();
+    auto trace = Trace::getInstance();
 
     auto client = remote::Client(settings.getGroup("apiClient"));
     client.setSourceList(sourceList);
@@ -131,6 +137,7 @@ int main(int argc, char *argv[])
     engine.rootContext()->setContextProperty("generatorModel", generator.get());
     engine.rootContext()->setContextProperty("targetTraceModel", t);
     engine.rootContext()->setContextProperty("notifier", notifier);
+    engine.rootContext()->setContextProperty("trace", trace);
 
     engine.rootContext()->setContextProperty("autoSaver", &autoSaver);
 
@@ -0,0 +1,178 @@
+/**
+ *  OSM
+ *  Copyright (C) 2026  Pavel Smokotnin
+
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <algorithm>
+#include <cmath>
+#include "batchtransform.h"
+
+namespace math {
+
+BatchTransform::BatchTransform() : m_size(0), m_channels(0), m_count(0)
+{
+}
+
+void BatchTransform::transform(const std::vector<FourierTransform *> &batch)
+{
+    clear();
+    for (auto *ft : batch) {
+        add(*ft);
+    }
+    run();
+    for (unsigned int k = 0; k < batch.size(); ++k) {
+        result(k, *batch[k]);
+    }
+}
+
+void BatchTransform::clear()
+{
+    m_count = 0;
+}
+
+unsigned int BatchTransform::add(const FourierTransform &ft)
+{
+    prepare(ft.size());
+    m_input.resize(static_cast<size_t>(m_count + 1) * 2 * m_size);
+    float *inputA = m_input.data() + static_cast<size_t>(m_count) * 2 * m_size;
+    float *inputB = inputA + m_size;
+    float integratedA = 0, integratedB = 0;
+
+    //apply data-window in the bit reversed order, as fast() does
+    for (unsigned int i = 0, n = ft.m_pointer + 1; i < m_size; i++, n++) {
+        if (n >= m_size) n = 0;
+        float a = ft.m_inA[n] * ft.m_window.get(i);
+        float b = ft.m_inB[n] * ft.m_window.get(i);
+        inputA[m_swapMap[i]] = a;
+        inputB[m_swapMap[i]] = b;
+        integratedA += a;
+        integratedB += b;
+    }
+    for (unsigned int i = 0; i < m_size; ++i) {
+        inputA[i] -= integratedA;
+        inputB[i] -= integratedB;
+    }
+    return m_count++;
+}
+
+void BatchTransform::run()
+{
+    if (!m_count) {
+        return;
+    }
+    auto channels = 2 * m_count;
+    channels = (channels + LANES - 1) / LANES * LANES;
+    if (m_channels != channels) {
+        m_channels = channels;
+        m_real.resize(static_cast<size_t>(m_size) * m_channels);
+        m_imag.resize(static_cast<size_t>(m_size) * m_channels);
+    }
+    std::fill(m_real.begin(), m_real.end(), 0.f);
+    std::fill(m_imag.begin(), m_imag.end(), 0.f);
+
+    for (unsigned int k = 0; k < 2 * m_count; ++k) {
+        const float *input = m_input.data() + static_cast<size_t>(k) * m_size;
+        for (unsigned int i = 0; i < m_size; ++i) {
+            m_real[i * m_channels + k] = input[i];
+        }
+    }
+    butterflies();
+}
+
+void BatchTransform::result(unsigned int slot, FourierTransform &ft) const
+{
+    for (unsigned int i = 0; i < m_size; ++i) {
+        ft.m_fastA[i] = {m_real[i * m_channels + 2 * slot    ], m_imag[i * m_channels + 2 * slot    ]};
+        ft.m_fastB[i] = {m_real[i * m_channels + 2 * slot + 1], m_imag[i * m_channels + 2 * slot + 1]};
+    }
+}
+
+void BatchTransform::prepare(unsigned int size)
+{
+    if (m_size == size) {
+        return;
+    }
+    m_size = size;
+    m_count = 0;
+    m_swapMap.resize(m_size);
+    for (unsigned int i = 0; i < m_size; ++i) {
+        m_swapMap[i] = i;
+    }
+    for (unsigned int i = 1, j = 0; i < m_size; ++i) {
+        unsigned int bit = m_size >> 1;
+        for (; j >= bit; bit >>= 1)
+            j -= bit;
+        j += bit;
+        if (i < j) {
+            std::swap(m_swapMap[i], m_swapMap[j]);
+        }
+    }
+
+    m_twiddleReal.resize(m_size / 2);
+    m_twiddleImag.resize(m_size / 2);
+    for (unsigned int j = 0; j < m_size / 2; ++j) {
+        double angle = 2 * M_PI * j / m_size;
+        m_twiddleReal[j] = static_cast<float>(std::cos(angle));
+        m_twiddleImag[j] = static_cast<float>(std::sin(angle));
+    }
+    m_channels = 0;
+}
+
+GNU_ALIGN void BatchTransform::butterflies()
+{
+    const v4sf norm = _mm_set1_ps(1.f / m_size);
+    for (unsigned int len = 2; len <= m_size; len <<= 1) {
+        const unsigned int half = len / 2, step = m_size / len;
+        const bool last = (len == m_size);
+
+        for (unsigned int i = 0; i < m_size; i += len) {
+            for (unsigned int j = 0; j < half; ++j) {
+                const v4sf wr = _mm_set1_ps(m_twiddleReal[j * step]);
+                const v4sf wi = _mm_set1_ps(m_twiddleImag[j * step]);
+                float *uReal = m_real.data() + (i + j) * m_channels;
+                float *uImag = m_imag.data() + (i + j) * m_channels;
+                float *tReal = m_real.data() + (i + j + half) * m_channels;
+                float *tImag = m_imag.data() + (i + j + half) * m_channels;
+
+                for (unsigned int c = 0; c < m_channels; c += LANES) {
+                    v4sf re = _mm_loadu_ps(tReal + c);
+                    v4sf im = _mm_loadu_ps(tImag + c);
+
+                    //v = t * w
+                    v4sf vr = _mm_sub_ps(_mm_mul_ps(re, wr), _mm_mul_ps(im, wi));
+                    v4sf vi = _mm_add_ps(_mm_mul_ps(re, wi), _mm_mul_ps(im, wr));
+
+                    v4sf ur = _mm_loadu_ps(uReal + c);
+                    v4sf ui = _mm_loadu_ps(uImag + c);
+
+                    v4sf sr = _mm_add_ps(ur, vr), si = _mm_add_ps(ui, vi);
+                    v4sf dr = _mm_sub_ps(ur, vr), di = _mm_sub_ps(ui, vi);
+                    if (last) { //final data normalized
+                        sr = _mm_mul_ps(sr, norm);
+                        si = _mm_mul_ps(si, norm);
+                        dr = _mm_mul_ps(dr, norm);
+                        di = _mm_mul_ps(di, norm);
+                    }
+                    _mm_storeu_ps(uReal + c, sr);
+                    _mm_storeu_ps(uImag + c, si);
+                    _mm_storeu_ps(tReal + c, dr);
+                    _mm_storeu_ps(tImag + c, di);
+                }
+            }
+        }
+    }
+}
+
+} // namespace math
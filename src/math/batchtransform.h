@@ -0,0 +1,69 @@
+/**
+ *  OSM
+ *  Copyright (C) 2026  Pavel Smokotnin
+
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef MATH_BATCHTRANSFORM_H
+#define MATH_BATCHTRANSFORM_H
+
+#include <vector>
+#include "fouriertransform.h"
+
+namespace math {
+
+/**
+ * @brief runs the fast transform of several FourierTransform instances of the same size at once
+ *
+ * Channels A and B of every instance are interleaved as lanes: element i of all channels
+ * is stored contiguously, so each butterfly is a SIMD sweep across the instances.
+ * Results are equal to FourierTransform::fast(). Inputs are copied by add() and results
+ * by result(), so an instance isn't touched while run() works.
+ */
+class BatchTransform
+{
+public:
+    static constexpr unsigned int LANES = 4;
+
+    BatchTransform();
+
+    //! all instances must be prepared fast transforms of the same size
+    void transform(const std::vector<FourierTransform *> &batch);
+
+    //! drops the added inputs
+    void clear();
+    //! copies the windowed input of a prepared fast transform of the batch size, returns its slot
+    unsigned int add(const FourierTransform &ft);
+    //! transforms all added inputs
+    void run();
+    //! copies the result of the slot into the transform
+    void result(unsigned int slot, FourierTransform &ft) const;
+
+private:
+    void prepare(unsigned int size);
+    void butterflies();
+
+    unsigned int m_size, m_channels, m_count;
+    std::vector<unsigned int> m_swapMap;
+    //! e^{+i2πj/size}, the sign FourierTransform::fast() uses
+    std::vector<float> m_twiddleReal, m_twiddleImag;
+    //! windowed inputs in the bit reversed order, channels A and B of every slot
+    std::vector<float> m_input;
+    //! size rows of m_channels lanes
+    std::vector<float> m_real, m_imag;
+};
+
+} // namespace math
+
+#endif // MATH_BATCHTRANSFORM_H
@@ -0,0 +1,115 @@
+/**
+ *  OSM
+ *  Copyright (C) 2026  Pavel Smokotnin
+
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <algorithm>
+#include <QtGlobal>
+#include "binmeter.h"
+#if defined(Q_PROCESSOR_X86_64)
+#include "ssemath.h"
+#endif
+#if defined(Q_PROCESSOR_ARM)
+#include "armmath.h"
+#endif
+
+namespace math {
+
+BinMeter::BinMeter() : m_size(0), m_block(0), m_ticks(0), m_closed(0)
+{
+}
+
+void BinMeter::setSize(unsigned int size)
+{
+    m_size = size;
+    m_blockSum.resize(BLOCKS * m_size);
+    m_blockMax.resize(BLOCKS * m_size);
+    m_openSum.resize(m_size);
+    m_openMax.resize(m_size);
+    m_closedSum.resize(m_size);
+    m_closedMax.resize(m_size);
+    reset();
+}
+
+unsigned int BinMeter::size() const noexcept
+{
+    return m_size;
+}
+
+void BinMeter::reset()
+{
+    for (auto *plane : {&m_blockSum, &m_blockMax, &m_openSum, &m_openMax, &m_closedSum, &m_closedMax}) {
+        std::fill(plane->begin(), plane->end(), 0.f);
+    }
+    m_block = 0;
+    m_ticks = 0;
+    m_closed = 0;
+}
+
+GNU_ALIGN void BinMeter::add(const float *squared, float *peak, float *mean)
+{
+    if (m_ticks == BLOCK) {
+        closeBlock();
+    }
+    ++m_ticks;
+
+    const float count = static_cast<float>(m_closed * BLOCK + m_ticks);
+    float *openSum = m_openSum.data(), *openMax = m_openMax.data();
+    const float *closedSum = m_closedSum.data(), *closedMax = m_closedMax.data();
+
+    unsigned int i = 0;
+    const v4sf norm = _mm_set1_ps(1.f / count);
+    for (; i + 4 <= m_size; i += 4) {
+        v4sf value = _mm_loadu_ps(squared + i);
+        v4sf sum = _mm_add_ps(_mm_loadu_ps(openSum + i), value);
+        v4sf max = _mm_max_ps(_mm_loadu_ps(openMax + i), value);
+        _mm_storeu_ps(openSum + i, sum);
+        _mm_storeu_ps(openMax + i, max);
+
+        _mm_storeu_ps(mean + i, _mm_mul_ps(_mm_add_ps(sum, _mm_loadu_ps(closedSum + i)), norm));
+        _mm_storeu_ps(peak + i, _mm_max_ps(max, _mm_loadu_ps(closedMax + i)));
+    }
+    for (; i < m_size; ++i) {
+        openSum[i] += squared[i];
+        openMax[i] = std::max(openMax[i], squared[i]);
+        mean[i] = (openSum[i] + closedSum[i]) / count;
+        peak[i] = std::max(openMax[i], closedMax[i]);
+    }
+}
+
+void BinMeter::closeBlock()
+{
+    std::copy(m_openSum.begin(), m_openSum.end(), m_blockSum.begin() + m_block * m_size);
+    std::copy(m_openMax.begin(), m_openMax.end(), m_blockMax.begin() + m_block * m_size);
+    std::fill(m_openSum.begin(), m_openSum.end(), 0.f);
+    std::fill(m_openMax.begin(), m_openMax.end(), 0.f);
+    m_block = (m_block + 1) % BLOCKS;
+    m_closed = std::min(m_closed + 1, BLOCKS);
+    m_ticks = 0;
+
+    //closed blocks are summed again instead of a running sum: no drift on low levels
+    std::copy(m_blockSum.begin(), m_blockSum.begin() + m_size, m_closedSum.begin());
+    std::copy(m_blockMax.begin(), m_blockMax.begin() + m_size, m_closedMax.begin());
+    for (unsigned int b = 1; b < BLOCKS; ++b) {
+        const float *blockSum = m_blockSum.data() + b * m_size;
+        const float *blockMax = m_blockMax.data() + b * m_size;
+        for (unsigned int i = 0; i < m_size; ++i) {
+            m_closedSum[i] += blockSum[i];
+            m_closedMax[i] = std::max(m_closedMax[i], blockMax[i]);
+        }
+    }
+}
+
+} // namespace math
@@ -0,0 +1,59 @@
+/**
+ *  OSM
+ *  Copyright (C) 2026  Pavel Smokotnin
+
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef MATH_BINMETER_H
+#define MATH_BINMETER_H
+
+#include <vector>
+#include "meter.h"
+
+namespace math {
+
+/**
+ * @brief windowed peak and mean square of every frequency bin
+ *
+ * The history is kept as block planes: each closed block stores the sum and the max of
+ * BLOCK ticks for all bins. The window is the last BLOCKS closed blocks and the open one,
+ * so it slides by blocks and spans from BLOCKS * BLOCK + 1 to Meter::DEFAULT_SIZE ticks.
+ */
+class BinMeter
+{
+public:
+    static constexpr unsigned int BLOCK = 10;
+    static constexpr unsigned int BLOCKS = Meter::DEFAULT_SIZE / BLOCK - 1;
+
+    BinMeter();
+
+    void setSize(unsigned int size);
+    unsigned int size() const noexcept;
+    void reset();
+
+    //! appends one tick of squared bin levels (NaN free), writes peak and mean square of the window
+    void add(const float *squared, float *peak, float *mean);
+
+private:
+    void closeBlock();
+
+    unsigned int m_size, m_block, m_ticks, m_closed;
+    //! BLOCKS planes of m_size bins each
+    std::vector<float> m_blockSum, m_blockMax;
+    std::vector<float> m_openSum, m_openMax, m_closedSum, m_closedMax;
+};
+
+} // namespace math
+
+#endif // MATH_BINMETER_H
@@ -82,16 +82,27 @@ float Coherence::value(unsigned int i) const noexcept
     return Crm.abs() / std::sqrt(Crr * Cmm);
 }
 
-GNU_ALIGN void Coherence::calculate(Abstract::Source::FTData *dst, FourierTransform *src)
+void Coherence::calculate(float *dst, FourierTransform *src)
+{
+    next();
+    calculate(dst, src, 0, m_Grr.size());
+}
+
+void Coherence::next() noexcept
 {
     ++m_subpointer;
     if (m_subpointer >= m_depth)
         m_subpointer = 0;
+}
+
+GNU_ALIGN void Coherence::calculate(float *dst, FourierTransform *src, unsigned int from, unsigned int to)
+{
+    Q_ASSERT(from % 4 == 0 && to <= m_Grr.size());
 
     float Crrmm[4], CrmAbs[4];
     v4sf CrrmmVec, CrmAbsVec;
 
-    for (unsigned int i = 0; i < m_Grr.size() ; i += 4) {
+    for (unsigned int i = from; i < to; i += 4) {
 
         calculateRR(i, src);
         calculateMM(i, src);
@@ -116,10 +127,10 @@ GNU_ALIGN void Coherence::calculate(Abstract::Source::FTData *dst, FourierTransf
         CrmAbsVec = _mm_div_ps(CrmAbsVec, CrrmmVec);
         _mm_store_ps(CrmAbs, CrmAbsVec);
 
-        dst[i    ].coherence = CrmAbs[0];
-        dst[i + 1].coherence = CrmAbs[1];
-        dst[i + 2].coherence = CrmAbs[2];
-        dst[i + 3].coherence = CrmAbs[3];
+        dst[i    ] = CrmAbs[0];
+        dst[i + 1] = CrmAbs[1];
+        dst[i + 2] = CrmAbs[2];
+        dst[i + 3] = CrmAbs[3];
     }
 }
 
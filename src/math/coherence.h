@@ -43,7 +43,12 @@ public:
     [[deprecated]] void append(unsigned int i, const Complex &refernce, const Complex &measurement) noexcept;
     [[deprecated]] float value(unsigned int i) const noexcept;
 
-    void calculate(Abstract::Data::FTData *dst, FourierTransform *src);
+    //! writes coherence of every bin to the dst plane
+    void calculate(float *dst, FourierTransform *src);
+    //! starts the next tick for the ranged calculate()
+    void next() noexcept;
+    //! writes coherence of bins [from, to) to the dst plane, both are multiples of 4
+    void calculate(float *dst, FourierTransform *src, unsigned int from, unsigned int to);
     inline void calculateRR(unsigned int i, FourierTransform *src);
     inline void calculateMM(unsigned int i, FourierTransform *src);
     inline void calculateRM(unsigned int i, FourierTransform *src);
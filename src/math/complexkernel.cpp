@@ -0,0 +1,220 @@
+/**
+ *  OSM
+ *  Copyright (C) 2026  Pavel Smokotnin
+
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <cmath>
+#include <QtGlobal>
+#include "complexkernel.h"
+#if defined(Q_PROCESSOR_X86_64)
+#include "ssemath.h"
+#endif
+#if defined(Q_PROCESSOR_ARM)
+#include "armmath.h"
+#endif
+
+namespace math {
+
+namespace {
+
+struct Planes {
+    v4sf real, imag;
+};
+
+//! four interleaved bins to the real and imaginary planes
+inline Planes load(const Complex *src)
+{
+    const v4sf low = _mm_loadu_ps(&src[0].real), high = _mm_loadu_ps(&src[2].real);
+    return {
+        _mm_shuffle_ps(low, high, _MM_SHUFFLE(2, 0, 2, 0)),
+        _mm_shuffle_ps(low, high, _MM_SHUFFLE(3, 1, 3, 1))
+    };
+}
+
+inline void store(Complex *dst, const v4sf &real, const v4sf &imag)
+{
+    _mm_storeu_ps(&dst[0].real, _mm_unpacklo_ps(real, imag));
+    _mm_storeu_ps(&dst[2].real, _mm_unpackhi_ps(real, imag));
+}
+
+inline v4sf select(const v4sf &mask, const v4sf &yes, const v4sf &no)
+{
+    return _mm_or_ps(_mm_and_ps(mask, yes), _mm_andnot_ps(mask, no));
+}
+
+//! round to nearest for |x| < 2^22 without integer conversion
+inline v4sf nearest(const v4sf &x)
+{
+    const v4sf magic = _mm_set1_ps(12582912.f); // 1.5 * 2^23
+    return _mm_sub_ps(_mm_add_ps(x, magic), magic);
+}
+
+GNU_ALIGN v4sf arctangent(const v4sf &y, const v4sf &x)
+{
+    const v4sf zero = _mm_set1_ps(0.f), sign = _mm_set1_ps(-0.f);
+    const v4sf ax = _mm_andnot_ps(sign, x), ay = _mm_andnot_ps(sign, y);
+    const v4sf low = _mm_min_ps(ax, ay), high = _mm_max_ps(ax, ay);
+
+    //atan of [0, 1], minimax polynomial, 1e-6 rad
+    v4sf a = _mm_and_ps(_mm_div_ps(low, high), _mm_cmpgt_ps(high, zero));
+    const v4sf s = _mm_mul_ps(a, a);
+    v4sf r = _mm_set1_ps(-0.0117212f);
+    r = _mm_add_ps(_mm_mul_ps(r, s), _mm_set1_ps(0.05265332f));
+    r = _mm_add_ps(_mm_mul_ps(r, s), _mm_set1_ps(-0.11643287f));
+    r = _mm_add_ps(_mm_mul_ps(r, s), _mm_set1_ps(0.19354346f));
+    r = _mm_add_ps(_mm_mul_ps(r, s), _mm_set1_ps(-0.33262347f));
+    r = _mm_add_ps(_mm_mul_ps(r, s), _mm_set1_ps(0.99997726f));
+    r = _mm_mul_ps(r, a);
+
+    r = select(_mm_cmpgt_ps(ay, ax), _mm_sub_ps(_mm_set1_ps(M_PI_2), r), r);
+    r = select(_mm_cmplt_ps(x, zero), _mm_sub_ps(_mm_set1_ps(M_PI), r), r);
+    return _mm_xor_ps(r, _mm_and_ps(sign, y));
+}
+
+inline v4sf rotateReal(const Planes &v, const v4sf &c, const v4sf &s)
+{
+    return _mm_sub_ps(_mm_mul_ps(v.real, c), _mm_mul_ps(v.imag, s));
+}
+
+inline v4sf rotateImag(const Planes &v, const v4sf &c, const v4sf &s)
+{
+    return _mm_add_ps(_mm_mul_ps(v.real, s), _mm_mul_ps(v.imag, c));
+}
+
+} // namespace
+
+GNU_ALIGN void ComplexKernel::abs(ConstSpan src, FloatSpan dst)
+{
+    Q_ASSERT(dst.size() >= src.size());
+    size_t i = 0;
+    for (; i + 4 <= src.size(); i += 4) {
+        auto v = load(src.data() + i);
+        _mm_storeu_ps(dst.data() + i, _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(v.real, v.real), _mm_mul_ps(v.imag, v.imag))));
+    }
+    for (; i < src.size(); ++i) {
+        dst[i] = std::sqrt(src[i].absSquared());
+    }
+}
+
+GNU_ALIGN void ComplexKernel::absSquared(ConstSpan src, FloatSpan dst)
+{
+    Q_ASSERT(dst.size() >= src.size());
+    size_t i = 0;
+    for (; i + 4 <= src.size(); i += 4) {
+        auto v = load(src.data() + i);
+        _mm_storeu_ps(dst.data() + i, _mm_add_ps(_mm_mul_ps(v.real, v.real), _mm_mul_ps(v.imag, v.imag)));
+    }
+    for (; i < src.size(); ++i) {
+        dst[i] = src[i].absSquared();
+    }
+}
+
+GNU_ALIGN void ComplexKernel::arg(ConstSpan src, FloatSpan dst)
+{
+    Q_ASSERT(dst.size() >= src.size());
+    size_t i = 0;
+    for (; i + 4 <= src.size(); i += 4) {
+        auto v = load(src.data() + i);
+        _mm_storeu_ps(dst.data() + i, arctangent(v.imag, v.real));
+    }
+    for (; i < src.size(); ++i) {
+        dst[i] = src[i].arg();
+    }
+}
+
+GNU_ALIGN void ComplexKernel::polar(ConstFloatSpan phase, Span dst)
+{
+    Q_ASSERT(dst.size() >= phase.size());
+    size_t i = 0;
+    v4sf s, c;
+    for (; i + 4 <= phase.size(); i += 4) {
+        sincos_ps(_mm_loadu_ps(phase.data() + i), &s, &c);
+        store(dst.data() + i, c, s);
+    }
+    for (; i < phase.size(); ++i) {
+        dst[i].polar(phase[i]);
+    }
+}
+
+GNU_ALIGN void ComplexKernel::normalize(ConstSpan src, Span dst)
+{
+    Q_ASSERT(dst.size() >= src.size());
+    const v4sf one = _mm_set1_ps(1.f), zero = _mm_set1_ps(0.f);
+    size_t i = 0;
+    for (; i + 4 <= src.size(); i += 4) {
+        auto v = load(src.data() + i);
+        const v4sf squared = _mm_add_ps(_mm_mul_ps(v.real, v.real), _mm_mul_ps(v.imag, v.imag));
+        const v4sf norm = _mm_and_ps(_mm_div_ps(one, _mm_sqrt_ps(squared)), _mm_cmpgt_ps(squared, zero));
+        store(dst.data() + i, _mm_mul_ps(v.real, norm), _mm_mul_ps(v.imag, norm));
+    }
+    for (; i < src.size(); ++i) {
+        auto squared = src[i].absSquared();
+        dst[i] = squared > 0 ? src[i] / std::sqrt(squared) : Complex{0, 0};
+    }
+}
+
+GNU_ALIGN void ComplexKernel::rotate(ConstSpan src, ConstFloatSpan angle, Span dst)
+{
+    Q_ASSERT(angle.size() >= src.size() && dst.size() >= src.size());
+    size_t i = 0;
+    v4sf s, c;
+    for (; i + 4 <= src.size(); i += 4) {
+        auto v = load(src.data() + i);
+        sincos_ps(_mm_loadu_ps(angle.data() + i), &s, &c);
+        store(dst.data() + i, rotateReal(v, c, s), rotateImag(v, c, s));
+    }
+    for (; i < src.size(); ++i) {
+        dst[i] = src[i].rotate(angle[i]);
+    }
+}
+
+GNU_ALIGN void ComplexKernel::rotateByDelay(ConstSpan src, ConstFloatSpan frequency, float delay, float phase,
+                                            Span dst)
+{
+    Q_ASSERT(frequency.size() >= src.size() && dst.size() >= src.size());
+    //whole periods are dropped before the angle is formed: long delays keep the precision
+    const v4sf periods = _mm_set1_ps(delay / 1000.f), twoPi = _mm_set1_ps(2 * M_PI), offset = _mm_set1_ps(phase);
+    size_t i = 0;
+    v4sf s, c;
+    for (; i + 4 <= src.size(); i += 4) {
+        auto v = load(src.data() + i);
+        v4sf turns = _mm_mul_ps(_mm_loadu_ps(frequency.data() + i), periods);
+        turns = _mm_sub_ps(turns, nearest(turns));
+        sincos_ps(_mm_sub_ps(offset, _mm_mul_ps(turns, twoPi)), &s, &c);
+        store(dst.data() + i, rotateReal(v, c, s), rotateImag(v, c, s));
+    }
+    for (; i < src.size(); ++i) {
+        auto turns = frequency[i] * delay / 1000.f;
+        turns -= std::round(turns);
+        dst[i] = src[i].rotate(phase - 2 * static_cast<float>(M_PI) * turns);
+    }
+}
+
+GNU_ALIGN void ComplexKernel::multiplyConjugate(ConstSpan a, ConstSpan b, Span dst)
+{
+    Q_ASSERT(b.size() >= a.size() && dst.size() >= a.size());
+    size_t i = 0;
+    for (; i + 4 <= a.size(); i += 4) {
+        auto va = load(a.data() + i), vb = load(b.data() + i);
+        store(dst.data() + i,
+              _mm_add_ps(_mm_mul_ps(va.real, vb.real), _mm_mul_ps(va.imag, vb.imag)),
+              _mm_sub_ps(_mm_mul_ps(va.imag, vb.real), _mm_mul_ps(va.real, vb.imag)));
+    }
+    for (; i < a.size(); ++i) {
+        dst[i] = a[i] * b[i].conjugate();
+    }
+}
+
+} // namespace math
@@ -0,0 +1,64 @@
+/**
+ *  OSM
+ *  Copyright (C) 2026  Pavel Smokotnin
+
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef MATH_COMPLEXKERNEL_H
+#define MATH_COMPLEXKERNEL_H
+
+#include "complex.h"
+#include "container/span.h"
+
+namespace math {
+
+/**
+ * @brief Complex operations over whole planes
+ *
+ * Vector versions of the Complex methods for the per-bin loops. Four bins are processed at once
+ * with SSE or NEON: arg uses a polynomial instead of atan2f, polar and the rotations use sincos_ps() of ssemath.h.
+ * Destination may be the source, destination size must be at least the source size.
+ */
+class ComplexKernel
+{
+public:
+    using ConstSpan = Container::span<const Complex>;
+    using Span = Container::span<Complex>;
+    using ConstFloatSpan = Container::span<const float>;
+    using FloatSpan = Container::span<float>;
+
+    static void abs(ConstSpan src, FloatSpan dst);
+    static void absSquared(ConstSpan src, FloatSpan dst);
+
+    //! argument in [-pi, pi], within 2e-6 rad of atan2f
+    static void arg(ConstSpan src, FloatSpan dst);
+
+    //! unit vectors of the phases
+    static void polar(ConstFloatSpan phase, Span dst);
+
+    //! zero vectors stay zero
+    static void normalize(ConstSpan src, Span dst);
+
+    static void rotate(ConstSpan src, ConstFloatSpan angle, Span dst);
+
+    //! rotates by phase - 2 * pi * frequency * delay, delay in ms
+    static void rotateByDelay(ConstSpan src, ConstFloatSpan frequency, float delay, float phase, Span dst);
+
+    //! a * conjugate(b)
+    static void multiplyConjugate(ConstSpan a, ConstSpan b, Span dst);
+};
+
+} // namespace math
+
+#endif // MATH_COMPLEXKERNEL_H
@@ -0,0 +1,144 @@
+/**
+ *  OSM
+ *  Copyright (C) 2026  Pavel Smokotnin
+
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <algorithm>
+#include <cmath>
+#include <QtMath>
+#include "decimationtree.h"
+
+namespace math {
+
+DecimationTree::DecimationTree() : m_levels(), m_count(0)
+{
+}
+
+const std::array<float, DecimationTree::TAPS> &DecimationTree::coefficients()
+{
+    //blackman windowed sinc, cutoff at the quarter of the input rate
+    static const std::array<float, TAPS> h = []() {
+        std::array<float, TAPS> h;
+        double sum = 0;
+        for (unsigned int i = 0; i < TAPS; ++i) {
+            double n = static_cast<double>(i) - DELAY;
+            double sinc = (n == 0 ? 0.5 : std::sin(M_PI * n / 2) / (M_PI * n));
+            double window = 0.42 - 0.5 * std::cos(2 * M_PI * i / (TAPS - 1)) + 0.08 * std::cos(4 * M_PI * i / (TAPS - 1));
+            h[i] = static_cast<float>(sinc * window);
+            sum += h[i];
+        }
+        for (auto &value : h) {
+            value /= sum;
+        }
+        return h;
+    }();
+    return h;
+}
+
+void DecimationTree::setLevels(unsigned int levels, unsigned int history)
+{
+    m_levels.resize(levels);
+    for (unsigned int l = 0; l < levels; ++l) {
+        unsigned int size = 64;
+        while (size < (history >> (l + 1)) + 2) {
+            size <<= 1;
+        }
+        m_levels[l].a.resize(size);
+        m_levels[l].b.resize(size);
+        m_levels[l].mask = size - 1;
+    }
+    reset();
+}
+
+unsigned int DecimationTree::levels() const noexcept
+{
+    return static_cast<unsigned int>(m_levels.size()) + 1;
+}
+
+void DecimationTree::reset()
+{
+    for (auto &level : m_levels) {
+        level.inA.fill(0.f);
+        level.inB.fill(0.f);
+        level.input = 0;
+        level.odd = false;
+        std::fill(level.a.begin(), level.a.end(), 0.f);
+        std::fill(level.b.begin(), level.b.end(), 0.f);
+        level.write = 0;
+        level.lastOutput = 0;
+    }
+    m_count = 0;
+}
+
+void DecimationTree::add(float a, float b)
+{
+    const auto &h = coefficients();
+    ++m_count;
+
+    for (auto &level : m_levels) {
+        level.inA[level.input] = level.inA[level.input + TAPS] = a;
+        level.inB[level.input] = level.inB[level.input + TAPS] = b;
+        if (++level.input == TAPS) {
+            level.input = 0;
+        }
+
+        level.odd = !level.odd;
+        if (level.odd) {
+            return;
+        }
+
+        //oldest sample first, taps at even distances from the center are zeros
+        const float *inA = level.inA.data() + level.input;
+        const float *inB = level.inB.data() + level.input;
+        a = h[DELAY] * inA[DELAY];
+        b = h[DELAY] * inB[DELAY];
+        for (unsigned int i = 0; i < TAPS; i += 2) {
+            a += h[i] * inA[i];
+            b += h[i] * inB[i];
+        }
+
+        level.write = (level.write + 1) & level.mask;
+        level.a[level.write] = a;
+        level.b[level.write] = b;
+        level.lastOutput = m_count;
+    }
+}
+
+unsigned long DecimationTree::lag(unsigned int level) const noexcept
+{
+    if (level == 0) {
+        return 0;
+    }
+    return (m_count - m_levels[level - 1].lastOutput) + DELAY * ((1ul << level) - 1);
+}
+
+float DecimationTree::a(unsigned int level, unsigned int back) const noexcept
+{
+    const auto &l = m_levels[level - 1];
+    return l.a[(l.write - back) & l.mask];
+}
+
+float DecimationTree::b(unsigned int level, unsigned int back) const noexcept
+{
+    const auto &l = m_levels[level - 1];
+    return l.b[(l.write - back) & l.mask];
+}
+
+unsigned int DecimationTree::capacity(unsigned int level) const noexcept
+{
+    return level == 0 ? 0 : m_levels[level - 1].mask + 1;
+}
+
+} // namespace math
@@ -0,0 +1,76 @@
+/**
+ *  OSM
+ *  Copyright (C) 2026  Pavel Smokotnin
+
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef MATH_DECIMATIONTREE_H
+#define MATH_DECIMATIONTREE_H
+
+#include <array>
+#include <vector>
+
+namespace math {
+
+/**
+ * @brief octave decimation of two channels
+ *
+ * Each level low-passes the previous one with a linear phase half-band FIR and keeps
+ * every second sample, so level L runs at 1/2^L of the input rate. Level 0 is the input
+ * itself and is not stored here.
+ */
+class DecimationTree
+{
+public:
+    static constexpr unsigned int TAPS = 31;
+    //! group delay of one stage in its input samples
+    static constexpr unsigned int DELAY = (TAPS - 1) / 2;
+
+    DecimationTree();
+
+    //! history is the number of input samples each level has to cover
+    void setLevels(unsigned int levels, unsigned int history);
+    unsigned int levels() const noexcept;
+    void reset();
+
+    void add(float a, float b);
+
+    //! input samples between the latest input and the effective time of the latest sample on the level
+    unsigned long lag(unsigned int level) const noexcept;
+
+    //! sample on the level, back = 0 is the latest one
+    float a(unsigned int level, unsigned int back) const noexcept;
+    float b(unsigned int level, unsigned int back) const noexcept;
+    unsigned int capacity(unsigned int level) const noexcept;
+
+private:
+    struct Level {
+        //! filter input, twice longer to read the taps without wrapping
+        std::array<float, 2 * TAPS> inA, inB;
+        unsigned int input = 0;
+        bool odd = false;
+
+        std::vector<float> a, b;
+        unsigned int write = 0, mask = 0;
+        unsigned long lastOutput = 0;
+    };
+    static const std::array<float, TAPS> &coefficients();
+
+    std::vector<Level> m_levels;
+    unsigned long m_count;
+};
+
+} // namespace math
+
+#endif // MATH_DECIMATIONTREE_H
@@ -0,0 +1,161 @@
+/**
+ *  OSM
+ *  Copyright (C) 2026  Pavel Smokotnin
+
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include "delayfinder.h"
+
+namespace math {
+
+DelayFinder::DelayFinder() :
+    m_decimator(),
+    m_coarse(COARSE_SIZE), m_coarseInverse(COARSE_SIZE),
+    m_fine(FINE_SIZE), m_fineInverse(FINE_SIZE),
+    m_data(HISTORY, 0.f), m_reference(HISTORY, 0.f),
+    m_sampleRate(48000), m_write(0), m_counter(0),
+    m_collected(0), m_candidate(0), m_delay(0), m_confidence(0)
+{
+    for (auto *ft : {&m_coarse, &m_coarseInverse, &m_fine, &m_fineInverse}) {
+        ft->prepareFast();
+    }
+    m_coarse.setWindowFunctionType(WindowFunction::Hann);
+    m_fine.setWindowFunctionType(WindowFunction::Hann);
+    m_decimator.setLevels(LEVELS, COARSE_SIZE * DECIMATION);
+    setSampleRate(m_sampleRate);
+}
+
+void DelayFinder::setSampleRate(unsigned int sampleRate)
+{
+    //the half-band filters are relative to the rate, the lag is in samples
+    m_sampleRate = sampleRate;
+    reset();
+}
+
+void DelayFinder::reset()
+{
+    std::fill(m_data.begin(), m_data.end(), 0.f);
+    std::fill(m_reference.begin(), m_reference.end(), 0.f);
+    m_coarse.reset();
+    m_decimator.reset();
+    m_write = 0;
+    m_counter = 0;
+    m_collected = 0;
+}
+
+void DelayFinder::add(float data, float reference)
+{
+    m_write = (m_write + 1) & (HISTORY - 1);
+    m_data[m_write] = data;
+    m_reference[m_write] = reference;
+    ++m_collected;
+    m_decimator.add(data, reference);
+}
+
+bool DelayFinder::step()
+{
+    if (m_collected < COARSE_SIZE * DECIMATION) {
+        return false;
+    }
+
+    switch (++m_counter) {
+    case INTERVAL - 1:
+        if (!coarse()) {
+            m_counter = 0;
+        }
+        return false;
+
+    case INTERVAL:
+        m_counter = 0;
+        return refine();
+    }
+    return false;
+}
+
+long DelayFinder::delay() const noexcept
+{
+    return m_delay;
+}
+
+float DelayFinder::confidence() const noexcept
+{
+    return m_confidence;
+}
+
+bool DelayFinder::coarse()
+{
+    for (unsigned int back = COARSE_SIZE; back-- > 0;) {
+        m_coarse.add(m_decimator.a(LEVELS, back), m_decimator.b(LEVELS, back));
+    }
+    m_coarse.transform();
+    auto [lag, peak] = phat(m_coarse, m_coarseInverse);
+    if (peak <= 0) {
+        return false;
+    }
+    m_candidate = lag * static_cast<long>(DECIMATION);
+    return true;
+}
+
+bool DelayFinder::refine()
+{
+    //the reference window ends m_candidate samples before the data window, both end in the past
+    long dataEnd = m_write - std::max(-m_candidate, 0L);
+    long referenceEnd = m_write - std::max(m_candidate, 0L);
+    unsigned int data = (dataEnd - FINE_SIZE + 1) & (HISTORY - 1);
+    unsigned int reference = (referenceEnd - FINE_SIZE + 1) & (HISTORY - 1);
+    for (unsigned int i = 0; i < FINE_SIZE; ++i) {
+        m_fine.add(m_data[data], m_reference[reference]);
+        data = (data + 1) & (HISTORY - 1);
+        reference = (reference + 1) & (HISTORY - 1);
+    }
+    m_fine.transform();
+
+    auto [residual, peak] = phat(m_fine, m_fineInverse);
+    m_delay = m_candidate + residual;
+    m_confidence = peak;
+    return true;
+}
+
+std::pair<long, float> DelayFinder::phat(const FourierTransform &forward, FourierTransform &inverse) const
+{
+    const unsigned int size = forward.size();
+
+    //dc is dropped: it carries the window offset only
+    inverse.set(0, 0.f, 0.f);
+    for (unsigned int i = 1; i < size; ++i) {
+        auto cross = forward.af(i) * forward.bf(i).conjugate();
+        auto abs = cross.abs();
+        inverse.set(i, abs > std::numeric_limits<float>::min() ? cross / abs : Complex(0.f), 0.f);
+    }
+    inverse.transformSingleChannel();
+
+    long index = 0;
+    float max = 0;
+    for (unsigned int i = 0; i < size; ++i) {
+        auto value = inverse.af(i).real;
+        if (value > max) {
+            max = value;
+            index = i;
+        }
+    }
+    if (index > size / 2) {
+        index -= size;
+    }
+    return {index, max / size};
+}
+
+} // namespace math
@@ -0,0 +1,82 @@
+/**
+ *  OSM
+ *  Copyright (C) 2026  Pavel Smokotnin
+
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef MATH_DELAYFINDER_H
+#define MATH_DELAYFINDER_H
+
+#include <vector>
+#include "decimationtree.h"
+#include "fouriertransform.h"
+
+namespace math {
+
+/**
+ * @brief coarse-to-fine delay estimation between data and reference
+ *
+ * The coarse GCC-PHAT runs on signals decimated by a half-band DecimationTree and covers the same
+ * ±32768 samples as the former 64k deconvolution. Both channels share the decimation delay, so it
+ * doesn't shift the lag. The candidate is refined by a short
+ * full-rate GCC-PHAT with the reference window shifted by the candidate.
+ * Both stages run on separate ticks, so a single tick never pays for the whole estimate.
+ */
+class DelayFinder
+{
+public:
+    static constexpr unsigned int LEVELS = 4;
+    static constexpr unsigned int DECIMATION = 1 << LEVELS;
+    static constexpr unsigned int COARSE_SIZE = 4096;
+    static constexpr unsigned int FINE_SIZE = 2048;
+    static constexpr unsigned int HISTORY = 1 << 17;
+    //! ticks between two estimates
+    static constexpr unsigned int INTERVAL = 25;
+
+    DelayFinder();
+
+    void setSampleRate(unsigned int sampleRate);
+    void reset();
+
+    //! data is late against reference for positive delays
+    void add(float data, float reference);
+
+    //! runs the next stage, returns true when a new estimate is ready
+    bool step();
+
+    long delay() const noexcept;
+    //! normalized PHAT peak of the refined estimate: 0 - no correlation, 1 - pure delay
+    float confidence() const noexcept;
+
+private:
+    bool coarse();
+    bool refine();
+    //! PHAT weighted cross spectrum to the lag domain, returns peak index and normalized height
+    std::pair<long, float> phat(const FourierTransform &forward, FourierTransform &inverse) const;
+
+    //! computes only the kept samples of every octave
+    DecimationTree m_decimator;
+
+    FourierTransform m_coarse, m_coarseInverse, m_fine, m_fineInverse;
+    std::vector<float> m_data, m_reference;
+
+    unsigned int m_sampleRate, m_write, m_counter;
+    unsigned long m_collected;
+    long m_candidate, m_delay;
+    float m_confidence;
+};
+
+} // namespace math
+
+#endif // MATH_DELAYFINDER_H
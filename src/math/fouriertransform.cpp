@@ -16,11 +16,38 @@
  *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include "fouriertransform.h"
+#include <algorithm>
+#include <tuple>
 #include <QtMath>
 #ifndef USE_SSE2
 #define USE_SSE2
 #endif
 
+namespace {
+
+constexpr int LOG_PPO = 24, LOG_OCTAVES = 11;
+constexpr unsigned int LOG_START_WINDOW = 1 << 16;
+
+//! the highest frequency relative to a decimation level rate kept by the multi-rate transform
+constexpr float MULTIRATE_BAND = 0.2f;
+//! the shortest basis on a decimated level
+constexpr unsigned int MULTIRATE_TAPS = 64;
+constexpr unsigned int MULTIRATE_LEVELS = 9;
+
+//! window length and normalized frequency of the log transform bin
+std::pair<unsigned int, float> logBin(unsigned int i, unsigned int sampleRate)
+{
+    static const float wFactor = powf(10.f, 1.f / (-LOG_OCTAVES * LOG_PPO / 2.5));
+    static const float fFactor = powf(1000.f, 1.f / (LOG_PPO * LOG_OCTAVES));
+    unsigned int startOffset = 1'344'000 / sampleRate; // 28 for 48k
+
+    unsigned int N      = LOG_START_WINDOW * pow(wFactor, i);
+    unsigned int offset = startOffset * pow(wFactor * fFactor, i);
+    return {N, static_cast<float>(offset) / (N)};
+}
+
+}
+
 FourierTransform::FourierTransform(unsigned int size):
     m_size(size),
     m_pointer(0),
@@ -71,7 +98,8 @@ std::vector<float> FourierTransform::getFrequencies()
         }
     }
     break;
-    case Log: {
+    case Log:
+    case MultiRate: {
         list.resize(m_logBasis.size());
         for (unsigned int i = 0; i < list.size(); ++i) {
             list[i] = sampleRate() * m_logBasis[i].frequency;
@@ -118,6 +146,14 @@ Complex FourierTransform::bf(unsigned int i) const
 {
     return m_fastB[i];
 }
+const Complex *FourierTransform::afData() const noexcept
+{
+    return m_fastA.pat(0);
+}
+const Complex *FourierTransform::bfData() const noexcept
+{
+    return m_fastB.pat(0);
+}
 
 unsigned int FourierTransform::sampleRate() const
 {
@@ -134,6 +170,7 @@ void FourierTransform::reset()
     for (unsigned int i = 0; i < m_size; ++i) {
         m_inA[i] = m_inB[i] = 0;
     }
+    m_tree.reset();
 }
 
 void FourierTransform::setNorm(Norm newNorm)
@@ -178,6 +215,10 @@ void FourierTransform::add(float sampleA, float sampleB)
 
     m_inA[m_pointer] = sampleA;
     m_inB[m_pointer] = sampleB;
+
+    if (m_type == MultiRate) {
+        m_tree.add(sampleA, sampleB);
+    }
 }
 void FourierTransform::set(unsigned int i, const Complex &a, const Complex &b)
 {
@@ -193,6 +234,9 @@ void FourierTransform::transform(bool ultra)
     case Log:
         log();
         break;
+    case MultiRate:
+        multiRate();
+        break;
     }
 }
 void FourierTransform::reverse()
@@ -464,23 +508,19 @@ GNU_ALIGN void FourierTransform::log()
 GNU_ALIGN void FourierTransform::prepareLog()
 {
     Complex w;
-    const int ppo = 24, octaves = 11;
-    unsigned int startWindow = pow(2, 16), startOffset = 1'344'000 / sampleRate(); // 28 for 48k
-    float wFactor = powf(10.f, 1.f / (-octaves * ppo / 2.5));
-    float fFactor = powf(1000.f, 1.f / (ppo * octaves));
-    unsigned int N, offset;
+    unsigned int N;
     float frequency;
-    m_logBasis.resize(ppo * octaves);
-    m_fastA.resize(ppo * octaves);
-    m_fastB.resize(ppo * octaves);
-    setSize(startWindow);
+    m_logBasis.resize(LOG_PPO * LOG_OCTAVES);
+    m_fastA.resize(LOG_PPO * LOG_OCTAVES);
+    m_fastB.resize(LOG_PPO * LOG_OCTAVES);
+    setSize(LOG_START_WINDOW);
 
     for (unsigned int i = 0; i < m_logBasis.size(); ++i) {
-        N      = startWindow * pow(wFactor, i);
-        offset = startOffset * pow(wFactor * fFactor, i);
-        frequency =  static_cast<float>(offset) / (N);
+        std::tie(N, frequency) = logBin(i, sampleRate());
 
         m_logBasis[i].N = N / m_logWindowDenominator;
+        m_logBasis[i].level = 0;
+        m_logBasis[i].span = m_logBasis[i].N;
         m_logBasis[i].frequency = frequency;
         m_logBasis[i].w.resize(N);
         float gain(0);
@@ -505,5 +545,108 @@ void FourierTransform::prepare()
     case Log:
         prepareLog();
         break;
+    case MultiRate:
+        prepareMultiRate();
+        break;
+    }
+}
+
+void FourierTransform::prepareMultiRate()
+{
+    Complex w;
+    unsigned int N;
+    float frequency;
+    m_logBasis.resize(LOG_PPO * LOG_OCTAVES);
+    m_fastA.resize(LOG_PPO * LOG_OCTAVES);
+    m_fastB.resize(LOG_PPO * LOG_OCTAVES);
+    setSize(LOG_START_WINDOW);
+    m_tree.setLevels(MULTIRATE_LEVELS - 1, 2 * m_size);
+
+    for (unsigned int i = 0; i < m_logBasis.size(); ++i) {
+        std::tie(N, frequency) = logBin(i, sampleRate());
+        auto &basis = m_logBasis[i];
+        basis.span = N / m_logWindowDenominator;
+        basis.frequency = frequency;
+
+        //the lowest rate that still keeps the bin in the band and the basis long enough
+        basis.level = 0;
+        while (basis.level + 1 < MULTIRATE_LEVELS &&
+                frequency * (2u << basis.level) <= MULTIRATE_BAND &&
+                (basis.span >> (basis.level + 1)) >= MULTIRATE_TAPS) {
+            ++basis.level;
+        }
+        const unsigned int step = 1u << basis.level;
+        basis.N = std::max(basis.span / step, 1u);
+        basis.w.resize(basis.N);
+
+        float gain(0);
+        for (unsigned int j = 0; j < basis.N; ++j) {
+            gain += m_window.pointGain(j, basis.N) / basis.N;
+        }
+        //every decimated sample stands for step input samples
+        auto norm = (m_norm == Norm::Sqrt ? basis.span : float(1.f)) / step;
+        for (unsigned int j = 0; j < basis.N; ++j) {
+            w.polar(-2.f * M_PI * std::fmod(static_cast<double>(frequency) * step * j, 1.0));
+            w *= m_window.pointGain(j, basis.N) / (norm * gain);
+            basis.w[j] = _mm_set_ps(w.imag, w.real, w.imag, w.real);
+        }
+    }
+}
+
+float FourierTransform::levelA(unsigned int level, unsigned int back) const noexcept
+{
+    return level ? m_tree.a(level, back) : m_inA[(m_pointer - back) & (m_size - 1)];
+}
+
+float FourierTransform::levelB(unsigned int level, unsigned int back) const noexcept
+{
+    return level ? m_tree.b(level, back) : m_inB[(m_pointer - back) & (m_size - 1)];
+}
+
+GNU_ALIGN void FourierTransform::multiRate()
+{
+    v4sf data, t, m;
+#if defined(_MSC_VER)
+    __declspec(align(16))
+#elif defined(Q_PROCESSOR_ARM)
+    __attribute__((aligned(16)))
+#endif
+    float stored[4];
+    Complex a, b, rotation;
+
+    for (unsigned int i = 0; i < m_logBasis.size(); ++i) {
+        const auto &basis = m_logBasis[i];
+        const long step = 1l << basis.level;
+        const long span = basis.span;
+
+        //window bounds relative to the latest input sample, as log() reads them
+        const long start = (m_align == Center ? -static_cast<long>(m_size / 2) - span / 2 : -span);
+        const long end = start + span - 1;
+        const long latest = -static_cast<long>(m_tree.lag(basis.level));
+
+        //the latest level sample inside the window and the time of the oldest used one
+        const long back = std::max(0l, (latest - end + step - 1) / step);
+        const long first = latest - (back + basis.N - 1) * step;
+
+        data = _mm_set1_ps(0.f);
+        for (unsigned int j = 0, k = back + basis.N - 1; j < basis.N; ++j, --k) {
+            float sampleA = levelA(basis.level, k), sampleB = levelB(basis.level, k);
+            t    = _mm_set_ps(sampleA, sampleA, sampleB, sampleB);
+            m    = _mm_mul_ps(t, basis.w[j]);
+            data = _mm_add_ps(data, m);
+        }
+        _mm_store_ps(stored, data);
+        a = {stored[2], stored[3]};
+        b = {stored[0], stored[1]};
+
+        //phase of the first used sample in the log() basis
+        double phase = static_cast<double>(first - start) + (m_align == Center ? -(span / 2.0) : 0.0);
+        rotation.polar(-2.f * M_PI * std::fmod(basis.frequency * phase, 1.0));
+        a *= rotation;
+        b *= rotation;
+
+        //the same component order log() stores
+        m_fastA[i] = {a.imag, a.real};
+        m_fastB[i] = {b.imag, b.real};
     }
 }
@@ -21,6 +21,7 @@
 #include "complex.h"
 #include "windowfunction.h"
 #include "container/array.h"
+#include "decimationtree.h"
 
 #if defined(Q_PROCESSOR_X86_64)
 #include "ssemath.h"
@@ -29,10 +30,16 @@
 #include "armmath.h"
 #endif
 
+namespace math {
+class BatchTransform;
+}
+
 class FourierTransform
 {
+    friend class math::BatchTransform;
+
 public:
-    enum Type { Fast, Log};
+    enum Type { Fast, Log, MultiRate};
     enum Norm { Sqrt, Lin};
     enum Align { Right, Center};
 
@@ -76,6 +83,9 @@ public:
     //! run log transform
     void log();
 
+    //! run log transform on the octave decimated input
+    void multiRate();
+
     //! prepare transform for current type
     void prepare();
 
@@ -85,6 +95,9 @@ public:
     //! prepare log transform
     void prepareLog();
 
+    //! prepare multi-rate transform: the log transform layout with shorter basis on lower rates
+    void prepareMultiRate();
+
     //! return i in fast transform for given frequency and sampleRate
     long f2i(double frequency, int sampleRate) const;
 
@@ -99,6 +112,9 @@ public:
     Complex af(unsigned int i) const;
     //! return fast transform result for channel B
     Complex bf(unsigned int i) const;
+    //! contiguous results for the vector passes over all bins
+    const Complex *afData() const noexcept;
+    const Complex *bfData() const noexcept;
 
     unsigned int sampleRate() const;
     void setSampleRate(unsigned int sampleRate);
@@ -133,8 +149,16 @@ private:
         unsigned int N;
         float frequency;
         std::vector<v4sf> w;
+        //! decimation level and window length at the input rate, used by the multi-rate transform
+        unsigned int level = 0;
+        unsigned int span = 0;
     };
     Container::array<LogBasisVector> m_logBasis;
+    math::DecimationTree m_tree;
+
+    //! input sample on the decimation level, back = 0 is the latest one
+    float levelA(unsigned int level, unsigned int back) const noexcept;
+    float levelB(unsigned int level, unsigned int back) const noexcept;
 
     //! containers for fast transform
     Container::array<Complex> m_fastA, m_fastB, m_wlen;
@@ -39,6 +39,11 @@ QVariant Leq::availableTimes()
     return typeList;
 }
 
+const std::map<std::size_t, QString> &Leq::times()
+{
+    return m_timeMap;
+}
+
 QString Leq::timeName() const
 {
     return m_timeMap.at(m_integration.size());
@@ -55,6 +60,11 @@ void Leq::setTime(const QString &time)
     }
 }
 
+std::size_t Leq::seconds() const
+{
+    return m_integration.size();
+}
+
 float Leq::value() const
 {
     return 10.f * std::log10(m_integration.value() / m_integration.size());
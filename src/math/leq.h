@@ -32,8 +32,10 @@ public:
     void addOneSecondValue(const float value);
 
     static QVariant availableTimes();
+    static const std::map<std::size_t, QString> &times();
     QString timeName() const;
     void setTime(const QString &time);
+    std::size_t seconds() const;
 
     float value() const;
 
@@ -0,0 +1,122 @@
+/**
+ *  OSM
+ *  Copyright (C) 2026  Pavel Smokotnin
+
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "levelhistory.h"
+#include <algorithm>
+#include <cmath>
+
+namespace math {
+
+LevelHistory::LevelHistory() :
+    m_mutex(), m_frameEnergy(), m_secondEnergy(), m_frameSize(1), m_frameSamples(0), m_secondFrames(0),
+    m_resetRequested(false), m_frames(FRAMES), m_lastIndex(0), m_cumulative(SECONDS + 1), m_seconds(0)
+{
+    reset();
+}
+
+int LevelHistory::curveIndex(Weighting::Curve curve) noexcept
+{
+    auto it = std::find(std::begin(Weighting::allCurves), std::end(Weighting::allCurves), curve);
+    if (it == std::end(Weighting::allCurves)) {
+        return -1;
+    }
+    return static_cast<int>(std::distance(std::begin(Weighting::allCurves), it));
+}
+
+void LevelHistory::setSampleRate(unsigned int sampleRate)
+{
+    auto frameSize = std::max<std::size_t>(1, std::lround(sampleRate * FRAME_INTERVAL));
+    if (frameSize != m_frameSize) {
+        m_frameSize = frameSize;
+        reset();
+    }
+}
+
+void LevelHistory::reset()
+{
+    std::lock_guard<std::mutex> guard(m_mutex);
+    m_resetRequested.store(true);
+    m_lastIndex = 0;
+    m_seconds = 0;
+    m_cumulative[0].fill(0);
+}
+
+void LevelHistory::push(const std::array<float, CURVES> &fast, const std::array<float, CURVES> &slow)
+{
+    std::lock_guard<std::mutex> guard(m_mutex);
+    auto &frame = m_frames[(++m_lastIndex) % FRAMES];
+    frame.index = m_lastIndex;
+    frame.fast = fast;
+    frame.slow = slow;
+    for (std::size_t i = 0; i < CURVES; ++i) {
+        frame.level[i] = 10.f * std::log10(m_frameEnergy[i] / m_frameSamples);
+        m_secondEnergy[i] += m_frameEnergy[i];
+    }
+    m_frameEnergy.fill(0);
+
+    if (++m_secondFrames == FRAMES_PER_SECOND) {
+        auto &previous = m_cumulative[m_seconds % m_cumulative.size()];
+        auto &current  = m_cumulative[(m_seconds + 1) % m_cumulative.size()];
+        for (std::size_t i = 0; i < CURVES; ++i) {
+            current[i] = previous[i] + m_secondEnergy[i] / (m_frameSamples * FRAMES_PER_SECOND);
+        }
+        ++m_seconds;
+        m_secondEnergy.fill(0);
+        m_secondFrames = 0;
+    }
+    m_frameSamples = 0;
+}
+
+std::uint64_t LevelHistory::lastIndex() const
+{
+    std::lock_guard<std::mutex> guard(m_mutex);
+    return m_lastIndex;
+}
+
+std::vector<LevelHistory::Frame> LevelHistory::frames(std::uint64_t after) const
+{
+    std::lock_guard<std::mutex> guard(m_mutex);
+    std::vector<Frame> result;
+    //the history was reset after the last read
+    if (after > m_lastIndex) {
+        after = 0;
+    }
+    auto first = std::max<std::uint64_t>(after + 1, m_lastIndex >= FRAMES ? m_lastIndex - FRAMES + 1 : 1);
+    if (first > m_lastIndex) {
+        return result;
+    }
+    result.reserve(m_lastIndex - first + 1);
+    for (auto index = first; index <= m_lastIndex; ++index) {
+        result.push_back(m_frames[index % FRAMES]);
+    }
+    return result;
+}
+
+float LevelHistory::leq(Weighting::Curve curve, std::size_t seconds) const
+{
+    auto i = curveIndex(curve);
+    std::lock_guard<std::mutex> guard(m_mutex);
+    seconds = std::min<std::size_t>({seconds, static_cast<std::size_t>(m_seconds), SECONDS});
+    if (i < 0 || !seconds) {
+        return NAN;
+    }
+    auto &last  = m_cumulative[m_seconds % m_cumulative.size()];
+    auto &first = m_cumulative[(m_seconds - seconds) % m_cumulative.size()];
+    return 10.f * std::log10((last[i] - first[i]) / seconds);
+}
+
+} // namespace math
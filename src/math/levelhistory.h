@@ -0,0 +1,110 @@
+/**
+ *  OSM
+ *  Copyright (C) 2026  Pavel Smokotnin
+
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef MATH_LEVELHISTORY_H
+#define MATH_LEVELHISTORY_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <iterator>
+#include <mutex>
+#include <vector>
+#include "math/meter.h"
+#include "math/weighting.h"
+
+namespace math {
+
+//! Level log of a source integrated on the audio path.
+//! Samples are summed into frames of a fixed number of samples, so the log doesn't depend on timers or plots.
+//! The writer locks once per frame, readers copy what they need under the same lock.
+//! reset() clears the log at once, the frame accumulators are cleared by the audio thread in applyReset().
+class LevelHistory
+{
+public:
+    static constexpr float FRAME_INTERVAL = 0.1f; //s
+    static constexpr unsigned int FRAMES_PER_SECOND = 10;
+    static constexpr std::size_t FRAMES = 1024;
+    //! the longest Leq time
+    static constexpr std::size_t SECONDS = 120 * 60;
+    static constexpr std::size_t CURVES = std::size(Weighting::allCurves);
+
+    struct Frame {
+        std::uint64_t index = 0;
+        //! meters at the end of the frame, dB
+        std::array<float, CURVES> fast {}, slow {};
+        //! mean square of the frame samples, dB
+        std::array<float, CURVES> level {};
+    };
+
+    LevelHistory();
+
+    static int curveIndex(Weighting::Curve curve) noexcept;
+
+    void setSampleRate(unsigned int sampleRate);
+    //! can be called from any thread
+    void reset();
+
+    //! audio thread: clears the frame accumulators if reset() was requested
+    void applyReset() noexcept
+    {
+        if (m_resetRequested.load(std::memory_order_relaxed) && m_resetRequested.exchange(false)) {
+            m_frameEnergy.fill(0);
+            m_secondEnergy.fill(0);
+            m_frameSamples = 0;
+            m_secondFrames = 0;
+        }
+    }
+    //! audio thread: squared weighted sample of the curve with index curveIndex(curve)
+    void add(std::size_t curve, Meter::data_t squared) noexcept
+    {
+        m_frameEnergy[curve] += squared;
+    }
+    //! audio thread: returns true when the frame is full and must be closed by push()
+    bool sampleAdded() noexcept
+    {
+        return ++m_frameSamples >= m_frameSize;
+    }
+    void push(const std::array<float, CURVES> &fast, const std::array<float, CURVES> &slow);
+
+    //! index of the last closed frame, 0 if there is no frames
+    std::uint64_t lastIndex() const;
+    //! frames with index greater than after, oldest first
+    std::vector<Frame> frames(std::uint64_t after) const;
+    //! energy average of the last seconds, shorter if not enough collected, NAN if empty
+    float leq(Weighting::Curve curve, std::size_t seconds) const;
+
+private:
+    mutable std::mutex m_mutex;
+
+    //! written by the audio thread only
+    std::array<Meter::data_t, CURVES> m_frameEnergy, m_secondEnergy;
+    std::size_t m_frameSize, m_frameSamples;
+    unsigned int m_secondFrames;
+    std::atomic<bool> m_resetRequested;
+
+    std::vector<Frame> m_frames;
+    std::uint64_t m_lastIndex;
+
+    //! running sums of the per second mean squares, Leq of any time is a difference of two sums
+    std::vector<std::array<double, CURVES>> m_cumulative;
+    std::uint64_t m_seconds;
+};
+
+} // namespace math
+
+#endif // MATH_LEVELHISTORY_H
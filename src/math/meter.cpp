@@ -39,7 +39,11 @@ Meter::Meter(Weighting w, Time time) :
 }
 void Meter::add(const data_t &data) noexcept
 {
-    data_t d = std::pow(m_weighting(data), 2);
+    addSquared(std::pow(m_weighting(data), 2));
+}
+
+void Meter::addSquared(data_t d) noexcept
+{
     if (std::isnan(d)) {
         d = 0;
     }
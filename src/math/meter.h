@@ -38,6 +38,8 @@ public:
     static const unsigned long DEFAULT_SIZE = 100;
 
     void  add(const data_t &data) noexcept;
+    //! the sample is already weighted and squared
+    void  addSquared(data_t d) noexcept;
     data_t value() const noexcept;   //! mean squared value
     data_t dB() const noexcept;
     data_t peakSquared() const noexcept;
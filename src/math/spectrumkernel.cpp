@@ -0,0 +1,111 @@
+/**
+ *  OSM
+ *  Copyright (C) 2026  Pavel Smokotnin
+
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <cmath>
+#include <QtGlobal>
+#include "spectrumkernel.h"
+#if defined(Q_PROCESSOR_X86_64)
+#include "ssemath.h"
+#endif
+#if defined(Q_PROCESSOR_ARM)
+#include "armmath.h"
+#endif
+
+namespace math {
+
+SpectrumKernel::SpectrumKernel() : m_size(0)
+{
+}
+
+void SpectrumKernel::setSize(unsigned int size)
+{
+    m_size = size;
+    m_inverseGain.assign(m_size, 1.f);
+    m_rotationReal.assign(m_size, 1.f);
+    m_rotationImag.assign(m_size, 0.f);
+}
+
+unsigned int SpectrumKernel::size() const noexcept
+{
+    return m_size;
+}
+
+void SpectrumKernel::setCalibration(unsigned int i, float gain, float phase)
+{
+    Q_ASSERT(i < m_size);
+    m_inverseGain[i]  = 1.f / gain;
+    m_rotationReal[i] = std::cos(phase);
+    m_rotationImag[i] = -std::sin(phase);
+}
+
+GNU_ALIGN void SpectrumKernel::process(const Complex *a, const Complex *b, unsigned int from, unsigned int count,
+                                       bool calibrate,
+                                       float *magnitude, float *module, Complex *phase, float *squared) const
+{
+    Q_ASSERT(count % 4 == 0);
+    Q_ASSERT(from + count <= m_size);
+
+    const v4sf one = _mm_set1_ps(1.f), zero = _mm_set1_ps(0.f);
+    const v4sf sqrt2 = _mm_set1_ps(M_SQRT2), infinity = _mm_set1_ps(INFINITY);
+    v4sf inverseGain = one, rotationReal = one, rotationImag = zero;
+
+    for (unsigned int i = from; i < from + count; i += 4) {
+        //two loads hold four interleaved bins: split them to real and imaginary planes
+        const v4sf a01 = _mm_loadu_ps(&a[i].real), a23 = _mm_loadu_ps(&a[i + 2].real);
+        const v4sf b01 = _mm_loadu_ps(&b[i].real), b23 = _mm_loadu_ps(&b[i + 2].real);
+        const v4sf ar = _mm_shuffle_ps(a01, a23, _MM_SHUFFLE(2, 0, 2, 0));
+        const v4sf ai = _mm_shuffle_ps(a01, a23, _MM_SHUFFLE(3, 1, 3, 1));
+        const v4sf br = _mm_shuffle_ps(b01, b23, _MM_SHUFFLE(2, 0, 2, 0));
+        const v4sf bi = _mm_shuffle_ps(b01, b23, _MM_SHUFFLE(3, 1, 3, 1));
+
+        if (calibrate) {
+            inverseGain  = _mm_loadu_ps(m_inverseGain.data() + i);
+            rotationReal = _mm_loadu_ps(m_rotationReal.data() + i);
+            rotationImag = _mm_loadu_ps(m_rotationImag.data() + i);
+        }
+
+        const v4sf aa = _mm_add_ps(_mm_mul_ps(ar, ar), _mm_mul_ps(ai, ai));
+        const v4sf bb = _mm_add_ps(_mm_mul_ps(br, br), _mm_mul_ps(bi, bi));
+        const v4sf absA = _mm_mul_ps(_mm_sqrt_ps(aa), inverseGain);
+        const v4sf absB = _mm_sqrt_ps(bb);
+
+        //NaN and inf fail the comparison and are written as zero
+        v4sf m = _mm_div_ps(absA, absB);
+        m = _mm_and_ps(m, _mm_cmplt_ps(m, infinity));
+        _mm_storeu_ps(magnitude + i, m);
+
+        const v4sf calibrated = _mm_mul_ps(absA, sqrt2);
+        _mm_storeu_ps(module + i, calibrated);
+        v4sf s = _mm_mul_ps(calibrated, calibrated);
+        s = _mm_and_ps(s, _mm_cmplt_ps(s, infinity));
+        _mm_storeu_ps(squared + i, s);
+
+        //B * conj(A) rotated by the calibration and normalised
+        const v4sf pr = _mm_add_ps(_mm_mul_ps(br, ar), _mm_mul_ps(bi, ai));
+        const v4sf pi = _mm_sub_ps(_mm_mul_ps(bi, ar), _mm_mul_ps(br, ai));
+        const v4sf norm = _mm_div_ps(one, _mm_sqrt_ps(_mm_mul_ps(aa, bb)));
+        const v4sf valid = _mm_cmplt_ps(norm, infinity);
+        v4sf cr = _mm_sub_ps(_mm_mul_ps(pr, rotationReal), _mm_mul_ps(pi, rotationImag));
+        v4sf ci = _mm_add_ps(_mm_mul_ps(pr, rotationImag), _mm_mul_ps(pi, rotationReal));
+        cr = _mm_and_ps(_mm_mul_ps(cr, norm), valid);
+        ci = _mm_and_ps(_mm_mul_ps(ci, norm), valid);
+        _mm_storeu_ps(&phase[i].real,     _mm_unpacklo_ps(cr, ci));
+        _mm_storeu_ps(&phase[i + 2].real, _mm_unpackhi_ps(cr, ci));
+    }
+}
+
+} // namespace math
@@ -0,0 +1,59 @@
+/**
+ *  OSM
+ *  Copyright (C) 2026  Pavel Smokotnin
+
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef MATH_SPECTRUMKERNEL_H
+#define MATH_SPECTRUMKERNEL_H
+
+#include <vector>
+#include "complex.h"
+
+namespace math {
+
+/**
+ * @brief per-bin transfer values of one transform
+ *
+ * Writes the calibrated module of A, the magnitude A/B, the unit phase vector of B against A
+ * and the squared module for every bin in one vector pass. The calibration is kept as an
+ * inverse gain and a rotation per bin, so the phase needs neither atan2 nor sin/cos.
+ */
+class SpectrumKernel
+{
+public:
+    SpectrumKernel();
+
+    //! resets the calibration to unity
+    void setSize(unsigned int size);
+    unsigned int size() const noexcept;
+
+    //! gain is linear, phase in radians, both are removed from channel A
+    void setCalibration(unsigned int i, float gain, float phase);
+
+    /**
+     * processes bins [from, from + count), count is a multiple of 4
+     * magnitude is 0 and phase is {0, 0} where B or A has no energy
+     */
+    void process(const Complex *a, const Complex *b, unsigned int from, unsigned int count, bool calibrate,
+                 float *magnitude, float *module, Complex *phase, float *squared) const;
+
+private:
+    unsigned int m_size;
+    std::vector<float> m_inverseGain, m_rotationReal, m_rotationImag;
+};
+
+} // namespace math
+
+#endif // MATH_SPECTRUMKERNEL_H
@@ -27,7 +27,8 @@ const std::map<Measurement::Mode, QString>Measurement::m_modeMap = {
     {Measurement::FFT14, "14"},
     {Measurement::FFT15, "15"},
     {Measurement::FFT16, "16"},
-    {Measurement::LFT,   "LTW"}
+    {Measurement::LFT,   "LTW"},
+    {Measurement::CQT,   "CQT"}
 };
 const std::map<Measurement::InputFilter, QString>Measurement::m_inputFilterMap = {
     {Measurement::InputFilter::Z,     "Z"},
@@ -37,6 +38,11 @@ const std::map<Measurement::InputFilter, QString>Measurement::m_inputFilterMap =
     {Measurement::InputFilter::BP100, "BPF 100"},
     {Measurement::InputFilter::LP200, "LPF 200"},
 };
+const std::map<Measurement::Overlap, QString>Measurement::m_overlapMap = {
+    {Measurement::NoOverlap,           "Off"},
+    {Measurement::HalfOverlap,         "50%"},
+    {Measurement::ThreeQuarterOverlap, "75%"},
+};
 const std::map<Measurement::Mode, int>Measurement::m_FFTsizes = {
     {Measurement::FFT10, 10},
     {Measurement::FFT11, 11},
@@ -54,6 +60,7 @@ Measurement::Measurement() : Base(),
     m_average(1),
     m_mode(FFT14),
     m_inputFilter(InputFilter::Z),
+    m_overlap(NoOverlap),
     m_averageType(AverageType::LPF),
     m_filtersFrequency(Filter::Frequency::FourthHz),
     m_windowFunctionType(WindowFunction::Type::Hann)
@@ -62,6 +69,7 @@ Measurement::Measurement() : Base(),
     qRegisterMetaType<Meta::Measurement::Mode>();
     qRegisterMetaType<Meta::Measurement::AverageType>();
     qRegisterMetaType<Meta::Measurement::InputFilter>();
+    qRegisterMetaType<Meta::Measurement::Overlap>();
     qRegisterMetaType<WindowFunction::Type>();
 }
 
@@ -129,6 +137,15 @@ QVariant Measurement::getAvailableInputFilters()
     return typeList;
 }
 
+QVariant Measurement::getAvailableOverlaps()
+{
+    QStringList typeList;
+    for (const auto &type : m_overlapMap) {
+        typeList << type.second;
+    }
+    return typeList;
+}
+
 Measurement::Mode Measurement::mode() const
 {
     return m_mode;
@@ -284,4 +301,24 @@ void Measurement::setInputFilter(QVariant inputFilter)
     setInputFilter(static_cast<InputFilter>(inputFilter.toInt()));
 }
 
+Meta::Measurement::Overlap Measurement::overlap() const
+{
+    return m_overlap;
+}
+
+void Measurement::setOverlap(Overlap overlap)
+{
+    if (m_overlap == overlap) {
+        return;
+    }
+
+    m_overlap = overlap;
+    emit overlapChanged(m_overlap);
+}
+
+void Measurement::setOverlap(QVariant overlap)
+{
+    setOverlap(static_cast<Overlap>(overlap.toInt()));
+}
+
 } // namespace meta
@@ -38,18 +38,23 @@ public:
     enum AverageType {Off, LPF, FIFO};
     Q_ENUM(AverageType)
 
-    enum Mode {FFT10, FFT11, FFT12, FFT13, FFT14, FFT15, FFT16, LFT};
+    enum Mode {FFT10, FFT11, FFT12, FFT13, FFT14, FFT15, FFT16, LFT, CQT};
     Q_ENUM(Mode)
     Q_ENUM(Filter::Frequency)
 
     enum InputFilter {Z, A, C, Notch, BP100, LP200};
     Q_ENUM(InputFilter)
 
+    //! overlap of the FFT windows processed between two ticks
+    enum Overlap {NoOverlap, HalfOverlap, ThreeQuarterOverlap};
+    Q_ENUM(Overlap)
+
     Measurement();
 
     static QVariant getAvailableModes();
     static QVariant getAvailableWindowTypes();
     static QVariant getAvailableInputFilters();
+    static QVariant getAvailableOverlaps();
 
     bool polarity() const;
     void setPolarity(bool polarity);
@@ -93,6 +98,10 @@ public:
     void setInputFilter(Meta::Measurement::InputFilter inputFilter);
     void setInputFilter(QVariant inputFilter);
 
+    Meta::Measurement::Overlap overlap() const;
+    void setOverlap(Meta::Measurement::Overlap overlap);
+    void setOverlap(QVariant overlap);
+
     Q_INVOKABLE virtual void resetAverage() noexcept = 0;
     Q_INVOKABLE virtual void applyAutoGain(const float reference) = 0;
 
@@ -109,9 +118,11 @@ public:
     virtual void filtersFrequencyChanged(Filter::Frequency) = 0;
     virtual void delayChanged(int) = 0;
     virtual void inputFilterChanged(Meta::Measurement::InputFilter) = 0;
+    virtual void overlapChanged(Meta::Measurement::Overlap) = 0;
 
     static const std::map<Mode, QString> m_modeMap;
     static const std::map<InputFilter, QString> m_inputFilterMap;
+    static const std::map<Overlap, QString> m_overlapMap;
     static const std::map<Mode, int> m_FFTsizes;
 
 protected:
@@ -123,6 +134,7 @@ protected:
     std::atomic<unsigned int> m_average;
     Mode m_mode;
     Meta::Measurement::InputFilter m_inputFilter;
+    std::atomic<Overlap> m_overlap;
     AverageType m_averageType;
     Filter::Frequency m_filtersFrequency;
     WindowFunction::Type m_windowFunctionType;
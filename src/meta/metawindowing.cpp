@@ -33,6 +33,7 @@ const std::map<Windowing::Mode, QString>Windowing::m_modeMap = {
     {Windowing::Mode::LTW1,  "LTW1"},
     {Windowing::Mode::LTW2,  "LTW2"},
     {Windowing::Mode::LTW3,  "LTW3"},
+    {Windowing::Mode::CQT,   "CQT"},
 };
 const std::map<Windowing::Mode, int>Windowing::m_FFTsizes = {
     {Windowing::Mode::FFT8,   8},
@@ -47,6 +48,7 @@ const std::map<Windowing::Mode, int>Windowing::m_FFTsizes = {
     {Windowing::Mode::LTW1,  16},
     {Windowing::Mode::LTW2,  16},
     {Windowing::Mode::LTW3,  16},
+    {Windowing::Mode::CQT,   16},
 };
 
 Windowing::Windowing() : m_wide(1), m_offset(0),
@@ -0,0 +1,232 @@
+/**
+ *  OSM
+ *  Copyright (C) 2026  Pavel Smokotnin
+
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "connection.h"
+#include <algorithm>
+#include "tcpreciever.h"
+
+namespace remote {
+
+Connection::Connection(const QString &host, quint16 port, QObject *parent) : QObject(parent),
+    m_host(host), m_port(port), m_socket(nullptr), m_reciever(nullptr), m_requests(),
+    m_persistent(true), m_answered(0), m_clock(), m_lastResponse(0), m_statisticsMutex(), m_statistics()
+{
+    m_clock.start();
+
+    m_socket = new QTcpSocket(this);
+    m_socket->setProxy(QNetworkProxy::NoProxy);
+    m_reciever = new TCPReciever(m_socket);
+    m_reciever->stopTimeout();
+
+    connect(m_socket, &QTcpSocket::connected, this, [this]() {
+        m_socket->setSocketOption(QAbstractSocket::LowDelayOption, 1);
+        m_socket->setSocketOption(QAbstractSocket::KeepAliveOption, 1);
+        writeRequests();
+    });
+    connect(m_socket, &QTcpSocket::disconnected, this, &Connection::onDisconnected);
+    connect(m_socket, &QTcpSocket::errorOccurred, this, &Connection::onError);
+    connect(m_reciever, &TCPReciever::readyRead, this, &Connection::readResponse);
+    connect(m_reciever, &TCPReciever::timeOut, this, &Connection::onTimeOut);
+}
+
+Connection::~Connection()
+{
+    close();
+}
+
+void Connection::send(const QByteArray &data, Network::responseErrorCallbacks callbacks)
+{
+    m_requests.push_back({data, callbacks, 0, false, false});
+
+    if (m_socket->state() == QAbstractSocket::UnconnectedState) {
+        connectToHost();
+    } else {
+        writeRequests();
+    }
+}
+
+void Connection::close()
+{
+    m_socket->disconnect(this);
+    m_reciever->disconnect(this);
+    fail();
+    m_socket->abort();
+}
+
+Network::Statistics Connection::statistics() const
+{
+    std::lock_guard<std::mutex> guard(m_statisticsMutex);
+    return m_statistics;
+}
+
+void Connection::connectToHost()
+{
+    m_answered = 0;
+    m_reciever->reset();
+    m_reciever->restartTimeout();
+    m_socket->connectToHost(m_host, m_port);
+}
+
+void Connection::writeRequests()
+{
+    if (m_socket->state() != QAbstractSocket::ConnectedState) {
+        return;
+    }
+
+    auto written = writtenCount();
+    for (auto &request : m_requests) {
+        if (request.written) {
+            continue;
+        }
+        if (!m_persistent && written) {
+            break;
+        }
+
+        auto header = TCPReciever::makeHeader(request.data);
+        m_socket->write(header.data(), header.size());
+        m_socket->write(request.data);
+
+        request.idle = (written == 0);
+        request.written = true;
+        request.sentAt = m_clock.elapsed();
+        {
+            std::lock_guard<std::mutex> guard(m_statisticsMutex);
+            m_statistics.bytesSent += header.size() + request.data.size();
+            ++m_statistics.requests;
+        }
+        ++written;
+    }
+    m_socket->flush();
+    if (written) {
+        m_reciever->restartTimeout();
+    }
+}
+
+void Connection::readResponse()
+{
+    if (m_reciever->isPush()) {
+        {
+            std::lock_guard<std::mutex> guard(m_statisticsMutex);
+            m_statistics.bytesReceived += m_reciever->data().size() + 4;
+        }
+        emit pushRecieved(qUncompress(m_reciever->data()));
+        return;
+    }
+
+    if (m_requests.empty() || !m_requests.front().written) {
+        qWarning() << "unexpected response from" << m_host << m_port;
+        return;
+    }
+
+    auto request = std::move(m_requests.front());
+    m_requests.pop_front();
+    ++m_answered;
+
+    auto now = m_clock.elapsed();
+    auto size = m_reciever->data().size();
+    auto transferTime = std::max<qint64>(now - std::max(request.sentAt, m_lastResponse), 1);
+    constexpr float alpha = 0.125f;
+
+    m_lastResponse = now;
+    {
+        std::lock_guard<std::mutex> guard(m_statisticsMutex);
+        m_statistics.bytesReceived += size + 4;
+        m_statistics.bandwidth += alpha * (1000.f * size / transferTime - m_statistics.bandwidth);
+        m_statistics.responseSize += alpha * (size - m_statistics.responseSize);
+        if (request.idle) {
+            m_statistics.latency += alpha * (now - request.sentAt - m_statistics.latency);
+        }
+    }
+
+    if (!writtenCount()) {
+        m_reciever->stopTimeout();
+    }
+
+    auto callback = std::get<1>(request.callbacks);
+    callback(qUncompress(m_reciever->data()));
+
+    writeRequests();
+}
+
+void Connection::onDisconnected()
+{
+    m_reciever->reset();
+    emit lost();
+    auto written = writtenCount();
+
+    if (written && m_persistent && m_answered == 1) {
+        qInfo() << m_host << "doesn't support persistent connections, requests will be sent one by one";
+        m_persistent = false;
+        for (auto &request : m_requests) {
+            request.written = false;
+        }
+        written = 0;
+    }
+
+    if (written) {
+        fail();
+    } else if (!m_requests.empty()) {
+        connectToHost();
+    } else {
+        m_reciever->stopTimeout();
+    }
+}
+
+void Connection::onError(QAbstractSocket::SocketError socketError)
+{
+    if (socketError == QAbstractSocket::RemoteHostClosedError) {
+        return;
+    }
+    qDebug() << m_host << m_port << socketError;
+    emit lost();
+    fail();
+    m_socket->abort();
+}
+
+void Connection::onTimeOut()
+{
+    qInfo() << "Can't connect to the device" << m_host << m_port << ". timeout expired.";
+    emit lost();
+    fail();
+    m_socket->abort();
+}
+
+void Connection::fail()
+{
+    m_reciever->stopTimeout();
+    m_reciever->reset();
+
+    auto requests = std::move(m_requests);
+    m_requests.clear();
+    {
+        std::lock_guard<std::mutex> guard(m_statisticsMutex);
+        m_statistics.errors += requests.size();
+    }
+    for (auto &request : requests) {
+        auto onError = std::get<2>(request.callbacks);
+        onError();
+    }
+}
+
+unsigned int Connection::writtenCount() const noexcept
+{
+    return std::count_if(m_requests.cbegin(), m_requests.cend(), [](auto & request) {
+        return request.written;
+    });
+}
+
+} // namespace remote
@@ -0,0 +1,92 @@
+/**
+ *  OSM
+ *  Copyright (C) 2026  Pavel Smokotnin
+
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef REMOTE_CONNECTION_H
+#define REMOTE_CONNECTION_H
+
+#include <deque>
+#include <mutex>
+#include <QObject>
+#include <QTcpSocket>
+#include <QElapsedTimer>
+#include "network.h"
+
+namespace remote {
+
+class TCPReciever;
+
+//! Persistent client connection to one server.
+//! Requests are pipelined: written as soon as the socket is connected, answers come back in the same order.
+//! Messages pushed by the server for subscriptions are passed through pushRecieved.
+class Connection : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit Connection(const QString &host, quint16 port, QObject *parent = nullptr);
+    ~Connection();
+
+    void send(const QByteArray &data, Network::responseErrorCallbacks callbacks);
+    void close();
+
+    //! can be called from any thread
+    Network::Statistics statistics() const;
+
+signals:
+    void pushRecieved(const QByteArray &);
+    //! the server closed the connection or it failed, server side subscriptions are dropped
+    void lost();
+
+private slots:
+    void writeRequests();
+    void readResponse();
+    void onDisconnected();
+    void onError(QAbstractSocket::SocketError socketError);
+    void onTimeOut();
+
+private:
+    struct Request {
+        QByteArray data;
+        Network::responseErrorCallbacks callbacks;
+        qint64 sentAt;
+        bool written;
+        bool idle;
+    };
+
+    void connectToHost();
+    void fail();
+    unsigned int writtenCount() const noexcept;
+
+    QString m_host;
+    quint16 m_port;
+    QTcpSocket *m_socket;
+    TCPReciever *m_reciever;
+    std::deque<Request> m_requests;
+
+    //! servers before pipelining answer one request per connection and then disconnect
+    bool m_persistent;
+    unsigned int m_answered;
+
+    QElapsedTimer m_clock;
+    qint64 m_lastResponse;
+    mutable std::mutex m_statisticsMutex;
+    Network::Statistics m_statistics;
+};
+
+} // namespace remote
+
+#endif // REMOTE_CONNECTION_H
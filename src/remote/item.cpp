@@ -155,35 +155,58 @@ void Item::setOriginalActive(bool originalActive)
     m_originalActive = originalActive;
 }
 
-void Item::applyData(const QJsonArray &data, const QJsonArray &timeData)
+void Item::applyData(const QJsonArray &data, const QJsonArray &timeData, int fields)
 {
     {
         std::lock_guard guard(m_dataMutex);
 
-        if (frequencyDomainSize() != static_cast<unsigned int>(data.count())) {
-            setFrequencyDomainSize(static_cast<unsigned int>(data.count()));
+        if (fields & ~Network::IMPULSE) {
+            if (frequencyDomainSize() != static_cast<unsigned int>(data.count())) {
+                setFrequencyDomainSize(static_cast<unsigned int>(data.count()));
+            }
+
+            int frequency = -1, module = -1, magnitude = -1, phase = -1, coherence = -1, column = 0;
+            if (fields & Network::FREQUENCY) frequency = column++;
+            if (fields & Network::MODULE)    module    = column++;
+            if (fields & Network::MAGNITUDE) magnitude = column++;
+            if (fields & Network::PHASE)     phase     = column++;
+            if (fields & Network::COHERENCE) coherence = column++;
+
+            for (int i = 0; i < data.count(); i++) {
+                auto row = data[i].toArray();
+                auto count = row.count();
+                if (frequency != -1 && count > frequency)
+                    m_frequency[i]    = static_cast<float>(row[frequency].toDouble());
+                if (module    != -1 && count > module   )
+                    m_module[i]       = static_cast<float>(row[module   ].toDouble());
+                if (magnitude != -1 && count > magnitude)
+                    m_magnitude[i]    = static_cast<float>(row[magnitude].toDouble());
+                if (phase     != -1 && count > phase    )
+                    m_phase[i].polar(   static_cast<float>(row[phase    ].toDouble()));
+                if (coherence != -1 && count > coherence)
+                    m_coherence[i]    = static_cast<float>(row[coherence].toDouble());
+                if (fields == Network::ALL_FIELDS) {
+                    if (count > 5) m_peakSquared[i]  = static_cast<float>(row[5].toDouble());
+                    if (count > 6) m_meanSquared[i]  = static_cast<float>(row[6].toDouble());
+                }
+            }
         }
 
-        for (int i = 0; i < data.count(); i++) {
-            auto row = data[i].toArray();
-            if (row.count() > 0) m_ftdata[i].frequency    = static_cast<float>(row[0].toDouble());
-            if (row.count() > 1) m_ftdata[i].module       = static_cast<float>(row[1].toDouble());
-            if (row.count() > 2) m_ftdata[i].magnitude    = static_cast<float>(row[2].toDouble());
-            if (row.count() > 3) m_ftdata[i].phase.polar(   static_cast<float>(row[3].toDouble()));
-            if (row.count() > 4) m_ftdata[i].coherence    = static_cast<float>(row[4].toDouble());
-            if (row.count() > 5) m_ftdata[i].peakSquared  = static_cast<float>(row[5].toDouble());
-            if (row.count() > 6) m_ftdata[i].meanSquared  = static_cast<float>(row[6].toDouble());
-        }
-
-        if (timeDomainSize() != static_cast<unsigned int>(timeData.count())) {
-            setTimeDomainSize(static_cast<unsigned int>(timeData.count()));
-        }
-
-        for (int i = 0; i < timeData.count(); i++) {
-            auto row = timeData[i].toArray();
-            if (row.count() > 0) m_impulseData[i].time   = static_cast<float>(row[0].toDouble());
-            if (row.count() > 1) m_impulseData[i].value  = static_cast<float>(row[1].toDouble());
-
+        if (fields & Network::IMPULSE) {
+            if (timeDomainSize() != static_cast<unsigned int>(timeData.count())) {
+                setTimeDomainSize(static_cast<unsigned int>(timeData.count()));
+            }
+
+            for (int i = 0; i < timeData.count(); i++) {
+                auto row = timeData[i].toArray();
+                if (row.count() > 1) m_impulse[i] = static_cast<float>(row[1].toDouble());
+            }
+            if (timeData.count() > 1) {
+                auto timeAt = [&timeData](int i) {
+                    return static_cast<float>(timeData[i].toArray()[0].toDouble());
+                };
+                setImpulseTimeAxis(timeAt(0), (timeAt(timeData.count() - 1) - timeAt(0)) / (timeData.count() - 1));
+            }
         }
     }
     emit readyRead();
@@ -271,13 +294,13 @@ void Item::dataError(const uint hash, const bool deactivate)
 
 }
 
-void Item::dataReceived(const uint hash, QJsonArray data, QJsonArray timeData)
+void Item::dataReceived(const uint hash, QJsonArray data, QJsonArray timeData, int fields)
 {
     if (hash != qHash(sourceId())) {
         return;
     }
 
-    applyData(data, timeData);
+    applyData(data, timeData, fields);
 }
 
 } // namespace remote
@@ -19,6 +19,7 @@
 #define REMOTE_ITEM_H
 
 #include "abstract/source.h"
+#include "network.h"
 #include <QTimer>
 #include <QJsonArray>
 
@@ -60,7 +61,8 @@ public:
     bool originalActive() const;
     void setOriginalActive(bool originalActive);
 
-    void applyData(const QJsonArray &data, const QJsonArray &timeData);
+    //! fields is a mask of Network::DataField, rows of data contain only the masked values
+    void applyData(const QJsonArray &data, const QJsonArray &timeData, int fields = Network::ALL_FIELDS);
 
     State state() const;
     void setState(const State &state);
@@ -73,7 +75,7 @@ public:
 public slots:
     Q_INVOKABLE void refresh();
     void dataError(const uint hash, const bool deactivate);
-    void dataReceived(const uint hash, QJsonArray data, QJsonArray timeData);
+    void dataReceived(const uint hash, QJsonArray data, QJsonArray timeData, int fields);
 
 signals:
     void stateChanged();
@@ -46,11 +46,13 @@ class MeasurementItem : public remote::Item, public Meta::Measurement
     Q_PROPERTY(QVariant modes READ getAvailableModes CONSTANT)
     Q_PROPERTY(QVariant inputFilters READ getAvailableInputFilters CONSTANT)
     Q_PROPERTY(QVariant windows READ getAvailableWindowTypes CONSTANT)
+    Q_PROPERTY(QVariant overlaps READ getAvailableOverlaps CONSTANT)
 
     Q_PROPERTY(int estimated READ estimated WRITE setEstimated NOTIFY estimatedChanged)
     Q_PROPERTY(int estimatedDelta READ estimatedDelta WRITE setEstimatedDelta NOTIFY estimatedChanged)
 
     Q_PROPERTY(Meta::Measurement::InputFilter inputFilter READ inputFilter WRITE setInputFilter NOTIFY inputFilterChanged)
+    Q_PROPERTY(Meta::Measurement::Overlap overlap READ overlap WRITE setOverlap NOTIFY overlapChanged)
 
 public:
     MeasurementItem(QObject *parent = nullptr);
@@ -78,6 +80,7 @@ signals:
     void filtersFrequencyChanged(Filter::Frequency) override;
     void delayChanged(int) override;
     void inputFilterChanged(Meta::Measurement::InputFilter) override;
+    void overlapChanged(Meta::Measurement::Overlap) override;
 
     void estimatedChanged();
 
@@ -19,6 +19,7 @@
 #include <qsysinfo.h>
 #include <QVector>
 #include "tcpreciever.h"
+#include "connection.h"
 
 namespace remote {
 
@@ -32,12 +33,14 @@ Network::Network(QObject *parent) : QObject(parent), m_udpSocket(nullptr), m_tcp
     connect(m_udpSocket, &QUdpSocket::readyRead, this, &Network::readUDP);
     qRegisterMetaType<QHostAddress>("QHostAddress");
     qRegisterMetaType<remote::Network::responseErrorCallbacks>("remote::Network::responseErrorCallbacks");
+    qRegisterMetaType<remote::Network::ConnectionId>("remote::Network::ConnectionId");
 }
 
 Network::~Network()
 {
     unbindUDP();
     stopTCPServer();
+    closeConnections();
 }
 
 void Network::setTcpCallback(Network::tcpCallback callback) noexcept
@@ -111,103 +114,109 @@ void Network::newTCPConnection()
     clientConnection->setSocketOption(QAbstractSocket::LowDelayOption, 1);
     clientConnection->setSocketOption(QAbstractSocket::KeepAliveOption, 1);
     auto reciever = new TCPReciever(clientConnection);
+    auto connectionId = reinterpret_cast<ConnectionId>(clientConnection);
+    m_clients[connectionId] = clientConnection;
 
     connect(reciever, &TCPReciever::readyRead, this, [ = ]() {
         if (!clientConnection->isWritable()) {
             return;
         }
         if (m_tcpCallback) {
-            auto answer = qCompress(m_tcpCallback(std::move(clientConnection->peerAddress()), std::move(reciever->data())));
-            auto header = TCPReciever::makeHeader(answer);
-            clientConnection->write(header.data(), header.size());
-
-            auto data_ptr = answer.data_ptr()->data();
-            int sent = 0, len;
-            while (sent < answer.size() && clientConnection->isWritable()) {
-                len = std::min(answer.size() - sent, 32767);
-                clientConnection->write(data_ptr + sent, len);
-                sent += len;
-            }
-            clientConnection->flush();
+            auto answer = qCompress(m_tcpCallback(std::move(clientConnection->peerAddress()), std::move(reciever->data()),
+                                                  connectionId));
+            writeMessage(clientConnection, answer);
         }
-        clientConnection->disconnectFromHost();
+        //! keep the connection open: the client pipelines the next requests into it
+        reciever->restartTimeout();
     });
 
     connect(reciever, &TCPReciever::timeOut, this, [ = ]() {
-        if (clientConnection) {
+        //! subscribed clients may not send anything for a long time
+        if (clientConnection && !m_pushClients.contains(connectionId)) {
             clientConnection->close();
         }
     });
 
+    connect(clientConnection, &QTcpSocket::bytesWritten, this, [ = ]() {
+        if (clientConnection->bytesToWrite() == 0 && m_pushClients.contains(connectionId)) {
+            emit clientReady(connectionId);
+        }
+    });
+
     connect(clientConnection, &QTcpSocket::disconnected, this, [ = ]() {
+        m_clients.remove(connectionId);
+        if (m_pushClients.remove(connectionId)) {
+            emit clientDisconnected(connectionId);
+        }
         reciever->deleteLater();
         clientConnection->deleteLater();
     });
 }
 
+void Network::push(ConnectionId connection, const QByteArray &data)
+{
+    auto socket = m_clients.value(connection, nullptr);
+    if (!socket || !socket->isWritable()) {
+        emit clientDisconnected(connection);
+        return;
+    }
+    m_pushClients.insert(connection);
+    writeMessage(socket, qCompress(data), true);
+}
+
+void Network::writeMessage(QTcpSocket *socket, const QByteArray &message, bool push)
+{
+    auto header = TCPReciever::makeHeader(message, push);
+    socket->write(header.data(), header.size());
+
+    auto data_ptr = message.data();
+    int sent = 0, len;
+    while (sent < message.size() && socket->isWritable()) {
+        len = std::min(message.size() - sent, 32767);
+        socket->write(data_ptr + sent, len);
+        sent += len;
+    }
+    socket->flush();
+}
+
 void Network::sendTCP(const QByteArray &data, const QString host, quint16 port,
                       responseErrorCallbacks callbacks)
 {
-    auto context = std::get<0>(callbacks);
-    auto callback = std::get<1>(callbacks);
-    auto onError = std::get<2>(callbacks);
-
-    auto *socketThread = new QThread();
-    QTcpSocket *socket = new QTcpSocket();
-
-    socket->moveToThread(socketThread);
-    socket->setProxy(QNetworkProxy::NoProxy);
-    socket->setSocketOption(QAbstractSocket::LowDelayOption, 1);
-    socket->setSocketOption(QAbstractSocket::KeepAliveOption, 1);
-
-    connect(socketThread, &QThread::started, socketThread, [ = ]() {
-        auto reciever =  new TCPReciever(socket);
-
-        connect(reciever, &TCPReciever::readyRead, context.get(), [ = ]() {
-            callback(qUncompress(reciever->data()));
-            if (socket) {
-                socket->disconnectFromHost();
-            }
-        }, Qt::DirectConnection);
-
-        connect(reciever, &TCPReciever::timeOut, context.get(), [ = ]() {
-            qInfo() << "Can't connect to the device" << host << port << ". timeout expired.";
-            if (socket) {
-                socket->abort();
-            }
-            onError();
-        }, Qt::DirectConnection);
-
-        connect(socket, &QTcpSocket::disconnected, this, [ = ]() {
-            if (context) {
-                reciever->disconnect(context.get());
-            }
-            socketThread->exit();
+    auto key = host + ":" + QString::number(port);
+    auto connection = m_connections.value(key, nullptr);
+    if (!connection) {
+        connection = new Connection(host, port, this);
+        connect(connection, &Connection::pushRecieved, this, &Network::pushRecieved);
+        connect(connection, &Connection::lost, this, [this, host, port]() {
+            emit connectionLost(host, port);
         });
+        std::lock_guard<std::mutex> guard(m_connectionsMutex);
+        m_connections[key] = connection;
+    }
+    connection->send(data, callbacks);
+}
 
-        socket->connectToHost(host, port);
-
-    }, Qt::DirectConnection);
-
-    auto header = TCPReciever::makeHeader(data);
-    connect(socket, &QTcpSocket::connected, socketThread, [ = ]() {
-        socket->write(header.data(), header.size());
-        socket->write(data);
-        socket->flush();
-    }, Qt::DirectConnection);
-
-    connect(socket, &QTcpSocket::errorOccurred, this, [ = ]([[maybe_unused]] auto socketError) {
-        qDebug() << socketError;
-        onError();
-        socket->close();
-    });
-
-    connect(socketThread, &QThread::finished, this, [ = ]() {
-        delete socket; //its QThread has finished
-        socketThread->deleteLater();
-    }, Qt::DirectConnection);
+void Network::closeConnections()
+{
+    decltype(m_connections) connections;
+    {
+        std::lock_guard<std::mutex> guard(m_connectionsMutex);
+        connections.swap(m_connections);
+    }
+    for (auto &connection : connections) {
+        connection->close();
+        delete connection;
+    }
+}
 
-    socketThread->start();
+Network::Statistics Network::statistics(const QString &host, quint16 port) const
+{
+    std::lock_guard<std::mutex> guard(m_connectionsMutex);
+    auto connection = m_connections.value(host + ":" + QString::number(port), nullptr);
+    if (!connection) {
+        return {};
+    }
+    return connection->statistics();
 }
 
 } // namespace remote
@@ -18,6 +18,7 @@
 #ifndef REMOTE_NETWORK_H
 #define REMOTE_NETWORK_H
 
+#include <mutex>
 #include <QObject>
 #include <QtNetwork>
 
@@ -26,6 +27,7 @@
 namespace remote {
 
 class TCPReciever;
+class Connection;
 
 class Network : public QObject
 {
@@ -41,9 +43,31 @@ public:
     typedef const std::function<void(const QByteArray &)> responseCallback;
     typedef const std::function<void()> errorCallback;
     typedef std::function<TCPReciever*(void)> createTCPReciver;
-    typedef std::function < QByteArray (const QHostAddress &&, const QByteArray &&) > tcpCallback;
+    typedef quintptr ConnectionId;
+    typedef std::function < QByteArray (const QHostAddress &&, const QByteArray &&, ConnectionId) > tcpCallback;
     typedef std::tuple<const std::shared_ptr<QObject>, responseCallback, errorCallback> responseErrorCallbacks;
 
+    //! fields of the source data, a subscription can request only some of them
+    enum DataField {
+        FREQUENCY   = 0x01,
+        MODULE      = 0x02,
+        MAGNITUDE   = 0x04,
+        PHASE       = 0x08,
+        COHERENCE   = 0x10,
+        IMPULSE     = 0x20,
+        ALL_FIELDS  = 0x3F
+    };
+
+    struct Statistics {
+        unsigned int requests   = 0;
+        unsigned int errors     = 0;
+        qint64 bytesSent        = 0;
+        qint64 bytesReceived    = 0;
+        float latency           = 0;    //!< ms, round trip of a request sent over an idle connection
+        float bandwidth         = 0;    //!< bytes per second
+        float responseSize      = 0;    //!< bytes, average compressed response
+    };
+
     constexpr quint16 port() const noexcept
     {
         return DEFAULT_PORT;
@@ -51,6 +75,9 @@ public:
     void setTcpCallback(tcpCallback callback) noexcept;
     void setTcpReciever(createTCPReciver reciverCreator) noexcept;
 
+    //! can be called from any thread
+    Statistics statistics(const QString &host, quint16 port) const;
+
 public slots:
     bool startTCPServer();
     void stopTCPServer();
@@ -62,19 +89,33 @@ public slots:
     bool sendUDP(const QByteArray &data, const QString &host = QString(), quint16 port = DEFAULT_PORT) const noexcept;
     void sendTCP(const QByteArray &data, const QString host, quint16 port,
                  remote::Network::responseErrorCallbacks callbacks) ;
+    void closeConnections();
+    void push(remote::Network::ConnectionId connection, const QByteArray &data);
 
     void readUDP() noexcept;
 
 signals:
     void datagramRecieved(QHostAddress senderAddress, int senderPort, const QByteArray &);
+    void pushRecieved(const QByteArray &);
+    void connectionLost(QString host, quint16 port);
+
+    void clientReady(remote::Network::ConnectionId connection);
+    void clientDisconnected(remote::Network::ConnectionId connection);
 
 protected slots:
     void newTCPConnection();
 
 private:
+    static void writeMessage(QTcpSocket *socket, const QByteArray &message, bool push = false);
+
     QUdpSocket *m_udpSocket;
     QTcpServer *m_tcpServer;
     tcpCallback m_tcpCallback;
+    //! written on the network thread, statistics() reads it from the others
+    mutable std::mutex m_connectionsMutex;
+    QHash<QString, Connection *> m_connections;
+    QHash<ConnectionId, QTcpSocket *> m_clients;
+    QSet<ConnectionId> m_pushClients;
 };
 
 } // namespace remote
@@ -15,6 +15,8 @@
  *  You should have received a copy of the GNU General Public License
  *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
+#include <algorithm>
+#include <cmath>
 #include "remoteclient.h"
 #include "sourcelist.h"
 #include "item.h"
@@ -26,11 +28,19 @@ namespace remote {
 
 Client::Client(Settings *settings, QObject *parent) : QObject(parent),
     m_network(),
-    m_settings(settings),
+    m_settings(settings), m_pointsPerOctave(DEFAULT_POINTS_PER_OCTAVE), m_timeFrom(0), m_timeTo(0),
     m_thread(), m_timer(),
-    m_sourceList(nullptr), m_servers(), m_items(), m_onRequest(false), m_updateCounter(0), m_needUpdate()
+    m_sourceList(nullptr), m_servers(), m_items(), m_updateCounter(0),
+    m_requestMutex(), m_needUpdate(), m_priority(), m_inFlight(), m_subscribed(), m_subscribing(), m_pollOnly()
 {
+    if (m_settings) {
+        m_pointsPerOctave = m_settings->value("pointsPerOctave", DEFAULT_POINTS_PER_OCTAVE).toUInt();
+        m_timeFrom = m_settings->value("timeFrom", 0).toFloat();
+        m_timeTo   = m_settings->value("timeTo", 0).toFloat();
+    }
     connect(&m_network, &Network::datagramRecieved, this, &Client::processData);
+    connect(&m_network, &Network::pushRecieved, this, &Client::processPush, Qt::DirectConnection);
+    connect(&m_network, &Network::connectionLost, this, &Client::connectionLost, Qt::DirectConnection);
     m_thread.setObjectName("NetworkClient");
     m_network.moveToThread(&m_thread);
     m_timer.setInterval(TIMER_INTERVAL);
@@ -43,6 +53,11 @@ Client::Client(Settings *settings, QObject *parent) : QObject(parent),
     }, Qt::DirectConnection);
     connect(&m_thread, &QThread::finished, this, [this]() {
         m_timer.stop();
+        m_network.closeConnections();
+
+        std::lock_guard<std::mutex> requestGuard(m_requestMutex);
+        m_subscribed.clear();
+        m_subscribing.clear();
     }, Qt::DirectConnection);
 }
 
@@ -125,30 +140,79 @@ void Client::selectGenerator(const QString &name)
 
 void Client::sendRequests()
 {
-    if (m_onRequest) {
+    if (!m_sourceList) {
         return;
     }
     auto guard = m_sourceList->lock();
-    std::shared_ptr<Item> updateItem;
-    UpdateKey minUpdate = READY_FOR_UPDATE;
-    unsigned int minUpdateKey = 0;
-
-    for (auto &key : m_needUpdate.keys()) {
-        auto item = m_items.value(key, nullptr);
-        auto updateValue = m_needUpdate.value(key, READY_FOR_UPDATE);
-
-        if (item && item->active() && updateValue < minUpdate) {
-            minUpdateKey = key;
-            minUpdate = updateValue;
-            updateItem = item;
+    std::lock_guard<std::mutex> requestGuard(m_requestMutex);
+
+    struct Candidate {
+        Priority priority;
+        UpdateKey key;
+        std::shared_ptr<Item> item;
+    };
+    std::vector<Candidate> candidates;
+    for (auto it = m_needUpdate.cbegin(); it != m_needUpdate.cend(); ++it) {
+        if (it.value() >= ON_UPDATE) {
+            continue;
+        }
+        auto item = m_items.value(it.key(), nullptr);
+        if (item && item->active()) {
+            candidates.push_back({m_priority.value(it.key(), Regular), it.value(), item});
         }
     }
+    std::sort(candidates.begin(), candidates.end(), [](const auto & a, const auto & b) {
+        return a.priority < b.priority || (a.priority == b.priority && a.key < b.key);
+    });
+
+    QMap<unsigned int, unsigned int> available;
+    for (auto &candidate : candidates) {
+        auto serverHash = qHash(candidate.item->serverId());
+        auto server = m_servers.value(serverHash, {{}, 0});
+        if (server.first.isNull()) {
+            continue;
+        }
+        if (!available.contains(serverHash)) {
+            auto depth = pipelineDepth(server);
+            auto inFlight = m_inFlight.value(serverHash, 0);
+            available[serverHash] = depth > inFlight ? depth - inFlight : 0;
+        }
+        if (available[serverHash] == 0) {
+            continue;
+        }
 
-    if (updateItem) {
-        m_needUpdate[minUpdateKey] = ON_UPDATE;
-        m_onRequest = true;
-        requestData(updateItem);
+        --available[serverHash];
+        ++m_inFlight[serverHash];
+        m_needUpdate[qHash(candidate.item->sourceId())] = ON_UPDATE;
+        requestData(candidate.item);
+    }
+}
+
+unsigned int Client::pipelineDepth(const std::pair<QHostAddress, int> &server) const
+{
+    auto statistics = m_network.statistics(server.first.toString(), server.second);
+    if (statistics.bandwidth <= 0 || statistics.responseSize <= 0) {
+        return 2;
+    }
+
+    //! keep the link busy for one round trip: more requests would only wait in the server's queue
+    auto serviceTime = 1000.f * statistics.responseSize / statistics.bandwidth;
+    auto depth = static_cast<unsigned int>(std::ceil(statistics.latency / serviceTime)) + 1;
+    return std::clamp(depth, 1u, MAX_PIPELINE_DEPTH);
+}
+
+Client::Priority Client::priority(const std::shared_ptr<Item> &item) const
+{
+    if (!m_sourceList || !item) {
+        return Regular;
     }
+    if (m_sourceList->selectedUuid() == item->uuid()) {
+        return Selected;
+    }
+    if (m_sourceList->isChecked(item->uuid())) {
+        return Checked;
+    }
+    return Regular;
 }
 
 void Client::sendCommand(const std::shared_ptr<Item> &item, QString command, QVariant arg)
@@ -214,6 +278,7 @@ std::shared_ptr<Item> Client::addItem(const QUuid &serverId, const QUuid &source
     });
     connect(item.get(), &Item::beforeDestroy, this, [ = ]() {
         m_items[qHash(sourceId)] = nullptr;
+        std::lock_guard<std::mutex> requestGuard(m_requestMutex);
         m_needUpdate[qHash(sourceId)] = READY_FOR_UPDATE;
     }, Qt::DirectConnection);
 
@@ -317,6 +382,7 @@ void Client::processData(QHostAddress senderAddress, [[maybe_unused]] int sender
         if (item && message == "removed") {
             m_sourceList->removeItem(item->uuid());
             m_items[qHash(sourceId)] = nullptr;
+            std::lock_guard<std::mutex> requestGuard(m_requestMutex);
             m_needUpdate[qHash(sourceId)] = READY_FOR_UPDATE;
         }
 
@@ -343,9 +409,100 @@ void Client::processData(QHostAddress senderAddress, [[maybe_unused]] int sender
 
 void Client::requestUpdate(const std::shared_ptr<Item> &item)
 {
-    if (item && item->active()) {
-        if (m_needUpdate[qHash(item->sourceId())] == READY_FOR_UPDATE) {
-            m_needUpdate[qHash(item->sourceId())] = ++m_updateCounter;
+    if (!item) {
+        return;
+    }
+    auto hash = qHash(item->sourceId());
+    bool subscribed, needSubscribe;
+    {
+        std::lock_guard<std::mutex> requestGuard(m_requestMutex);
+        subscribed = m_subscribed.contains(hash) || m_subscribing.contains(hash);
+        needSubscribe = !subscribed && !m_pollOnly.contains(qHash(item->serverId()));
+    }
+
+    if (!item->active()) {
+        if (subscribed) {
+            unsubscribe(item);
+        }
+        return;
+    }
+    if (needSubscribe) {
+        subscribe(item);
+    }
+
+    auto itemPriority = priority(item);
+    std::lock_guard<std::mutex> requestGuard(m_requestMutex);
+    if (m_subscribed.contains(hash)) {
+        return;
+    }
+    m_priority[hash] = itemPriority;
+    if (m_needUpdate.value(hash, READY_FOR_UPDATE) == READY_FOR_UPDATE) {
+        m_needUpdate[hash] = ++m_updateCounter;
+    }
+}
+
+void Client::subscribe(const std::shared_ptr<Item> &item)
+{
+    auto hash = qHash(item->sourceId());
+    auto serverHash = qHash(item->serverId());
+    {
+        std::lock_guard<std::mutex> requestGuard(m_requestMutex);
+        m_subscribing.insert(hash);
+    }
+
+    Network::responseCallback onAnswer = [this, hash, serverHash](const QByteArray & data) {
+        auto document = QJsonDocument::fromJson(data);
+        std::lock_guard<std::mutex> requestGuard(m_requestMutex);
+        m_subscribing.remove(hash);
+        if (document["message"].toString() == "subscribed") {
+            m_subscribed.insert(hash);
+        } else if (document.isNull()) {
+            m_pollOnly.insert(serverHash);
+        }
+    };
+    Network::errorCallback onError = [this, hash]() {
+        std::lock_guard<std::mutex> requestGuard(m_requestMutex);
+        m_subscribing.remove(hash);
+    };
+
+    auto data = resolution();
+    data["rate"]   = PUSH_RATE;
+    data["fields"] = Network::ALL_FIELDS;
+    requestSource(item, "subscribe", onAnswer, onError, data);
+}
+
+void Client::unsubscribe(const std::shared_ptr<Item> &item)
+{
+    {
+        std::lock_guard<std::mutex> requestGuard(m_requestMutex);
+        m_subscribed.remove(qHash(item->sourceId()));
+    }
+    Network::responseCallback onAnswer = [](const QByteArray &) {};
+    Network::errorCallback onError = []() {};
+    requestSource(item, "unsubscribe", onAnswer, onError);
+}
+
+void Client::processPush(const QByteArray &data)
+{
+    auto document = QJsonDocument::fromJson(data);
+    if (document.isNull() || document["message"].toString() != "sourceData") {
+        return;
+    }
+    auto hash = qHash(QUuid::fromString(document["uuid"].toString()));
+    emit dataReceived(hash, document["ftdata"].toArray(), document["timeData"].toArray(),
+                      document["fields"].toInt(Network::ALL_FIELDS));
+}
+
+void Client::connectionLost(const QString &host, quint16 port)
+{
+    std::lock_guard<std::mutex> requestGuard(m_requestMutex);
+    for (auto &item : m_items) {
+        if (!item) {
+            continue;
+        }
+        auto server = m_servers.value(qHash(item->serverId()), {{}, 0});
+        if (server.first.toString() == host && server.second == port) {
+            m_subscribed.remove(qHash(item->sourceId()));
         }
     }
 }
@@ -501,26 +658,46 @@ void Client::requestData(const std::shared_ptr<Item> &item)
         return;
     }
     auto hash = qHash(item->sourceId());
-    Network::responseCallback onAnswer = [this, hash](const QByteArray & data) {
+    auto serverHash = qHash(item->serverId());
+    auto release = [this, hash, serverHash]() {
+        std::lock_guard<std::mutex> requestGuard(m_requestMutex);
+        m_needUpdate[hash] = READY_FOR_UPDATE;
+        if (m_inFlight.value(serverHash, 0) > 0) {
+            --m_inFlight[serverHash];
+        }
+    };
+
+    Network::responseCallback onAnswer = [this, hash, release](const QByteArray & data) {
         auto document = QJsonDocument::fromJson(data);
+        release();
         if (!document.isNull()) {
             auto frequencyData = document["ftdata"].toArray();
             auto timeData = document["timeData"].toArray();
-            emit dataReceived(hash, frequencyData, timeData);
-            m_needUpdate[hash] = READY_FOR_UPDATE;
+            emit dataReceived(hash, frequencyData, timeData, Network::ALL_FIELDS);
         } else {
             emit dataError(hash, false);
         }
-        m_onRequest = false;
+        sendRequests();
     };
-    Network::errorCallback onError = [this, hash]() {
-
+    Network::errorCallback onError = [this, hash, release]() {
+        release();
         emit dataError(hash, false);
         qDebug() << "requestData error";
-        m_needUpdate[hash] = READY_FOR_UPDATE;
-        m_onRequest = false;
     };
-    requestSource(item, "requestData", onAnswer, onError);
+    requestSource(item, "requestData", onAnswer, onError, resolution());
+}
+
+QJsonObject Client::resolution() const
+{
+    QJsonObject data;
+    if (m_pointsPerOctave) {
+        data["pointsPerOctave"] = static_cast<int>(m_pointsPerOctave);
+    }
+    if (m_timeTo > m_timeFrom) {
+        data["timeFrom"] = m_timeFrom;
+        data["timeTo"]   = m_timeTo;
+    }
+    return data;
 }
 
 template <typename ItemType>
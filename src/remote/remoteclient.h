@@ -18,6 +18,7 @@
 #ifndef REMOTE_CLIENT_H
 #define REMOTE_CLIENT_H
 
+#include <mutex>
 #include <QObject>
 #include <QList>
 #include "network.h"
@@ -39,6 +40,10 @@ class Client : public QObject
     Q_PROPERTY(SharedGeneratorRemote controlledGenerator READ controlledGenerator NOTIFY controlledGeneratorChanged)
 
     const static int TIMER_INTERVAL = 250;
+    constexpr static unsigned int MAX_PIPELINE_DEPTH = 8;
+    const static int PUSH_RATE = 25; //Hz
+    //! full resolution: stores, unions and plots without bands need every bin
+    const static unsigned int DEFAULT_POINTS_PER_OCTAVE = 0;
 
 public:
     explicit Client(Settings *settings, QObject *parent = nullptr);
@@ -65,7 +70,7 @@ public slots:
 signals:
     void activeChanged();
     void dataError(const uint hash, const bool deactivate);
-    void dataReceived(const uint hash, QJsonArray data, QJsonArray timeData);
+    void dataReceived(const uint hash, QJsonArray data, QJsonArray timeData, int fields);
     void newRemoteItem(const QUuid &serverId, const QUuid &sourceId, const QString &objectName,
                        const QString &host, const QUuid groupId);
     void generatorsListChanged();
@@ -84,6 +89,21 @@ private:
     void requestChanged(const std::shared_ptr<Item> &item);
     void requestGenearatorChanged(const SharedGeneratorRemote &genearator);
     void requestData(const std::shared_ptr<Item> &item);
+    void subscribe(const std::shared_ptr<Item> &item);
+    void unsubscribe(const std::shared_ptr<Item> &item);
+    void processPush(const QByteArray &data);
+    void connectionLost(const QString &host, quint16 port);
+
+    //! selected traces are refreshed first, then checked, then the rest
+    enum Priority {
+        Selected    = 0,
+        Checked     = 1,
+        Regular     = 2
+    };
+    Priority priority(const std::shared_ptr<Item> &item) const;
+    //! the level of detail sent with requestData and subscribe
+    QJsonObject resolution() const;
+    unsigned int pipelineDepth(const std::pair<QHostAddress, int> &server) const;
 
     template <typename ItemType>
     void sendUpdate(const std::shared_ptr<ItemType> &item, QString propertyName);
@@ -93,6 +113,9 @@ private:
 
     Network m_network;
     Settings *m_settings;
+    unsigned int m_pointsPerOctave;
+    //! ms, the impulse window, the whole impulse when equal
+    float m_timeFrom, m_timeTo;
     QThread m_thread;
     QTimer m_timer;
     std::shared_ptr<SourceList> m_sourceList;
@@ -102,12 +125,21 @@ private:
     QMap<unsigned int, SharedGeneratorRemote> m_generators;
     SharedGeneratorRemote             m_controlledGenerator;
 
-    std::atomic<bool> m_onRequest;
     typedef unsigned long UpdateKey;
     const UpdateKey READY_FOR_UPDATE = std::numeric_limits<UpdateKey>::max();
     const UpdateKey ON_UPDATE = READY_FOR_UPDATE - 1;
     std::atomic<UpdateKey> m_updateCounter;
+
+    //! guards the request and subscription state: written from the main and the network threads
+    mutable std::mutex m_requestMutex;
     QMap<unsigned int, UpdateKey> m_needUpdate;
+    QMap<unsigned int, Priority> m_priority;
+    QMap<unsigned int, unsigned int> m_inFlight;
+
+    //! items updated by the server, they are not polled
+    QSet<unsigned int> m_subscribed, m_subscribing;
+    //! servers without subscriptions support
+    QSet<unsigned int> m_pollOnly;
 };
 
 } // namespace remote
@@ -15,18 +15,26 @@
  *  You should have received a copy of the GNU General Public License
  *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
+#include <algorithm>
+#include <cmath>
 #include "sourcelist.h"
 #include "generator.h"
 #include "meta/metabase.h"
 #include "remote/server.h"
 #include "remote/item.h"
+#include "chart/frequencybasedserieshelper.h"
+#include "common/trace.h"
+#include "math/complexkernel.h"
+#include "math/leq.h"
+#include "math/levelhistory.h"
 
 namespace remote {
 
 Server::Server(std::shared_ptr<Generator> generator, QObject *parent) : QObject(parent),
     m_uuid(QUuid::createUuid()), m_networkThread(), m_network(), m_sourceList(nullptr),
-    m_generator(generator), m_generatorEnable(false)
+    m_generator(generator), m_generatorEnable(false), m_subscriptionMutex(), m_subscriptions(), m_clock()
 {
+    m_clock.start();
     m_network.moveToThread(&m_networkThread);
     m_timer.moveToThread(&m_networkThread);
     m_networkThread.setObjectName("NetworkServer");
@@ -41,8 +49,9 @@ Server::Server(std::shared_ptr<Generator> generator, QObject *parent) : QObject(
     });
     connect(&m_networkThread, &QThread::finished, &m_timer, &QTimer::stop);
 
-    m_network.setTcpCallback([this] (const QHostAddress && address, const QByteArray && data) -> QByteArray {
-        return tcpCallback(std::move(address), std::move(data));
+    m_network.setTcpCallback([this] (const QHostAddress && address, const QByteArray && data,
+    Network::ConnectionId connection) -> QByteArray {
+        return tcpCallback(std::move(address), std::move(data), connection);
     });
 
     for (int i = 0 ; i < m_generator->metaObject()->propertyCount(); ++i) {
@@ -89,6 +98,7 @@ void Server::connectSourceList(SourceList *list, const Shared::Source &group)
         connect(source.get(), &Abstract::Source::readyRead, this, [this, source]() {
             sourceNotify(source, "readyRead");
             sourceNotify(source, "levels", source->levels());
+            pushData(source->uuid());
         });
 
         for (int i = 0 ; i < source->metaObject()->propertyCount(); ++i) {
@@ -136,6 +146,8 @@ void Server::setGeneratorEnable(bool newGeneratorEnable)
 
 bool Server::start()
 {
+    connect(&m_network, &Network::clientReady, this, &Server::clientReady, Qt::UniqueConnection);
+    connect(&m_network, &Network::clientDisconnected, this, &Server::clientDisconnected, Qt::UniqueConnection);
     m_networkThread.start();
     sendHello();
     emit activeChanged();
@@ -147,6 +159,10 @@ void Server::stop()
     m_network.disconnect();
     m_networkThread.quit();
     m_networkThread.wait();
+    {
+        std::lock_guard<std::mutex> guard(m_subscriptionMutex);
+        m_subscriptions.clear();
+    }
     emit activeChanged();
 }
 
@@ -205,7 +221,8 @@ void Server::setLastConnected(const QString &lastConnected)
     }
 }
 
-QByteArray Server::tcpCallback([[maybe_unused]] const QHostAddress &&address, const QByteArray &&data)
+QByteArray Server::tcpCallback([[maybe_unused]] const QHostAddress &&address, const QByteArray &&data,
+                               Network::ConnectionId connection)
 {
     auto document = QJsonDocument::fromJson(data);
     if (document.isNull()) {
@@ -228,6 +245,13 @@ QByteArray Server::tcpCallback([[maybe_unused]] const QHostAddress &&address, co
     }
     setLastConnected(document["name"].toString());
 
+    if (message == "requestDiagnostics") {
+        auto object = prepareMessage("diagnostics");
+        object["data"] = Trace::getInstance()->toJSON();
+        QJsonDocument document(std::move(object));
+        return document.toJson(QJsonDocument::JsonFormat::Compact);
+    }
+
     if (!targetQObject) {
         QJsonObject object;
         object["api"]     = "Open Sound Meter";
@@ -374,45 +398,30 @@ QByteArray Server::tcpCallback([[maybe_unused]] const QHostAddress &&address, co
     }
 
     if (source && message == "requestData") {
-        QJsonObject object;
-        object["api"]     = "Open Sound Meter";
-        object["version"] = APP_GIT_VERSION;
-        object["message"] = "sourceData";
-        object["uuid"]    = source->uuid().toString();
-
-        QJsonArray ftdata;
-        QJsonArray ftcell = {0, 0, 0, 0, 0};
-        for (unsigned int i = 0; i < source->frequencyDomainSize(); ++i) {
-            ftcell[0] = static_cast<double>(source->frequency(i)  );
-            ftcell[1] = static_cast<double>(source->module(i)     );
-            ftcell[2] = static_cast<double>(source->magnitudeRaw(i));
-            ftcell[3] = static_cast<double>(source->phase(i).arg());
-            ftcell[4] = static_cast<double>(source->coherence(i)  );
-            //ftcell[5] = static_cast<double>(source->peakSquared(i));
-            //ftcell[6] = static_cast<double>(source->meanSquared(i));
-
-            if ( i >= static_cast<unsigned int>(ftdata.size())) {
-                ftdata << std::move(ftcell);
-            } else {
-                ftdata[i] = std::move(ftcell);
-            }
-        }
-        object["ftdata"] = std::move(ftdata);
+        auto itemData = document["data"].toObject();
+        auto object = sourceData(source, itemData["fields"].toInt(Network::ALL_FIELDS), Resolution::fromJSON(itemData));
+        QJsonDocument document(std::move(object));
+        return document.toJson(QJsonDocument::JsonFormat::Compact);
+    }
 
-        QJsonArray timeData;
-        QJsonArray timeCell = {0, 0};
-        for (unsigned int i = 0; i < source->timeDomainSize(); ++i) {
-            timeCell[0] = source->impulseTime(i);
-            timeCell[1] = source->impulseValue(i);
+    if (source && message == "requestLevelHistory") {
+        auto after = document["data"].toObject()["after"].toVariant().toULongLong();
+        QJsonDocument document(levelHistoryData(source, after));
+        return document.toJson(QJsonDocument::JsonFormat::Compact);
+    }
 
-            if ( i >= static_cast<unsigned int>(timeData.size())) {
-                timeData << std::move(timeCell);
-            } else {
-                timeData[i] = std::move(timeCell);
-            }
+    if (source && (message == "subscribe" || message == "unsubscribe")) {
+        if (message == "subscribe") {
+            subscribe(connection, sourceId, document["data"].toObject());
+        } else {
+            unsubscribe(connection, sourceId);
         }
-        object["timeData"] = std::move(timeData);
 
+        QJsonObject object;
+        object["api"]     = "Open Sound Meter";
+        object["version"] = APP_GIT_VERSION;
+        object["message"] = message + "d";
+        object["uuid"]    = sourceId.toString();
         QJsonDocument document(std::move(object));
         return document.toJson(QJsonDocument::JsonFormat::Compact);
     }
@@ -455,6 +464,353 @@ QByteArray Server::tcpCallback([[maybe_unused]] const QHostAddress &&address, co
     return {};
 }
 
+Server::Resolution Server::Resolution::fromJSON(const QJsonObject &data)
+{
+    Resolution resolution;
+    resolution.pointsPerOctave = data["pointsPerOctave"].toInt(0);
+    resolution.frequencyFrom   = data["frequencyFrom"].toDouble(0);
+    resolution.frequencyTo     = data["frequencyTo"].toDouble(0);
+    resolution.timeFrom        = data["timeFrom"].toDouble(0);
+    resolution.timeTo          = data["timeTo"].toDouble(0);
+    return resolution;
+}
+
+QString Server::Resolution::key() const
+{
+    return QString("%1:%2:%3:%4:%5").arg(pointsPerOctave).arg(frequencyFrom).arg(frequencyTo).arg(timeFrom).arg(timeTo);
+}
+
+QJsonObject Server::sourceData(const Shared::Source &source, int fields, const Resolution &resolution)
+{
+    Trace::Scope trace(Trace::RemoteSerialisation);
+    QJsonObject object;
+    object["api"]     = "Open Sound Meter";
+    object["version"] = APP_GIT_VERSION;
+    object["message"] = "sourceData";
+    object["uuid"]    = source->uuid().toString();
+    object["fields"]  = fields;
+    if (resolution.pointsPerOctave) {
+        object["pointsPerOctave"] = static_cast<int>(resolution.pointsPerOctave);
+    }
+
+    auto inRange = [&resolution](float from, float to) {
+        return (resolution.frequencyFrom <= 0 || to   >= resolution.frequencyFrom) &&
+               (resolution.frequencyTo   <= 0 || from <= resolution.frequencyTo);
+    };
+
+    source->lock();
+    if (fields & ~Network::IMPULSE) {
+        QJsonArray ftdata;
+        QJsonArray ftcell;
+        auto appendCell = [&ftdata, &ftcell, fields](float frequency, float module, float magnitude, float phase,
+        float coherence) {
+            if (fields & Network::FREQUENCY) ftcell << static_cast<double>(frequency);
+            if (fields & Network::MODULE)    ftcell << static_cast<double>(module   );
+            if (fields & Network::MAGNITUDE) ftcell << static_cast<double>(magnitude);
+            if (fields & Network::PHASE)     ftcell << static_cast<double>(phase    );
+            if (fields & Network::COHERENCE) ftcell << static_cast<double>(coherence);
+
+            ftdata << std::move(ftcell);
+            ftcell = QJsonArray();
+        };
+
+        if (resolution.pointsPerOctave) {
+            //! the same bands as the plots use, so a client draws them at this or a lower ppo without loss.
+            //! module is the band power to keep RTA bars levels
+            float moduleSquared = 0, magnitude = 0, coherence = 0;
+            Complex phase {0, 0};
+            auto accumulate = [&](const unsigned int &i) {
+                moduleSquared += std::pow(source->module(i), 2);
+                magnitude += source->magnitudeRaw(i);
+                phase += source->phase(i);
+                coherence += source->coherence(i);
+            };
+            auto collected = [&](const float & start, const float & end, const unsigned int & count) {
+                if (inRange(start, end)) {
+                    appendCell(std::sqrt(start * end), std::sqrt(moduleSquared), magnitude / count, phase.arg(), coherence / count);
+                }
+                moduleSquared = magnitude = coherence = 0;
+                phase = {0, 0};
+            };
+            Chart::FrequencyBasedSeriesHelper::iterate(*source, resolution.pointsPerOctave, accumulate, collected);
+        } else {
+            std::vector<Complex> phases(source->frequencyDomainSize());
+            std::vector<float> arguments(phases.size());
+            for (unsigned int i = 0; i < phases.size(); ++i) {
+                phases[i] = source->phase(i);
+            }
+            math::ComplexKernel::arg(phases, arguments);
+
+            for (unsigned int i = 0; i < source->frequencyDomainSize(); ++i) {
+                auto frequency = source->frequency(i);
+                if (inRange(frequency, frequency)) {
+                    appendCell(frequency, source->module(i), source->magnitudeRaw(i), arguments[i],
+                               source->coherence(i));
+                }
+            }
+        }
+        object["ftdata"] = std::move(ftdata);
+    }
+
+    if (fields & Network::IMPULSE) {
+        QJsonArray timeData;
+        QJsonArray timeCell = {0, 0};
+        bool window = resolution.timeTo > resolution.timeFrom;
+        for (unsigned int i = 0; i < source->timeDomainSize(); ++i) {
+            auto time = source->impulseTime(i);
+            if (window && (time < resolution.timeFrom || time > resolution.timeTo)) {
+                continue;
+            }
+            timeCell[0] = time;
+            timeCell[1] = source->impulseValue(i);
+            timeData << timeCell;
+        }
+        object["timeData"] = std::move(timeData);
+    }
+    source->unlock();
+
+    return object;
+}
+
+QJsonObject Server::levelHistoryData(const Shared::Source &source, quint64 after)
+{
+    Trace::Scope trace(Trace::RemoteSerialisation);
+    QJsonObject object;
+    object["api"]     = "Open Sound Meter";
+    object["version"] = APP_GIT_VERSION;
+    object["message"] = "levelHistory";
+    object["uuid"]    = source->uuid().toString();
+
+    auto history = source->levelHistory();
+    if (!history) {
+        return object;
+    }
+
+    //JSON has no -inf and NaN: silence and empty Leq are sent as the floor level
+    auto dB = [] (float value) {
+        return std::isfinite(value) ? std::max(static_cast<double>(value), -140.) : -140.;
+    };
+
+    //frame: [index, fast dB of every curve, slow dB of every curve, frame level dB of every curve]
+    QJsonArray curves, frames;
+    QJsonObject leq;
+    for (auto &curve : Weighting::allCurves) {
+        curves << Weighting::curveName(curve);
+        QJsonObject times;
+        for (auto &time : math::Leq::times()) {
+            times[QString::number(time.first)] = dB(history->leq(curve, time.first));
+        }
+        leq[Weighting::curveName(curve)] = times;
+    }
+    for (auto &frame : history->frames(after)) {
+        QJsonArray cell;
+        cell << static_cast<double>(frame.index);
+        for (auto &value : frame.fast) {
+            cell << dB(value);
+        }
+        for (auto &value : frame.slow) {
+            cell << dB(value);
+        }
+        for (auto &value : frame.level) {
+            cell << dB(value);
+        }
+        frames << cell;
+    }
+    object["frameInterval"] = static_cast<double>(math::LevelHistory::FRAME_INTERVAL);
+    object["curves"] = curves;
+    object["frames"] = frames;
+    object["leq"]    = leq;
+    return object;
+}
+
+void Server::subscribe(Network::ConnectionId connection, const QUuid &sourceId, const QJsonObject &data)
+{
+    auto rate = data["rate"].toDouble(0);
+    Subscription subscription {
+        connection,
+        data["fields"].toInt(Network::ALL_FIELDS),
+        Resolution::fromJSON(data),
+        rate > 0 ? static_cast<qint64>(1000 / rate) : 0,
+        0, 0, 0, false, false, false, false
+    };
+
+    {
+        std::lock_guard<std::mutex> guard(m_subscriptionMutex);
+        auto &list = m_subscriptions[sourceId];
+        auto it = std::find_if(list.begin(), list.end(), [connection](const auto & s) {
+            return s.connection == connection;
+        });
+        if (it != list.end()) {
+            *it = subscription;
+        } else {
+            list.push_back(subscription);
+        }
+    }
+
+    //! send the current state right away: a stored source won't emit readyRead by itself
+    QMetaObject::invokeMethod(this, "pushData", Qt::QueuedConnection, Q_ARG(QUuid, sourceId));
+}
+
+void Server::unsubscribe(Network::ConnectionId connection, const QUuid &sourceId)
+{
+    std::lock_guard<std::mutex> guard(m_subscriptionMutex);
+    auto it = m_subscriptions.find(sourceId);
+    if (it == m_subscriptions.end()) {
+        return;
+    }
+    it->erase(std::remove_if(it->begin(), it->end(), [connection](const auto & s) {
+        return s.connection == connection;
+    }), it->end());
+    if (it->isEmpty()) {
+        m_subscriptions.erase(it);
+    }
+}
+
+void Server::pushData(const QUuid &sourceId)
+{
+    {
+        std::lock_guard<std::mutex> guard(m_subscriptionMutex);
+        if (!m_subscriptions.contains(sourceId) || !m_sourceList) {
+            return;
+        }
+    }
+
+    auto listGuard = m_sourceList->lock();
+    std::lock_guard<std::mutex> guard(m_subscriptionMutex);
+    auto it = m_subscriptions.find(sourceId);
+    if (it == m_subscriptions.end()) {
+        return;
+    }
+
+    auto source = m_sourceList->getByUUid(sourceId);
+    if (!source) {
+        m_subscriptions.erase(it);
+        return;
+    }
+
+    auto now = m_clock.elapsed();
+    auto revision = source->dataRevision();
+    struct Payload {
+        int fields;
+        Resolution resolution;
+        QList<Network::ConnectionId> connections;
+    };
+    QHash<QString, Payload> payloads;
+    for (auto &subscription : *it) {
+        if (subscription.sent && subscription.revision == revision) {
+            subscription.pending = false;
+            continue;
+        }
+        if (subscription.busy) {
+            subscription.pending = true;
+            continue;
+        }
+        auto wait = subscription.lastSent + subscription.interval - now;
+        if (wait > 0) {
+            subscription.pending = true;
+            if (!subscription.scheduled) {
+                subscription.scheduled = true;
+                QTimer::singleShot(wait, this, [this, sourceId]() {
+                    pushData(sourceId);
+                });
+            }
+            continue;
+        }
+        subscription.pending = false;
+        subscription.scheduled = false;
+        subscription.sent = true;
+        subscription.revision = revision;
+        subscription.lastSent = now;
+        subscription.busy = true;
+
+        auto payloadKey = QString::number(subscription.fields) + "/" + subscription.resolution.key();
+        auto &payload = payloads[payloadKey];
+        payload.fields = subscription.fields;
+        payload.resolution = subscription.resolution;
+        payload.connections << subscription.connection;
+    }
+
+    for (auto &payload : payloads) {
+        QMetaObject::invokeMethod(&m_network, [this, source, payload]() {
+            sendPush(source, payload.connections, payload.fields, payload.resolution);
+        }, Qt::QueuedConnection);
+    }
+}
+
+void Server::sendPush(const Shared::Source &source, const QList<Network::ConnectionId> &connections, int fields,
+                      const Resolution &resolution)
+{
+    QJsonDocument document(sourceData(source, fields, resolution));
+    auto payload = document.toJson(QJsonDocument::JsonFormat::Compact);
+    auto hash = qHash(payload);
+
+    bool pending = false;
+    QList<Network::ConnectionId> targets;
+    {
+        std::lock_guard<std::mutex> guard(m_subscriptionMutex);
+        auto it = m_subscriptions.find(source->uuid());
+        if (it == m_subscriptions.end()) {
+            return;
+        }
+        for (auto &subscription : *it) {
+            if (!connections.contains(subscription.connection)) {
+                continue;
+            }
+            if (hash == subscription.lastHash) {
+                //! nothing is written, clientReady won't come for this push
+                subscription.busy = false;
+                pending = pending || subscription.pending;
+                continue;
+            }
+            subscription.lastHash = hash;
+            targets << subscription.connection;
+        }
+    }
+
+    for (auto &connection : targets) {
+        m_network.push(connection, payload);
+    }
+    if (pending) {
+        QMetaObject::invokeMethod(this, "pushData", Qt::QueuedConnection, Q_ARG(QUuid, source->uuid()));
+    }
+}
+
+void Server::clientReady(Network::ConnectionId connection)
+{
+    QList<QUuid> pending;
+    {
+        std::lock_guard<std::mutex> guard(m_subscriptionMutex);
+        for (auto it = m_subscriptions.begin(); it != m_subscriptions.end(); ++it) {
+            for (auto &subscription : *it) {
+                if (subscription.connection == connection) {
+                    subscription.busy = false;
+                    if (subscription.pending) {
+                        pending << it.key();
+                    }
+                }
+            }
+        }
+    }
+    for (auto &sourceId : pending) {
+        pushData(sourceId);
+    }
+}
+
+void Server::clientDisconnected(Network::ConnectionId connection)
+{
+    std::lock_guard<std::mutex> guard(m_subscriptionMutex);
+    for (auto it = m_subscriptions.begin(); it != m_subscriptions.end();) {
+        it->erase(std::remove_if(it->begin(), it->end(), [connection](const auto & s) {
+            return s.connection == connection;
+        }), it->end());
+        if (it->isEmpty()) {
+            it = m_subscriptions.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
 QJsonObject Server::prepareMessage(const QString &message) const
 {
     QJsonObject object;
@@ -18,7 +18,9 @@
 #ifndef REMOTE_SERVER_H
 #define REMOTE_SERVER_H
 
+#include <mutex>
 #include <QObject>
+#include <QElapsedTimer>
 #include "network.h"
 #include "shared/source_shared.h"
 #include "source/group.h"
@@ -51,7 +53,7 @@ public:
     bool active() const;
     void setActive(bool state);
 
-    QByteArray tcpCallback(const QHostAddress &&address, const QByteArray &&data);
+    QByteArray tcpCallback(const QHostAddress &&address, const QByteArray &&data, Network::ConnectionId connection);
     QString lastConnected() const;
 
     bool generatorEnable() const;
@@ -68,6 +70,25 @@ public slots:
 
 private slots:
     void sendHello();
+    void pushData(const QUuid &sourceId);
+    void clientReady(remote::Network::ConnectionId connection);
+    void clientDisconnected(remote::Network::ConnectionId connection);
+
+public:
+    //! level of detail requested by a client, zero values mean no limit
+    struct Resolution {
+        unsigned int pointsPerOctave = 0;
+        float frequencyFrom = 0, frequencyTo = 0;
+        float timeFrom = 0, timeTo = 0;
+
+        static Resolution fromJSON(const QJsonObject &data);
+        QString key() const;
+    };
+
+    //! serialized data of the source as sent to clients, reduced to the resolution
+    static QJsonObject sourceData(const Shared::Source &source, int fields, const Resolution &resolution);
+    //! level frames logged after the frame `after` and Leq of every available time
+    static QJsonObject levelHistoryData(const Shared::Source &source, quint64 after);
 
 private:
     QJsonObject prepareMessage(const QString &message) const;
@@ -75,6 +96,25 @@ private:
     void sendMulticast(const QByteArray &data);
     void setLastConnected(const QString &lastConnected);
     void connectSourceList(SourceList *list, const Shared::Source &group = {});
+    void subscribe(Network::ConnectionId connection, const QUuid &sourceId, const QJsonObject &data);
+    void unsubscribe(Network::ConnectionId connection, const QUuid &sourceId);
+
+    struct Subscription {
+        Network::ConnectionId connection;
+        int fields;
+        Resolution resolution;
+        qint64 interval;        //!< ms, minimal time between two pushes
+        qint64 lastSent;
+        uint lastHash;          //!< hash of the last pushed payload, unchanged data is not sent again
+        unsigned int revision;  //!< data revision of the source at the last push
+        bool sent;
+        bool busy;              //!< the client hasn't read the previous push yet
+        bool pending;           //!< new data arrived while busy or too early
+        bool scheduled;
+    };
+    //! serializes the data on the network thread and pushes it to the subscribers which are still waiting
+    void sendPush(const Shared::Source &source, const QList<Network::ConnectionId> &connections, int fields,
+                  const Resolution &resolution);
 
     QUuid m_uuid;
     QTimer m_timer;
@@ -84,6 +124,11 @@ private:
     std::shared_ptr<SourceList> m_sourceList;
     std::shared_ptr<Generator> m_generator;
     bool m_generatorEnable;
+
+    //! guards m_subscriptions, modified from the network thread by requests
+    std::mutex m_subscriptionMutex;
+    QHash<QUuid, QList<Subscription>> m_subscriptions;
+    QElapsedTimer m_clock;
 };
 
 } // namespace remote
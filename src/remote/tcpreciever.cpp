@@ -23,7 +23,7 @@
 
 namespace remote {
 
-TCPReciever::TCPReciever(QTcpSocket *socket) : QObject(socket), p_size{0}, m_data(), m_timer(this)
+TCPReciever::TCPReciever(QTcpSocket *socket) : QObject(socket), p_size{0}, m_data(), m_push(false), m_timer(this)
 {
     m_timer.setSingleShot(true);
     m_timer.setInterval(TIMEOUT);
@@ -48,26 +48,68 @@ const QByteArray &TCPReciever::data() const noexcept
     return m_data;
 }
 
-std::array<char, 4> TCPReciever::makeHeader(const QByteArray &data)
+bool TCPReciever::isPush() const noexcept
 {
-    qint32 size = qToLittleEndian<qint32>(data.size());
+    return m_push;
+}
+
+std::array<char, 4> TCPReciever::makeHeader(const QByteArray &data, bool push)
+{
+    qint32 size = qToLittleEndian<qint32>(data.size() | (push ? PUSH_FLAG : 0));
     std::array<char, 4> a;
     std::memmove(a.data(), &size, 4);
     return a;
 }
 
+void TCPReciever::reset() noexcept
+{
+    p_size.value = 0;
+    m_data.clear();
+    m_push = false;
+}
+
+void TCPReciever::restartTimeout()
+{
+    m_timer.start();
+}
+
+void TCPReciever::stopTimeout()
+{
+    m_timer.stop();
+}
+
 void TCPReciever::socketReadyRead()
 {
     if (!socket() || !socket()->isReadable()) {
         return;
     }
+
+    //! a persistent connection can carry several messages in one read
+    //! the timeout is prolonged only while it runs: the owner stops it for an idle connection,
+    //! the readyRead handler may stop or restart it again
+    while (readMessage()) {
+        if (m_timer.isActive()) {
+            m_timer.start();
+        }
+        emit readyRead();
+        reset();
+    }
+}
+
+bool TCPReciever::readMessage()
+{
     if (!p_size.value) {
+        if (socket()->bytesAvailable() < 4) {
+            return false;
+        }
         const auto sizeData = socket()->read(4);
         p_size.byte[0] = sizeData[0];
         p_size.byte[1] = sizeData[1];
         p_size.byte[2] = sizeData[2];
         p_size.byte[3] = sizeData[3];
         p_size.value = qFromLittleEndian(p_size.value);
+        m_push = p_size.value & PUSH_FLAG;
+        p_size.value &= ~PUSH_FLAG;
         m_data.reserve(p_size.value);
     }
 
@@ -76,9 +118,7 @@ void TCPReciever::socketReadyRead()
         m_data.push_back(data);
     }
 
-    if (p_size.value <= m_data.size()) {
-        emit readyRead();
-    }
+    return p_size.value <= m_data.size();
 }
 
 QTcpSocket *TCPReciever::socket() const noexcept
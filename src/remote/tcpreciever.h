@@ -29,6 +29,8 @@ class TCPReciever : public QObject
 {
     Q_OBJECT
     static const int TIMEOUT = 10000;
+    //! marks messages sent by the server without a request
+    static const qint32 PUSH_FLAG = 0x40000000;
 
 public:
     //! To run reciever in the socket's thread use setSocket after moving socket to a new thread
@@ -36,8 +38,14 @@ public:
 
     void setSocket(QTcpSocket *socket = nullptr);
     const QByteArray &data() const noexcept;
+    bool isPush() const noexcept;
 
-    static std::array<char, 4> makeHeader(const QByteArray &data);
+    //! drop partially recieved message, used when the socket is reconnected
+    void reset() noexcept;
+    void restartTimeout();
+    void stopTimeout();
+
+    static std::array<char, 4> makeHeader(const QByteArray &data, bool push = false);
 
 public slots:
     virtual void socketReadyRead();
@@ -47,11 +55,14 @@ signals:
     void timeOut();
 
 private:
+    bool readMessage();
+
     union {
         qint32 value;
         char byte[4];
     } p_size;
     QByteArray m_data;
+    bool m_push;
     QTcpSocket *socket() const noexcept;
     QTimer m_timer;
 };
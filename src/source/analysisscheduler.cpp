@@ -0,0 +1,113 @@
+/**
+ *  OSM
+ *  Copyright (C) 2026  Pavel Smokotnin
+
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <algorithm>
+#include "analysisscheduler.h"
+#include "measurement.h"
+#include "common/trace.h"
+
+AnalysisScheduler::AnalysisScheduler(QObject *parent) : QObject(parent),
+    m_thread(), m_timer(), m_mutex(), m_measurements(), m_batches()
+{
+    m_timer.setInterval(Measurement::TIMER_INTERVAL);
+    m_timer.moveToThread(&m_thread);
+    connect(&m_timer, &QTimer::timeout, this, &AnalysisScheduler::tick, Qt::DirectConnection);
+    connect(&m_thread, &QThread::started, &m_timer, qOverload<>(&QTimer::start), Qt::DirectConnection);
+    connect(&m_thread, &QThread::finished, &m_timer, &QTimer::stop, Qt::DirectConnection);
+}
+
+AnalysisScheduler::~AnalysisScheduler()
+{
+    m_thread.quit();
+    m_thread.wait();
+}
+
+bool AnalysisScheduler::enabled()
+{
+    static const bool enabled = qEnvironmentVariableIsSet(ENABLE_VARIABLE);
+    return enabled;
+}
+
+AnalysisScheduler *AnalysisScheduler::getInstance()
+{
+    static AnalysisScheduler instance;
+    return &instance;
+}
+
+void AnalysisScheduler::add(Measurement *measurement)
+{
+    std::lock_guard<std::mutex> guard(m_mutex);
+    m_measurements.push_back(measurement);
+    if (!m_thread.isRunning()) {
+        m_thread.start();
+    }
+}
+
+void AnalysisScheduler::remove(Measurement *measurement)
+{
+    std::lock_guard<std::mutex> guard(m_mutex);
+    m_measurements.erase(std::remove(m_measurements.begin(), m_measurements.end(), measurement),
+                         m_measurements.end());
+}
+
+void AnalysisScheduler::tick()
+{
+    std::lock_guard<std::mutex> guard(m_mutex);
+    Trace::Scope trace(Trace::Transform);
+
+    struct Started {
+        Measurement *measurement;
+        math::BatchTransform *batch;
+        unsigned int slot;
+    };
+    std::vector<Started> started;
+    for (auto &batch : m_batches) {
+        batch.second.clear();
+    }
+
+    //each measurement is locked on its own, so no lock order is imposed and readers aren't blocked by the batch
+    for (auto *measurement : m_measurements) {
+        if (!measurement->beginTransform()) {
+            continue;
+        }
+        Started item {measurement, nullptr, 0};
+        if (auto ft = measurement->pendingTransform()) {
+            if (ft->type() == FourierTransform::Fast) {
+                item.batch = &m_batches[ft->size()];
+                item.slot = item.batch->add(*ft);
+            } else {
+                ft->transform();
+            }
+        }
+        measurement->unlock();
+        started.push_back(item);
+    }
+
+    for (auto &batch : m_batches) {
+        batch.second.run();
+    }
+
+    for (auto &item : started) {
+        item.measurement->lock();
+        if (item.batch) {
+            if (auto ft = item.measurement->pendingTransform()) {
+                item.batch->result(item.slot, *ft);
+            }
+        }
+        item.measurement->endTransform();
+    }
+}
@@ -0,0 +1,68 @@
+/**
+ *  OSM
+ *  Copyright (C) 2026  Pavel Smokotnin
+
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef ANALYSISSCHEDULER_H
+#define ANALYSISSCHEDULER_H
+
+#include <map>
+#include <mutex>
+#include <vector>
+#include <QObject>
+#include <QThread>
+#include <QTimer>
+#include "math/batchtransform.h"
+
+class Measurement;
+
+/**
+ * @brief ticks all measurements from one thread and batches their transforms
+ *
+ * Enabled by OSM_BATCH_TRANSFORM environment variable. Measurements then don't start
+ * their own timer threads: every tick drains them all, transforms same-size fast windows
+ * as one math::BatchTransform and finishes each measurement. A measurement is locked only
+ * while it's drained and finished, its window is copied to the batch in between.
+ */
+class AnalysisScheduler : public QObject
+{
+    Q_OBJECT
+
+public:
+    static constexpr const char *ENABLE_VARIABLE = "OSM_BATCH_TRANSFORM";
+
+    static bool enabled();
+    static AnalysisScheduler *getInstance();
+
+    void add(Measurement *measurement);
+    void remove(Measurement *measurement);
+
+private slots:
+    void tick();
+
+private:
+    explicit AnalysisScheduler(QObject *parent = nullptr);
+    ~AnalysisScheduler() override;
+
+    QThread m_thread;
+    QTimer m_timer;
+
+    std::mutex m_mutex;
+    std::vector<Measurement *> m_measurements;
+    //! by transform size
+    std::map<unsigned int, math::BatchTransform> m_batches;
+};
+
+#endif // ANALYSISSCHEDULER_H
@@ -0,0 +1,172 @@
+/**
+ *  OSM
+ *  Copyright (C) 2026  Pavel Smokotnin
+
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "compactdata.h"
+#include <algorithm>
+#include <cmath>
+#include <QDebug>
+#include "chart/frequencybasedserieshelper.h"
+
+CompactData::CompactData(unsigned int pointsPerOctave) : m_pointsPerOctave(pointsPerOctave),
+    m_impulse(), m_page(), m_pageMutex()
+{
+}
+
+std::shared_ptr<const CompactData> CompactData::build(const Abstract::Data &data, unsigned int pointsPerOctave)
+{
+    std::shared_ptr<CompactData> compact(new CompactData(pointsPerOctave));
+    if (!compact->pageOut(data)) {
+        qWarning() << "compact data: full resolution couldn't be paged out";
+        return {};
+    }
+
+    auto impulse = data.impulseValues();
+    compact->m_impulse.reserve(impulse.size());
+    for (auto &value : impulse) {
+        compact->m_impulse.push_back(qfloat16(value));
+    }
+    return compact;
+}
+
+std::vector<Abstract::Data::FTData> CompactData::bands(const Abstract::Data &data, unsigned int pointsPerOctave)
+{
+    auto modules = data.modules();
+    auto magnitudes = data.magnitudesRaw();
+    auto phases = data.phases();
+    auto coherences = data.coherences();
+    auto peaks = data.peaksSquared();
+    auto means = data.meansSquared();
+
+    //band power is kept for module, peak and mean, as the server reduces data for remote clients
+    std::vector<Abstract::Data::FTData> bands;
+    float moduleSquared = 0, magnitude = 0, coherence = 0, peak = 0, mean = 0;
+    Complex phase {0, 0};
+    auto accumulate = [&](const unsigned int &i) {
+        moduleSquared += modules[i] * modules[i];
+        magnitude += magnitudes[i];
+        phase += phases[i];
+        coherence += coherences[i];
+        peak += peaks[i];
+        mean += means[i];
+    };
+    auto collected = [&](const float & start, const float & end, const unsigned int & count) {
+        auto norm = phase.abs();
+        bands.push_back({std::sqrt(start * end), std::sqrt(moduleSquared), magnitude / count,
+                         norm > 0 ? phase / norm : Complex {1, 0}, std::clamp(coherence / count, 0.f, 1.f),
+                         peak, mean});
+        moduleSquared = magnitude = coherence = peak = mean = 0;
+        phase = {0, 0};
+    };
+    Chart::FrequencyBasedSeriesHelper::iterate(data, pointsPerOctave, accumulate, collected);
+    return bands;
+}
+
+unsigned int CompactData::pointsPerOctave() const noexcept
+{
+    return m_pointsPerOctave;
+}
+
+unsigned int CompactData::timeDomainSize() const noexcept
+{
+    return m_impulse.size();
+}
+
+float CompactData::impulseValue(unsigned int i) const noexcept
+{
+    return i < m_impulse.size() ? static_cast<float>(m_impulse[i]) : 0;
+}
+
+bool CompactData::pageOut(const Abstract::Data &data)
+{
+    m_page = std::make_unique<QTemporaryFile>();
+    if (!m_page->open()) {
+        m_page.reset();
+        return false;
+    }
+
+    auto write = [this](auto span) {
+        auto bytes = static_cast<qint64>(span.size() * sizeof(*span.data()));
+        return m_page->write(reinterpret_cast<const char *>(span.data()), bytes) == bytes;
+    };
+    quint32 sizes[2] = {static_cast<quint32>(data.frequencyDomainSize()), static_cast<quint32>(data.impulseValues().size())};
+    float axis[2] = {data.impulseStart(), data.impulseStep()};
+    bool written = write(Container::span<const quint32>(sizes, 2)) && write(Container::span<const float>(axis, 2)) &&
+                   write(data.frequencies()) && write(data.modules()) && write(data.magnitudesRaw()) &&
+                   write(data.phases()) && write(data.coherences()) && write(data.peaksSquared()) &&
+                   write(data.meansSquared()) && write(data.impulseValues());
+    if (!written || !m_page->flush()) {
+        m_page.reset();
+        return false;
+    }
+
+    //! the file stays on disk, a descriptor per compact trace would exhaust the limit
+    m_page->close();
+    return true;
+}
+
+bool CompactData::pageIn(Abstract::Data &dist) const
+{
+    std::vector<Abstract::Data::FTData> ftdata;
+    std::vector<Abstract::Data::TimeData> timeData;
+
+    bool restored = false;
+    {
+        std::lock_guard<std::mutex> guard(m_pageMutex);
+        if (m_page && m_page->open()) {
+            auto read = [this](auto *data, size_t count) {
+                auto bytes = static_cast<qint64>(count * sizeof(*data));
+                return m_page->read(reinterpret_cast<char *>(data), bytes) == bytes;
+            };
+            quint32 sizes[2];
+            float axis[2];
+            restored = read(sizes, 2) && read(axis, 2);
+            if (restored) {
+                std::vector<float> frequency(sizes[0]), module(sizes[0]), magnitude(sizes[0]), coherence(sizes[0]),
+                    peak(sizes[0]), mean(sizes[0]), impulse(sizes[1]);
+                std::vector<Complex> phase(sizes[0]);
+                restored = read(frequency.data(), sizes[0]) && read(module.data(), sizes[0]) &&
+                           read(magnitude.data(), sizes[0]) && read(phase.data(), sizes[0]) &&
+                           read(coherence.data(), sizes[0]) && read(peak.data(), sizes[0]) &&
+                           read(mean.data(), sizes[0]) && read(impulse.data(), sizes[1]);
+
+                ftdata.reserve(sizes[0]);
+                for (quint32 i = 0; i < sizes[0]; ++i) {
+                    ftdata.push_back({frequency[i], module[i], magnitude[i], phase[i], coherence[i], peak[i], mean[i]});
+                }
+                timeData.reserve(sizes[1]);
+                for (quint32 i = 0; i < sizes[1]; ++i) {
+                    timeData.push_back({axis[0] + i * axis[1], impulse[i]});
+                }
+            }
+            m_page->close();
+        }
+    }
+
+    if (!restored) {
+        qWarning() << "compact data: full resolution is lost, bands are kept";
+        auto start = dist.impulseStart(), step = dist.impulseStep();
+        timeData.clear();
+        timeData.reserve(timeDomainSize());
+        for (unsigned int i = 0; i < timeDomainSize(); ++i) {
+            timeData.push_back({start + i * step, impulseValue(i)});
+        }
+    } else {
+        dist.setFrequencyDomainData(std::move(ftdata));
+    }
+    dist.setTimeDomainData(std::move(timeData));
+    return restored;
+}
@@ -0,0 +1,63 @@
+/**
+ *  OSM
+ *  Copyright (C) 2026  Pavel Smokotnin
+
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef COMPACTDATA_H
+#define COMPACTDATA_H
+
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <QTemporaryFile>
+#include <qfloat16.h>
+#include "abstract/data.h"
+
+/**
+ * @brief compact copy of a data
+ * Spectrum is reduced to log-spaced float bands which the owner keeps in its planes, the impulse is kept
+ * here as float16. Full resolution planes are paged out to a temporary file and restored on demand,
+ * the file is closed between the accesses. Immutable once built, shared between clones.
+ */
+class CompactData
+{
+public:
+    //! nullptr if the full resolution couldn't be paged out
+    static std::shared_ptr<const CompactData> build(const Abstract::Data &data, unsigned int pointsPerOctave);
+
+    //! log-spaced bands of the data, at geometric band centers
+    static std::vector<Abstract::Data::FTData> bands(const Abstract::Data &data, unsigned int pointsPerOctave);
+
+    unsigned int    pointsPerOctave() const noexcept;
+
+    unsigned int    timeDomainSize() const noexcept;
+    float           impulseValue(unsigned int i) const noexcept;
+
+    //! restore full resolution to dist, only the float16 impulse is restored if the page is lost
+    bool pageIn(Abstract::Data &dist) const;
+
+private:
+    CompactData(unsigned int pointsPerOctave);
+
+    bool pageOut(const Abstract::Data &data);
+
+    unsigned int            m_pointsPerOctave;
+    std::vector<qfloat16>   m_impulse;
+
+    std::unique_ptr<QTemporaryFile> m_page;
+    mutable std::mutex      m_pageMutex;
+};
+
+#endif // COMPACTDATA_H
@@ -19,6 +19,7 @@
 
 #include "equalizer.h"
 #include "source/filtersource.h"
+#include "math/complexkernel.h"
 
 namespace Source {
 
@@ -179,6 +180,8 @@ void Equalizer::doUpdate()
         for (auto &s : sources) {
             if (s && s.get() != this) s->lock();
         }
+        //the result is on the frequency axis of the primary source
+        shareFrequencies(*primary);
 
         calc(primary);
 
@@ -203,24 +206,26 @@ void Equalizer::calc(const Shared::Source &primary) noexcept
                 magnitude *= (*it)->magnitudeRaw(i);
                 module    *= (*it)->magnitudeRaw(i);
                 coherence  = std::min(coherence, (*it)->coherence(i));
-                phase.polar(phase.arg() + (*it)->phase(i).arg());
+                //arguments add up, a zero phase has no argument and is skipped instead of zeroing the product
+                auto factor = (*it)->phase(i);
+                if (factor.abs() > 0) {
+                    phase *= factor.normalize();
+                }
             }
         }
         if (std::isnan(phase.real) || std::isnan(phase.imag)) {
             phase = {1, 0};
         }
 
-        m_ftdata[i].frequency  = primary->frequency(i);
-        m_ftdata[i].module     = module;
-        m_ftdata[i].phase      = phase.normalize();
-        m_ftdata[i].magnitude  = magnitude;
-        m_ftdata[i].coherence  = coherence;
+        m_module[i]     = module;
+        m_phase[i]      = phase;
+        m_magnitude[i]  = magnitude;
+        m_coherence[i]  = coherence;
     }
+    math::ComplexKernel::normalize(m_phase, m_phase);
 
-    for (unsigned int i = 0; i < primary->timeDomainSize(); i++) {
-        m_impulseData[i].time = primary->impulseTime(i);
-        m_impulseData[i].value = NAN;
-    }
+    setImpulseTimeAxis(primary->impulseTime(0), primary->impulseTime(1) - primary->impulseTime(0));
+    std::fill(m_impulse.begin(), m_impulse.end(), NAN);
 }
 
 void Equalizer::postFilterAppended(const Shared::Source &source)
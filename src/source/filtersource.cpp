@@ -122,6 +122,11 @@ void FilterSource::update()
                 setTimeDomainSize(pow(2, M::m_FFTsizes.at(M::FFT12)));
                 break;
 
+            case M::Mode::CQT:
+                m_dataFT.setType(FourierTransform::MultiRate);
+                setTimeDomainSize(pow(2, M::m_FFTsizes.at(M::FFT12)));
+                break;
+
             default:
                 m_dataFT.setType(FourierTransform::Fast);
                 m_dataFT.setSize(pow(2, M::m_FFTsizes.at(mode())));
@@ -146,11 +151,11 @@ void FilterSource::update()
         for (auto frequency : frequencyList) {
             auto H = calculate(frequency);
 
-            m_ftdata[i].frequency   = frequency;
-            m_ftdata[i].module      = H.abs();
-            m_ftdata[i].coherence   = 1.f;
-            m_ftdata[i].magnitude   = H.abs();
-            m_ftdata[i].phase       = H.normalize();
+            m_frequency[i]   = frequency;
+            m_module[i]      = H.abs();
+            m_coherence[i]   = 1.f;
+            m_magnitude[i]   = H.abs();
+            m_phase[i]       = H.normalize();
             ++i;
         }
 
@@ -169,14 +174,14 @@ void FilterSource::update()
         int t = 0;
         float kt = 1000.f / sampleRate();
         auto norm = 1.f / timeDomainSize();
+        setImpulseTimeAxis(-static_cast<int>(timeDomainSize() / 2 - 1) * kt, kt);
         for (unsigned int i = 0, j = timeDomainSize() / 2 - 1; i < timeDomainSize(); i++, j++, t++) {
             if (t > static_cast<int>(timeDomainSize() / 2)) {
                 t -= static_cast<int>(timeDomainSize());
                 j -= timeDomainSize();
             }
 
-            m_impulseData[j].value = m_inverse.af(i).real * norm;
-            m_impulseData[j].time  = t * kt;//ms
+            m_impulse[j] = m_inverse.af(i).real * norm;
         }
     }
     emit readyRead();
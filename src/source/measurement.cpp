@@ -23,11 +23,13 @@
 #include <algorithm>
 #include <utility>
 #include "measurement.h"
+#include "analysisscheduler.h"
 #include "audio/client.h"
 #include "generator/generatorthread.h"
 #include "math/notch.h"
 #include "math/bandpass.h"
 #include "math/lowpassfilter.h"
+#include "common/trace.h"
 
 Measurement::Measurement(QObject *parent) : Abstract::Source(parent), Meta::Measurement(),
     m_timer(nullptr), m_timerThread(nullptr),
@@ -36,11 +38,12 @@ Measurement::Measurement(QObject *parent) : Abstract::Source(parent), Meta::Meas
     m_audioStream(nullptr),
     m_settings(nullptr),//TODO: alean and remove
     m_currentMode(Mode::FFT10),
-    m_workingDelay(0), m_delayFinderCounter(0),
-    m_estimatedDelay(0),
+    m_currentOverlap(NoOverlap),
+    m_resetDelay(false), m_workingDelay(0), m_hopCounter(0), m_spectrumPending(false),
+    m_estimatedDelay(0), m_estimatedConfidence(0),
     m_error(false), m_onReset(false),
     m_data(65536), m_reference(65536), m_loopBuffer(65536),
-    m_enableCalibration(false), m_calibrationLoaded(false), m_calibrationList(), m_calibrationGain()
+    m_enableCalibration(false), m_calibrationLoaded(false), m_calibrationList()
 {
     setName("Measurement");
     setObjectName(name());
@@ -80,13 +83,15 @@ Measurement::Measurement(QObject *parent) : Abstract::Source(parent), Meta::Meas
     m_moduleLPFs.resize(frequencyDomainSize());
     m_magnitudeLPFs.resize(frequencyDomainSize());
     m_phaseLPFs.resize(frequencyDomainSize());
-    m_meters.resize(frequencyDomainSize());
+    m_binMeter.setSize(frequencyDomainSize());
+    m_binMagnitude.resize(frequencyDomainSize());
+    m_binModule.resize(frequencyDomainSize());
+    m_binPhase.resize(frequencyDomainSize());
+    m_binSquared.resize(frequencyDomainSize());
 
     m_deconvolution.setSize(timeDomainSize());
     m_deconvolution.setWindowFunctionType(m_windowFunctionType);
-    m_delayFinder.setSize(pow(2, 16));
-    m_delayFinder.setWindowFunctionType(m_windowFunctionType);
-    m_impulseData.resize(timeDomainSize());
+    m_impulse.resize(timeDomainSize());
     m_deconvLPFs.resize(timeDomainSize());
     m_deconvAvg.setSize(timeDomainSize());
     m_deconvAvg.reset();
@@ -103,23 +108,33 @@ Measurement::Measurement(QObject *parent) : Abstract::Source(parent), Meta::Meas
     connect(GeneratorThread::getInstance(), &GeneratorThread::enabledChanged, this, &Measurement::resetLoopBuffer,
             Qt::DirectConnection);
 
+    //only a flag for the transform thread: the timer thread isn't started in the batch mode
     auto refreshDelays = [this]() {
         m_resetDelay = true;
     };
-    connect(this, &Measurement::dataChanelChanged, &m_timer, refreshDelays);
-    connect(this, &Measurement::referenceChanelChanged, &m_timer, refreshDelays);
-    connect(this, &Measurement::deviceIdChanged, &m_timer, refreshDelays);
+    connect(this, &Measurement::dataChanelChanged, this, refreshDelays, Qt::DirectConnection);
+    connect(this, &Measurement::referenceChanelChanged, this, refreshDelays, Qt::DirectConnection);
+    connect(this, &Measurement::deviceIdChanged, this, refreshDelays, Qt::DirectConnection);
+    connect(this, &Measurement::dataChanelChanged, this, &Measurement::updateSubscription);
+    connect(this, &Measurement::referenceChanelChanged, this, &Measurement::updateSubscription);
 
     connect(this, &Measurement::averageChanged, this, &Measurement::updateAverage);
     connect(this, &Measurement::windowFunctionTypeChanged, this, &Measurement::updateWindowFunction);
     connect(this, &Measurement::filtersFrequencyChanged, this, &Measurement::updateFilterFrequency);
     connect(this, &Measurement::inputFilterChanged, this, &Measurement::applyInputFilters);
 
-    m_timerThread.start();
+    if (AnalysisScheduler::enabled()) {
+        AnalysisScheduler::getInstance()->add(this);
+    } else {
+        m_timerThread.start();
+    }
     this->setActive(true);
 }
 Measurement::~Measurement()
 {
+    if (AnalysisScheduler::enabled()) {
+        AnalysisScheduler::getInstance()->remove(this);
+    }
     this->setActive(false);
 
     m_timerThread.quit();
@@ -141,6 +156,7 @@ QJsonObject Measurement::toJSON() const noexcept
     data["deviceName"]      = deviceName();
     data["mode"]            = mode();
     data["inputFilters"]    = static_cast<int>(inputFilter());
+    data["overlap"]         = static_cast<int>(overlap());
 
     QJsonObject calibration;
     calibration["enabled"] = m_enableCalibration;
@@ -181,6 +197,7 @@ void Measurement::fromJSON(QJsonObject data, const SourceList *list) noexcept
     setPolarity(         data["polarity"         ].toBool(polarity()));
     selectDevice(        data["deviceName"       ].toString(deviceName()));
     setInputFilter(      data["inputFilters"     ].toInt(inputFilter()));
+    setOverlap(          data["overlap"          ].toInt(overlap()));
 
     QJsonObject calibration = data["calibration"].toObject();
     if (!calibration.isEmpty()) {
@@ -224,6 +241,10 @@ float Measurement::referenceLevel() const
 {
     return m_levelMeters.m_reference.dB();
 }
+const math::LevelHistory *Measurement::levelHistory() const noexcept
+{
+    return &m_levelMeters.m_history;
+}
 float Measurement::measurementPeak() const
 {
     return m_levelMeters.m_meters.at({Weighting::Z, Meter::Slow}).peakdB();
@@ -238,6 +259,7 @@ void Measurement::updateFftPower()
 {
     if (Q_LIKELY(m_mode == m_currentMode)) return;
     m_currentMode = m_mode;
+    m_hopCounter = 0;
 
     switch (m_currentMode) {
     case Mode::LFT:
@@ -245,6 +267,11 @@ void Measurement::updateFftPower()
         setTimeDomainSize(pow(2, m_FFTsizes.at(FFT12)));
         break;
 
+    case Mode::CQT:
+        m_dataFT.setType(FourierTransform::MultiRate);
+        setTimeDomainSize(pow(2, m_FFTsizes.at(FFT12)));
+        break;
+
     default:
         m_dataFT.setSize(pow(2, m_FFTsizes.at(m_currentMode)));
         m_dataFT.setType(FourierTransform::Fast);
@@ -264,7 +291,11 @@ void Measurement::updateFftPower()
     m_moduleLPFs.resize(frequencyDomainSize());
     m_magnitudeLPFs.resize(frequencyDomainSize());
     m_phaseLPFs.resize(frequencyDomainSize());
-    m_meters.resize(frequencyDomainSize());
+    m_binMeter.setSize(frequencyDomainSize());
+    m_binMagnitude.resize(frequencyDomainSize());
+    m_binModule.resize(frequencyDomainSize());
+    m_binPhase.resize(frequencyDomainSize());
+    m_binSquared.resize(frequencyDomainSize());
 
     // Deconvolution:
     m_deconvolution.setSize(timeDomainSize());
@@ -340,6 +371,7 @@ void Measurement::onSampleRateChanged()
         m_dataFT.setSampleRate(sampleRate());
         m_dataFT.prepare();
         m_levelMeters.setSampleRate(sampleRate());
+        m_delayFinder.setSampleRate(sampleRate());
         calculateDataLength();
         updateFilterFrequency();
         applyInputFilters();
@@ -380,8 +412,10 @@ void Measurement::calculateDataLength()
     setFrequencyDomainSize(frequencyList.size());
     unsigned int i = 0;
     for (auto frequency : frequencyList) {
-        m_ftdata[i++].frequency = frequency;
+        m_frequency[i++] = frequency;
     }
+    internFrequencies();
+    m_spectrumKernel.setSize(frequencyDomainSize());
     applyCalibration();
 }
 void Measurement::setActive(bool newActive)
@@ -423,11 +457,10 @@ void Measurement::resetLoopBuffer()
 //this calls from timer thread
 void Measurement::updateDelay()
 {
-    if (m_resetDelay) {
+    if (m_resetDelay.exchange(false)) {
         m_workingDelay = 0;
         m_reference.reset();
         m_data.reset();
-        m_resetDelay = false;
     }
     if (m_workingDelay != m_delay) {
         long delta = static_cast<long>(m_workingDelay) - static_cast<long>(m_delay);
@@ -456,7 +489,6 @@ void Measurement::updateWindowFunction()
 {
     m_dataFT.setWindowFunctionType(m_windowFunctionType);
     m_deconvolution.setWindowFunctionType(m_windowFunctionType);
-    m_delayFinder.setWindowFunctionType(m_windowFunctionType);
     {
         std::lock_guard<std::mutex> guard(m_dataMutex);
         m_dataFT.prepare();
@@ -467,6 +499,7 @@ void Measurement::writeData(const char *data, qint64 len)
     if (!m_audioStream || m_onReset.load() || !active()) {
         return;
     }
+    Trace::Scope trace(Trace::WriteData);
     std::lock_guard<std::mutex> guard(m_dataMutex);
     if (!m_audioStream) {
         return;
@@ -512,18 +545,70 @@ void Measurement::writeData(const char *data, qint64 len)
     }
 
 }
+
+void Measurement::writeChannels(const float *const *channels, size_t frames)
+{
+    if (!m_audioStream || m_onReset.load() || !active()) {
+        return;
+    }
+    Trace::Scope trace(Trace::WriteData);
+    std::lock_guard<std::mutex> guard(m_dataMutex);
+    if (!m_audioStream) {
+        return;
+    }
+    //channels are subscribed as {data, reference}, nullptr for channels out of the device
+    auto data = channels[0], reference = channels[1];
+    bool loopAvailable = m_loopBuffer.collected() >= m_audioStream->depth() * frames;
+    float sample, loopSample;
+    for (size_t i = 0; i < frames; ++i) {
+        loopSample = loopAvailable ? m_loopBuffer.read() : 0;
+
+        if (data) {
+            sample = data[i];
+            m_data.write(m_polarity ? -m_gain *sample : sample * m_gain);
+            m_levelMeters.add(sample * m_gain);
+        } else {
+            m_data.write(loopSample * m_gain);
+            m_levelMeters.add(loopSample * m_gain);
+        }
+
+        sample = reference ? reference[i] : loopSample;
+        m_reference.write(sample * m_offset);
+        m_levelMeters.addToReference(sample * m_offset);
+    }
+}
 void Measurement::transform()
 {
     if (!active() || m_error)
         return;
 
+    Trace::Scope trace(Trace::Transform);
+    if (!beginTransform()) {
+        return;
+    }
+    if (auto ft = pendingTransform()) {
+        ft->transform();
+    }
+    endTransform();
+}
+bool Measurement::beginTransform()
+{
+    if (!active() || m_error)
+        return false;
+
     lock();
     updateFftPower();
     updateDelay();
+    if (m_currentOverlap != overlap()) {
+        m_currentOverlap = overlap();
+        m_hopCounter = 0;
+    }
 
     float d, r;
     auto filterM = m_inputFilters.first;
     auto filterR = m_inputFilters.second;
+    const unsigned int hop = hopSize();
+    unsigned int hops = 0;
 
     while (m_data.collected() > 0 && m_reference.collected() > 0) {
         d = m_data.read();
@@ -539,105 +624,137 @@ void Measurement::transform()
         m_dataFT.add(d, r);
         m_deconvolution.add(d, r);
         m_delayFinder.add(d, r);
+
+        //every hop of the overlap feeds the spectrum accumulators
+        if (hop && ++m_hopCounter >= hop) {
+            m_hopCounter = 0;
+            m_dataFT.transform();
+            averageSpectrum();
+            ++hops;
+        }
+    }
+    m_spectrumPending = (hops == 0);
+    return true;
+}
+FourierTransform *Measurement::pendingTransform() noexcept
+{
+    return m_spectrumPending ? &m_dataFT : nullptr;
+}
+void Measurement::endTransform()
+{
+    //the forward spectrum is shared only if it was taken at the last sample, otherwise the deconvolution runs its own
+    bool current = m_spectrumPending || m_hopCounter == 0;
+    if (m_spectrumPending) {
+        averageSpectrum();
+        m_spectrumPending = false;
     }
-    m_dataFT.transform();
-    m_deconvolution.transform(&m_dataFT);
-    if ((++m_delayFinderCounter % 25) == 0) {
-        m_delayFinder.transform(nullptr);
-        m_delayFinderCounter = 0;
+    m_deconvolution.transform(current ? &m_dataFT : nullptr);
+    if (m_delayFinder.step()) {
+        m_estimatedDelay = m_delayFinder.delay();
+        m_estimatedConfidence = m_delayFinder.confidence();
+        emit estimatedChanged();
     }
-    averaging();
+    averageImpulse();
     unlock();
     emit readyRead();
     emit levelChanged();
     emit referenceLevelChanged();
 }
-void Measurement::averaging()
+unsigned int Measurement::hopSize() const noexcept
 {
-    Complex p;
-    int j;
-    for (unsigned int i = 0; i < frequencyDomainSize() ; i++) {
-
-        j = static_cast<int>(i);
-        float calibratedA = M_SQRT2 * m_dataFT.af(i).abs();
-        float calibratedB = M_SQRT2 * m_dataFT.bf(i).abs();
-        //TODO: think and do
-        //if (calibratedA < someThresholdInDb ) continue;
+    if (m_currentMode == LFT || m_currentMode == CQT) {
+        return 0;
+    }
+    switch (overlap()) {
+    case HalfOverlap:
+        return m_dataFT.size() / 2;
+    case ThreeQuarterOverlap:
+        return m_dataFT.size() / 4;
+    case NoOverlap:
+        break;
+    }
+    return 0;
+}
+void Measurement::averageSpectrum()
+{
+    Trace::Scope trace(Trace::Averaging);
+    const auto size = frequencyDomainSize();
+    const bool calibrate = m_enableCalibration && m_calibrationLoaded;
+    const bool direct = averageType() == AverageType::Off;
+
+    float *magnitude = direct ? m_magnitude.data() : m_binMagnitude.data();
+    float *module    = direct ? m_module.data()    : m_binModule.data();
+    Complex *phase   = direct ? m_phase.data()     : m_binPhase.data();
+
+    //blocks keep the transform results in cache for the coherence pass
+    m_coherence.next();
+    for (unsigned int from = 0; from < size; from += SPECTRUM_BLOCK) {
+        auto count = std::min(SPECTRUM_BLOCK, size - from);
+        m_spectrumKernel.process(m_dataFT.afData(), m_dataFT.bfData(), from, count, calibrate,
+                                 magnitude, module, phase, m_binSquared.data());
+        m_coherence.calculate(Abstract::Data::m_coherence.data(), &m_dataFT, from, from + count);
+    }
 
-        if (m_enableCalibration && m_calibrationGain.size() > j) {
-            calibratedA /= m_calibrationGain[j];
-        }
-        if (m_enableCalibration && m_calibrationGain.size() > j && !qFuzzyCompare(m_calibrationPhase[j], 0)) {
-            p.polar(m_dataFT.bf(i).arg() - m_dataFT.af(i).arg() - m_calibrationPhase[j]);
-        } else {
-            p.polar(m_dataFT.bf(i), m_dataFT.af(i));
-        }
+    switch (averageType()) {
+    case AverageType::Off:
+        break;
 
-        float magnitude = calibratedA / calibratedB;
-#ifdef WIN64
-        if (magnitude / 0.f == magnitude) {
-#else
-        if (std::isnan(magnitude) || std::isinf(magnitude)) {
-#endif
-            magnitude = 0.f;
+    case AverageType::LPF:
+        for (unsigned int i = 0; i < size; ++i) {
+            m_magnitude[i] = m_magnitudeLPFs[i](m_binMagnitude[i]);
+            m_module[i]    = m_moduleLPFs[i](m_binModule[i]);
+            m_phase[i]     = m_phaseLPFs[i](m_binPhase[i]);
         }
+        break;
 
-        switch (averageType()) {
-        case AverageType::Off:
-            m_ftdata[i].magnitude = magnitude;
-            m_ftdata[i].module    = calibratedA;
-            m_ftdata[i].phase     = p;
-            break;
-
-        case AverageType::LPF:
-            m_ftdata[i].magnitude = m_magnitudeLPFs[i](magnitude);
-            m_ftdata[i].module    = m_moduleLPFs[i](calibratedA);
-            m_ftdata[i].phase     = m_phaseLPFs[i](p);
-            break;
-
-        case AverageType::FIFO:
-            m_magnitudeAvg.append(i, magnitude );
-            m_moduleAvg.append(i,    calibratedA );
-            m_pahseAvg.append(i,     p);
+    case AverageType::FIFO:
+        for (unsigned int i = 0; i < size; ++i) {
+            m_magnitudeAvg.append(i, m_binMagnitude[i]);
+            m_moduleAvg.append(i,    m_binModule[i]);
+            m_pahseAvg.append(i,     m_binPhase[i]);
 
-            m_ftdata[i].magnitude = m_magnitudeAvg.value(i);
-            m_ftdata[i].module    = m_moduleAvg.value(i);
-            m_ftdata[i].phase     = m_pahseAvg.value(i);
-            break;
+            m_magnitude[i] = m_magnitudeAvg.value(i);
+            m_module[i]    = m_moduleAvg.value(i);
+            m_phase[i]     = m_pahseAvg.value(i);
         }
-
-        m_meters[i].add(calibratedA);
-        m_ftdata[i].peakSquared = m_meters[i].peakSquared();
-        m_ftdata[i].meanSquared = m_meters[i].value();
+        break;
     }
-    m_coherence.calculate(m_ftdata.data(), &m_dataFT);
-
-    int t = 0;
+    m_binMeter.add(m_binSquared.data(), m_peakSquared.data(), m_meanSquared.data());
+}
+void Measurement::averageImpulse()
+{
+    Trace::Scope trace(Trace::Averaging);
+    const unsigned int size = timeDomainSize(), half = size / 2;
     float kt = 1000.f / sampleRate();
-    for (unsigned int i = 0, j = timeDomainSize() / 2 - 1; i < timeDomainSize(); i++, j++, t++) {
+    setImpulseTimeAxis(-static_cast<int>(half - 1) * kt, kt);
 
-        if (t > static_cast<int>(timeDomainSize() / 2)) {
-            t -= static_cast<int>(timeDomainSize());
-            j -= timeDomainSize();
+    //the upper part of the deconvolution is the negative time, it goes first
+    auto reorder = [this, size, half](auto &&value) {
+        for (unsigned int i = 0; i <= half; ++i) {
+            m_impulse[i + half - 1] = value(i);
+        }
+        for (unsigned int i = half + 1; i < size; ++i) {
+            m_impulse[i - half - 1] = value(i);
         }
+    };
 
-        switch (averageType()) {
-        case AverageType::Off:
-            m_impulseData[j].value.real = m_deconvolution.get(i);
-            break;
-        case AverageType::LPF:
-            m_impulseData[j].value.real = m_deconvLPFs[i](m_deconvolution.get(i));
-            break;
-        case AverageType::FIFO:
+    switch (averageType()) {
+    case AverageType::Off:
+        reorder([this](unsigned int i) {
+            return m_deconvolution.get(i);
+        });
+        break;
+    case AverageType::LPF:
+        reorder([this](unsigned int i) {
+            return m_deconvLPFs[i](m_deconvolution.get(i));
+        });
+        break;
+    case AverageType::FIFO:
+        reorder([this](unsigned int i) {
             m_deconvAvg.append(i, m_deconvolution.get(i));
-            m_impulseData[j].value.real = m_deconvAvg.value(i);
-            break;
-        }
-        m_impulseData[j].time  = t * kt;//ms
-    }
-    if (m_estimatedDelay != m_delayFinder.maxIndex()) {
-        m_estimatedDelay = m_delayFinder.maxIndex();
-        emit estimatedChanged();
+            return m_deconvAvg.value(i);
+        });
+        break;
     }
 }
 Shared::Source Measurement::store()
@@ -677,6 +794,9 @@ Shared::Source Measurement::store()
     case LFT:
         modeNote = "FT log time window";
         break;
+    case CQT:
+        modeNote = "FT multi-rate log time window";
+        break;
     default:
         modeNote = "FFT power " + modeName();
     }
@@ -712,6 +832,7 @@ Shared::Source Measurement::clone() const
     cloned->setDataChanel(dataChanel());
     cloned->setReferenceChanel(referenceChanel());
     cloned->setWindowFunctionType(windowFunctionType());
+    cloned->setOverlap(overlap());
 
     cloned->setCalibration(calibration());
     cloned->m_calibrationList = m_calibrationList;
@@ -729,18 +850,16 @@ Shared::Source Measurement::clone() const
 }
 long Measurement::estimated() const noexcept
 {
-    if (m_estimatedDelay > m_delayFinder.size() / 2) {
-        return m_estimatedDelay - m_delayFinder.size() + static_cast<long>(m_workingDelay);
-    }
     return m_estimatedDelay + static_cast<long>(m_workingDelay);
 }
 long Measurement::estimatedDelta() const noexcept
 {
-    if (m_estimatedDelay > m_delayFinder.size() / 2) {
-        return m_estimatedDelay - m_delayFinder.size();
-    }
     return m_estimatedDelay;
 }
+float Measurement::estimatedConfidence() const noexcept
+{
+    return m_estimatedConfidence;
+}
 bool Measurement::calibration() const noexcept
 {
     return m_enableCalibration;
@@ -803,8 +922,9 @@ void Measurement::applyCalibration()
     if (!m_calibrationLoaded || !m_calibrationList.size())
         return;
 
-    m_calibrationGain.resize(static_cast<int>(frequencyDomainSize()));
-    m_calibrationPhase.resize(static_cast<int>(frequencyDomainSize()));
+    if (m_spectrumKernel.size() != frequencyDomainSize()) {
+        m_spectrumKernel.setSize(frequencyDomainSize());
+    }
 
     QVector<float> last = m_calibrationList[0];
     last[0] = 0.f;
@@ -817,7 +937,7 @@ void Measurement::applyCalibration()
     bool inList = false;
     for (int i = 0; i < static_cast<int>(frequencyDomainSize()); ++i) {
 
-        while (m_ftdata[i].frequency > m_calibrationList[j][0]) {
+        while (frequency(i) > m_calibrationList[j][0]) {
             last = m_calibrationList[j];
             if (j + 1 < m_calibrationList.size()) {
                 ++j;
@@ -842,15 +962,14 @@ void Measurement::applyCalibration()
             kp = (p2 - p1) / (f2 - f1);
             bp = p2 - f2 * kp;
 
-            g = kg * m_ftdata[i].frequency + bg;
-            p = kp * m_ftdata[i].frequency + bp;
+            g = kg * frequency(i) + bg;
+            p = kp * frequency(i) + bp;
         } else {
             g = m_calibrationList[j][1];
             p = m_calibrationList[j][2];
         }
 
-        m_calibrationGain[i] = pow(10.f, 0.05f * g);
-        m_calibrationPhase[i] = p * static_cast<float>(M_PI / 180.0);
+        m_spectrumKernel.setCalibration(i, pow(10.f, 0.05f * g), p * static_cast<float>(M_PI / 180.0));
     }
 }
 void Measurement::updateAudio()
@@ -875,10 +994,20 @@ void Measurement::updateAudio()
                 return;
             }
             connect(m_audioStream, &audio::Stream::sampleRateChanged, this, &Measurement::onSampleRateChanged);
+            updateSubscription();
             emit audioFormatChanged();
         });
     }
 }
+
+void Measurement::updateSubscription()
+{
+    if (m_audioStream) {
+        m_audioStream->subscribe({dataChanel(), referenceChanel()}, [this](const float *const *channels, size_t frames) {
+            writeChannels(channels, frames);
+        });
+    }
+}
 void Measurement::checkChannels()
 {
     audio::Format format = audio::Client::getInstance()->deviceInputFormat(m_deviceId);
@@ -916,7 +1045,7 @@ void Measurement::resetAverage() noexcept
     m_deconvLPFs.each(reset);
     m_phaseLPFs.each(reset);
 
-    m_meters.each(reset);
+    m_binMeter.reset();
     m_loopBuffer.reset();
     m_levelMeters.reset();
 
@@ -932,6 +1061,13 @@ Measurement::Meters::Meters() : m_reference(Weighting::Z, Meter::Slow)
             m_meters[key] = meter;
         }
     }
+    //the map isn't changed anymore, its nodes stay in place
+    for (std::size_t i = 0; i < math::LevelHistory::CURVES; ++i) {
+        auto curve = Weighting::allCurves[i];
+        m_weightings[i].setCurve(curve);
+        m_fast[i] = &m_meters.at({curve, Meter::Fast});
+        m_slow[i] = &m_meters.at({curve, Meter::Slow});
+    }
 }
 
 void Measurement::Meters::addToReference(const float &value)
@@ -944,16 +1080,33 @@ void Measurement::Meters::setSampleRate(unsigned int sampleRate)
     for (auto &&meter : m_meters) {
         meter.second.setSampleRate(sampleRate);
     }
+    for (auto &weighting : m_weightings) {
+        weighting.setSampleRate(sampleRate);
+    }
     m_reference.setSampleRate(sampleRate);
+    m_history.setSampleRate(sampleRate);
 }
 
 void Measurement::Meters::add(float value)
 {
+    m_history.applyReset();
     if (auto filter = m_filter) {
         value = filter->operator()(value);
     }
-    for (auto &&meter : m_meters) {
-        meter.second.add(value);
+    for (std::size_t i = 0; i < math::LevelHistory::CURVES; ++i) {
+        Meter::data_t squared = std::pow(m_weightings[i](value), 2);
+        m_fast[i]->addSquared(squared);
+        m_slow[i]->addSquared(squared);
+        m_history.add(i, std::isnan(squared) ? 0 : squared);
+    }
+
+    if (m_history.sampleAdded()) {
+        std::array<float, math::LevelHistory::CURVES> fast, slow;
+        for (std::size_t i = 0; i < math::LevelHistory::CURVES; ++i) {
+            fast[i] = m_fast[i]->dB();
+            slow[i] = m_slow[i]->dB();
+        }
+        m_history.push(fast, slow);
     }
 }
 
@@ -963,4 +1116,5 @@ void Measurement::Meters::reset()
         meter.second.reset();
     }
     m_reference.reset();
+    m_history.reset();
 }
@@ -30,9 +30,13 @@
 #include "abstract/source.h"
 #include "stored.h"
 #include "math/meter.h"
+#include "math/binmeter.h"
+#include "math/spectrumkernel.h"
+#include "math/levelhistory.h"
 #include "math/averaging.h"
 #include "math/fouriertransform.h"
 #include "math/deconvolution.h"
+#include "math/delayfinder.h"
 #include "math/bessellpf.h"
 #include "math/coherence.h"
 #include "math/filter.h"
@@ -63,6 +67,7 @@ class Measurement : public Abstract::Source, public Meta::Measurement
     Q_PROPERTY(QVariant modes READ getAvailableModes CONSTANT)
     Q_PROPERTY(QVariant inputFilters READ getAvailableInputFilters CONSTANT)
     Q_PROPERTY(QVariant windows READ getAvailableWindowTypes CONSTANT)
+    Q_PROPERTY(QVariant overlaps READ getAvailableOverlaps CONSTANT)
 
     //local properties
     Q_PROPERTY(QString deviceId READ deviceId WRITE setDeviceId NOTIFY deviceIdChanged REVISION NO_API_REVISION)
@@ -76,6 +81,7 @@ class Measurement : public Abstract::Source, public Meta::Measurement
 
     Q_PROPERTY(long estimated READ estimated NOTIFY estimatedChanged)
     Q_PROPERTY(long estimatedDelta READ estimatedDelta NOTIFY estimatedChanged)
+    Q_PROPERTY(float estimatedConfidence READ estimatedConfidence NOTIFY estimatedChanged REVISION NO_API_REVISION)
 
     Q_PROPERTY(bool error MEMBER m_error NOTIFY errorChanged)
 
@@ -84,6 +90,7 @@ class Measurement : public Abstract::Source, public Meta::Measurement
     Q_PROPERTY(bool calibration READ calibration WRITE setCalibration NOTIFY calibrationChanged)
 
     Q_PROPERTY(Meta::Measurement::InputFilter inputFilter READ inputFilter WRITE setInputFilter NOTIFY inputFilterChanged)
+    Q_PROPERTY(Meta::Measurement::Overlap overlap READ overlap WRITE setOverlap NOTIFY overlapChanged)
 
 public:
     explicit Measurement(QObject *parent = nullptr);
@@ -101,6 +108,7 @@ public:
     float level(const Weighting::Curve curve = Weighting::Z, const Meter::Time time = Meter::Fast) const override;
     float peak(const Weighting::Curve curve = Weighting::Z, const Meter::Time time = Meter::Fast) const override;
     float referenceLevel() const override;
+    const math::LevelHistory *levelHistory() const noexcept override;
 
     float measurementPeak() const;
     float referencePeak() const;
@@ -110,6 +118,7 @@ public:
 
     long estimated() const noexcept;
     long estimatedDelta() const noexcept;
+    float estimatedConfidence() const noexcept;
 
     bool calibration() const noexcept;
     bool calibrationLoaded() const noexcept;
@@ -124,10 +133,19 @@ public:
     Q_INVOKABLE void applyAutoGain(const float reference) override;
     Q_INVOKABLE void destroy() override final;
 
+    //! locks and drains the input, false if there is nothing to transform
+    //! the caller may unlock() while the pending window is transformed elsewhere and lock() again before endTransform()
+    bool beginTransform();
+    //! the window to transform before endTransform(), nullptr if the overlap hops covered it
+    FourierTransform *pendingTransform() noexcept;
+    //! averages the transform results, unlocks and notifies
+    void endTransform();
+
 public slots:
     void transform();
     void onSampleRateChanged();
     void writeData(const char *data, qint64 len);
+    void writeChannels(const float *const *channels, size_t frames);
     void setError();
     void newSampleFromGenerator(float sample);
     void resetLoopBuffer();
@@ -141,6 +159,9 @@ protected slots:
     void applyInputFilters();
 
 private:
+    //! bins per kernel and coherence block, a multiple of 4
+    static constexpr unsigned int SPECTRUM_BLOCK = 256;
+
     QTimer m_timer;
     QThread m_timerThread;
     InputDevice m_input;
@@ -150,19 +171,26 @@ private:
 
     Settings *m_settings;
     Mode m_currentMode;
+    Overlap m_currentOverlap;
 
-    bool m_resetDelay;
+    std::atomic<bool> m_resetDelay;
     int m_workingDelay;
-    unsigned int m_delayFinderCounter;
+    unsigned int m_hopCounter;
+    bool m_spectrumPending;
     long m_estimatedDelay;
+    float m_estimatedConfidence;
     bool m_error;
     std::atomic<bool>       m_onReset;
 
     Container::Circular<float> m_data, m_reference, m_loopBuffer;
     struct Meters {
         std::unordered_map<::Abstract::LevelsData::Key, Meter, ::Abstract::LevelsData::Key::Hash> m_meters;
+        //! one weighting per curve feeds its fast and slow meters and the history
+        std::array<Weighting, math::LevelHistory::CURVES> m_weightings;
+        std::array<Meter *, math::LevelHistory::CURVES> m_fast, m_slow;
         Meter m_reference;
         std::shared_ptr<math::Filter> m_filter;
+        math::LevelHistory m_history;
 
         Meters();
         void setSampleRate(unsigned int sampleRate);
@@ -172,7 +200,8 @@ private:
     } m_levelMeters;
 
     FourierTransform m_dataFT;
-    Deconvolution m_deconvolution, m_delayFinder;
+    Deconvolution m_deconvolution;
+    math::DelayFinder m_delayFinder;
 
     Averaging<float> m_deconvAvg;
     Averaging<float> m_magnitudeAvg, m_moduleAvg;
@@ -181,20 +210,26 @@ private:
 
     Container::array<Filter::BesselLPF<float>> m_moduleLPFs, m_magnitudeLPFs, m_deconvLPFs;
     Container::array<Filter::BesselLPF<Complex>> m_phaseLPFs;
-    Container::array<Meter> m_meters;
+    math::BinMeter m_binMeter;
+    math::SpectrumKernel m_spectrumKernel;
+    //! kernel output planes, averaged into the data when averaging is on
+    std::vector<float> m_binMagnitude, m_binModule, m_binSquared;
+    std::vector<Complex> m_binPhase;
 
     void calculateDataLength();
-    void averaging();
+    //! 0 when every tick takes one transform of the latest window
+    unsigned int hopSize() const noexcept;
+    void averageSpectrum();
+    void averageImpulse();
 
     bool m_enableCalibration, m_calibrationLoaded;
     QList<QVector<float>> m_calibrationList;
-    QVector<float> m_calibrationGain;
-    QVector<float> m_calibrationPhase;
     void applyCalibration();
 
     std::pair<std::shared_ptr<math::Filter>, std::shared_ptr<math::Filter>> m_inputFilters;
 
     void updateAudio();
+    void updateSubscription();
     void checkChannels();
 
 signals:
@@ -220,6 +255,7 @@ signals:
     void filtersFrequencyChanged(Filter::Frequency) override;
     void delayChanged(int) override;
     void inputFilterChanged(Meta::Measurement::InputFilter) override;
+    void overlapChanged(Meta::Measurement::Overlap) override;
 };
 
 #endif // MEASUREMENT_H
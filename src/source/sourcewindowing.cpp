@@ -20,6 +20,7 @@
 #include "sourcewindowing.h"
 #include "sourcelist.h"
 #include "stored.h"
+#include "math/complexkernel.h"
 
 Windowing::Windowing(QObject *parent) : Abstract::Source(parent), Meta::Windowing(),
     m_sampleRate(1), m_source(nullptr),
@@ -175,12 +176,17 @@ void Windowing::resizeData()
 
         // FFT:
         m_dataFT.setSize(timeDomainSize());
-        m_dataFT.setType(m_usedMode >= Mode::LTW1 ? FourierTransform::Log : FourierTransform::Fast);
+        if (m_usedMode == Mode::CQT) {
+            m_dataFT.setType(FourierTransform::MultiRate);
+        } else {
+            m_dataFT.setType(m_usedMode >= Mode::LTW1 ? FourierTransform::Log : FourierTransform::Fast);
+        }
         m_dataFT.setNorm(m_usedMode >= Mode::LTW1 ? FourierTransform::Lin : FourierTransform::Sqrt);
         m_dataFT.setAlign(FourierTransform::Center);
         m_dataFT.setSampleRate(sampleRate());
         switch (m_usedMode) {
         case Mode::LTW1:
+        case Mode::CQT:
             m_dataFT.setLogWindowDenominator(1);
             break;
         case Mode::LTW2:
@@ -197,24 +203,16 @@ void Windowing::resizeData()
 
         unsigned int i = 0;
         for (auto frequency : frequencyList) {
-            m_ftdata[i].frequency = frequency;
-            m_ftdata[i].coherence = 1;
+            m_frequency[i] = frequency;
+            m_coherence[i] = 1;
             i++;
             if (i >= frequencyDomainSize()) {
                 break;
             }
         }
-        //fill frequency data
-        int t = 0;
+        //fill time axis
         float kt = 1000.f / sampleRate();
-        for (unsigned int i = 0, j = timeDomainSize() / 2 - 1; i < timeDomainSize(); i++, j++, t++) {
-            if (t > static_cast<int>(timeDomainSize() / 2)) {
-                t -= static_cast<int>(timeDomainSize());
-                j -= timeDomainSize();
-            }
-
-            m_impulseData[j].time = t * kt;//ms
-        }
+        setImpulseTimeAxis(-static_cast<int>(timeDomainSize() / 2 - 1) * kt, kt);
         m_resize = false;
     }
 }
@@ -315,10 +313,10 @@ void Windowing::updateFromFrequencyDomain()
             c = 0;
         }
         auto complexMagnitude = i == 0 ? 0 : p * g;
-        m_ftdata[i].module = m;
-        m_ftdata[i].magnitude = g;
-        m_ftdata[i].phase = p;
-        m_ftdata[i].coherence = c;
+        m_module[i] = m;
+        m_magnitude[i] = g;
+        m_phase[i] = p;
+        m_coherence[i] = c;
         m_dataFT.set(                i,     complexMagnitude.conjugate(), 0);
         m_dataFT.set(timeDomainSize() - i - 1, complexMagnitude,             0);
     }
@@ -330,6 +328,7 @@ void Windowing::updateFromFrequencyDomain()
     int t = 0;
     float kt = 1000.f / sampleRate();
     float norm = 1.f / timeDomainSize();
+    setImpulseTimeAxis(-static_cast<int>(timeDomainSize() / 2 - 1) * kt, kt);
     for (unsigned int i = 0, j = timeDomainSize() / 2 - 1; i < timeDomainSize(); i++, j++, t++) {
 
         if (t > static_cast<int>(timeDomainSize() / 2)) {
@@ -337,8 +336,7 @@ void Windowing::updateFromFrequencyDomain()
             j -= timeDomainSize();
         }
 
-        m_impulseData[j].value = norm * m_dataFT.af(i).real;
-        m_impulseData[j].time = t * kt;//ms
+        m_impulse[j] = norm * m_dataFT.af(i).real;
     }
 }
 
@@ -365,6 +363,8 @@ void Windowing::updateFromTimeDomain(const Shared::Source &source)
     auto tukeyEnd  = center + sampleWide / 2;
 
     auto windowKoefficient = m_window.gain() / m_window.norm();
+    auto sourceStep = m_source->impulseTime(1) - m_source->impulseTime(0);
+    setImpulseTimeAxis(m_source->impulseTime(0) + from * sourceStep, sourceStep);
     int j = 0;
     for (int i = from/*, j = 0*/, f = timeDomainSize() / 2 + 1; i < end; ++i, ++j, time += dt, ++f) {
 
@@ -379,8 +379,7 @@ void Windowing::updateFromTimeDomain(const Shared::Source &source)
             }
         }
 
-        m_impulseData[j].value = value;
-        m_impulseData[j].time = m_source->impulseTime(i);
+        m_impulse[j] = value;
         if (f == timeDomainSize()) {
             f = 0;
         }
@@ -395,42 +394,46 @@ void Windowing::updateFromTimeDomain(const Shared::Source &source)
 
 void Windowing::transform()
 {
-    if (m_usedMode >= Mode::LTW1) {
+    if (m_usedMode == Mode::CQT) {
+        m_dataFT.transform();
+    } else if (m_usedMode >= Mode::LTW1) {
         m_dataFT.log();
     } else {
         m_dataFT.transformSingleChannel(true);
     }
 
+    Container::span<const Complex> spectrum {m_dataFT.afData(), frequencyDomainSize()};
+    math::ComplexKernel::abs(spectrum, m_magnitude);
+    math::ComplexKernel::normalize(spectrum, m_phase);
+
     auto criticalFrequency = 1000 / wide();
     for (unsigned i = 0; i < frequencyDomainSize(); ++i) {
         if (domain() == Windowing::SourceDomain::Time) {
-            m_ftdata[i].coherence = 1;
+            m_coherence[i] = 1;
         }
-        if (m_ftdata[i].frequency < criticalFrequency) {
-            m_ftdata[i].coherence = 0;
-        } else if (m_ftdata[i].frequency > criticalFrequency * 2) {
-            //m_ftdata[i].coherence *= 1;
+        if (frequency(i) < criticalFrequency) {
+            m_coherence[i] = 0;
+        } else if (frequency(i) > criticalFrequency * 2) {
+            //m_coherence[i] *= 1;
         } else {
-            m_ftdata[i].coherence *= (m_ftdata[i].frequency - criticalFrequency) / criticalFrequency;
+            m_coherence[i] *= (frequency(i) - criticalFrequency) / criticalFrequency;
         }
 
-        m_ftdata[i].magnitude   = m_dataFT.af(i).abs();
-        m_ftdata[i].module      = m_ftdata[i].magnitude;
-        m_ftdata[i].meanSquared = m_ftdata[i].magnitude * m_ftdata[i].magnitude;
-        m_ftdata[i].peakSquared = 0;
-        m_ftdata[i].phase       = m_dataFT.af(i).normalize();
+        m_module[i]      = m_magnitude[i];
+        m_meanSquared[i] = m_magnitude[i] * m_magnitude[i];
+        m_peakSquared[i] = 0;
         if (m_usedMode >= Mode::LTW1) {
             //forward result to reverse
-            m_ftdata[i].phase.imag = std::exchange(m_ftdata[i].phase.real, m_ftdata[i].phase.imag);
+            m_phase[i].imag = std::exchange(m_phase[i].real, m_phase[i].imag);
         }
 
         static float threshold1 = powf(10, -40 / 20);
         static float threshold2 = powf(10, -30 / 20);
 
-        if (m_ftdata[i].magnitude < threshold1) {
-            m_ftdata[i].coherence = 0;
-        } else if (m_ftdata[i].magnitude < threshold2) {
-            m_ftdata[i].coherence *= (m_ftdata[i].magnitude - threshold1) / (threshold2 - threshold1);
+        if (m_magnitude[i] < threshold1) {
+            m_coherence[i] = 0;
+        } else if (m_magnitude[i] < threshold2) {
+            m_coherence[i] *= (m_magnitude[i] - threshold1) / (threshold2 - threshold1);
         }
     }
 }
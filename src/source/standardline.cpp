@@ -106,15 +106,15 @@ void StandardLine::createELC()
     setFrequencyDomainSize(size);
     setTimeDomainSize(0);
     for (size_t i = 0; i < size; ++i) {
-        m_ftdata[i].frequency   = Math::EqualLoudnessContour::frequency(i);
-        m_ftdata[i].phase       = -INFINITY;
-        m_ftdata[i].module      = -INFINITY;
-        m_ftdata[i].coherence   = 1.f;
+        m_frequency[i]   = Math::EqualLoudnessContour::frequency(i);
+        m_phase[i]       = -INFINITY;
+        m_module[i]      = -INFINITY;
+        m_coherence[i]   = 1.f;
 
         auto Lp = Math::EqualLoudnessContour::loudness(i, loudness());
 
-        m_ftdata[i].module    = powf(10, (Lp - 140/*dB*/) / 20);
-        m_ftdata[i].magnitude = powf(10, (Lp - loudness()) / 20);
+        m_module[i]    = powf(10, (Lp - 140/*dB*/) / 20);
+        m_magnitude[i] = powf(10, (Lp - loudness()) / 20);
     }
 }
 
@@ -133,14 +133,14 @@ void StandardLine::createWeighting()
     for (size_t i = 0; i < frequencyDomainSize(); ++i) {
         auto f = std::pow(10, 0.1 * (i + 10));
 
-        m_ftdata[i].frequency   = f;
-        m_ftdata[i].phase       = -INFINITY;
-        m_ftdata[i].module      = -INFINITY;
-        m_ftdata[i].coherence   = 1.f;
+        m_frequency[i]   = f;
+        m_phase[i]       = -INFINITY;
+        m_module[i]      = -INFINITY;
+        m_coherence[i]   = 1.f;
 
         switch (m_mode) {
         case WEIGHTING_A:
-            m_ftdata[i].magnitude = pow(10, 1.997 / 20) * (
+            m_magnitude[i] = pow(10, 1.997 / 20) * (
                                         f4 * f4 * f * f * f * f /
                                         (
                                             (f * f + f1 * f1) *
@@ -152,7 +152,7 @@ void StandardLine::createWeighting()
             break;
 
         case WEIGHTING_B:
-            m_ftdata[i].magnitude = pow(10, 0.1696 / 20) * (
+            m_magnitude[i] = pow(10, 0.1696 / 20) * (
                                         f4 * f4 * f * f * f /
                                         (
                                             (f * f + f1 * f1) *
@@ -163,7 +163,7 @@ void StandardLine::createWeighting()
             break;
 
         case WEIGHTING_C:
-            m_ftdata[i].magnitude = pow(10, 0.0619 / 20) * (
+            m_magnitude[i] = pow(10, 0.0619 / 20) * (
                                         f4 * f4 * f * f /
                                         (
                                             (f * f + f1 * f1) *
@@ -191,6 +191,11 @@ void StandardLine::createFlat()
             setTimeDomainSize(pow(2, M::m_FFTsizes.at(M::FFT12)));
             break;
 
+        case M::Mode::CQT:
+            m_dataFT.setType(FourierTransform::MultiRate);
+            setTimeDomainSize(pow(2, M::m_FFTsizes.at(M::FFT12)));
+            break;
+
         default:
             m_dataFT.setType(FourierTransform::Fast);
             m_dataFT.setSize(pow(2, M::m_FFTsizes.at(transformMode())));
@@ -210,24 +215,24 @@ void StandardLine::createFlat()
 
     unsigned int i = 0;
     for (auto &frequency : frequencyList) {
-        m_ftdata[i].frequency   = frequency;
-        m_ftdata[i].module      = 1.f;
-        m_ftdata[i].coherence   = 1.f;
-        m_ftdata[i].magnitude   = 1.f;
-        m_ftdata[i].phase       = {1.f, 0.f};
+        m_frequency[i]   = frequency;
+        m_module[i]      = 1.f;
+        m_coherence[i]   = 1.f;
+        m_magnitude[i]   = 1.f;
+        m_phase[i]       = {1.f, 0.f};
         ++i;
     }
 
     int t = 0;
     float kt = 1000.f / sampleRate();
+    setImpulseTimeAxis(-static_cast<int>(timeDomainSize() / 2 - 1) * kt, kt);
     for (unsigned int i = 0, j = timeDomainSize() / 2 - 1; i < timeDomainSize(); i++, j++, t++) {
         if (t > static_cast<int>(timeDomainSize() / 2)) {
             t -= static_cast<int>(timeDomainSize());
             j -= timeDomainSize();
         }
 
-        m_impulseData[j].value = (t == 0 ? 1.f : 0.f);
-        m_impulseData[j].time  = t * kt;
+        m_impulse[j] = (t == 0 ? 1.f : 0.f);
     }
 
 }
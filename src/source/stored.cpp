@@ -23,10 +23,17 @@
 #include <QtMath>
 #include <QtEndian>
 #include "common/wavfile.h"
+#include "math/complexkernel.h"
 
-Stored::Stored(QObject *parent) : Abstract::Source(parent), Meta::Stored()
+Stored::Stored(QObject *parent) : Abstract::Source(parent), Meta::Stored(),
+    m_cache(), m_cacheDeferred(false), m_compact(), m_compactPointsPerOctave(DEFAULT_COMPACT_PPO)
 {
     setObjectName("Stored");
+    //the cache is updated before plots are notified
+    connect(this, &Stored::polarityChanged, this, &Stored::updateCache);
+    connect(this, &Stored::inverseChanged, this, &Stored::updateCache);
+    connect(this, &Stored::gainChanged, this, &Stored::updateCache);
+    connect(this, &Stored::delayChanged, this, &Stored::updateCache);
     connect(this, &Stored::polarityChanged, this, &Abstract::Source::readyRead);
     connect(this, &Stored::inverseChanged, this, &Abstract::Source::readyRead);
     connect(this, &Stored::ignoreCoherenceChanged, this, &Abstract::Source::readyRead);
@@ -37,7 +44,13 @@ Stored::Stored(QObject *parent) : Abstract::Source(parent), Meta::Stored()
 Shared::Source Stored::clone() const
 {
     auto cloned = std::make_shared<Stored>(parent());
+    cloned->m_cacheDeferred = true;
     cloned->build(*this);
+    {
+        std::lock_guard<std::mutex> guard(m_dataMutex);
+        cloned->m_compact = m_compact;
+        cloned->m_compactPointsPerOctave = m_compactPointsPerOctave;
+    }
     cloned->setActive(active());
     cloned->setName(name());
     cloned->setInverse(inverse());
@@ -46,13 +59,17 @@ Shared::Source Stored::clone() const
     cloned->setDelay(delay());
     cloned->setGain(gain());
     cloned->setNotes(notes());
+    cloned->m_cacheDeferred = false;
+    cloned->updateCache();
 
     return std::static_pointer_cast<Abstract::Source>(cloned);
 }
 
 void Stored::build (const Abstract::Source &source)
 {
+    m_compact.reset();
     source.copyTo(*this);
+    updateCache();
     emit readyRead();
 }
 
@@ -75,30 +92,50 @@ QJsonObject Stored::toJSON() const noexcept
     object["delay"]     = delay();
     object["gain"]      = gain();
 
+    //compact traces are saved in full resolution
+    const Stored *source = this;
+    std::shared_ptr<Stored> full;
+    if (m_compact) {
+        full = expanded();
+        source = full.get();
+        object["compact"] = true;
+    }
+    object["compactPointsPerOctave"] = static_cast<int>(m_compactPointsPerOctave);
+
+    auto frequencies = source->frequencies();
+    auto modules = source->modules();
+    auto magnitudes = source->magnitudesRaw();
+    auto coherences = source->coherences();
+    auto peaks = source->peaksSquared();
+    auto means = source->meansSquared();
+    std::vector<float> phases(source->phases().size());
+    math::ComplexKernel::arg(source->phases(), phases);
+
     QJsonArray ftdata;
-    for (unsigned int i = 0; i < frequencyDomainSize(); ++i) {
+    for (unsigned int i = 0; i < frequencies.size(); ++i) {
 
         //frequecy, module, magnitude, phase, coherence
         QJsonArray ftcell;
-        ftcell.append(static_cast<double>(m_ftdata[i].frequency  ));
-        ftcell.append(static_cast<double>(m_ftdata[i].module     ));
-        ftcell.append(static_cast<double>(m_ftdata[i].magnitude  ));
-        ftcell.append(static_cast<double>(m_ftdata[i].phase.arg()));
-        ftcell.append(static_cast<double>(m_ftdata[i].coherence  ));
-        ftcell.append(static_cast<double>(m_ftdata[i].peakSquared));
-        ftcell.append(static_cast<double>(m_ftdata[i].meanSquared));
+        ftcell.append(static_cast<double>(frequencies[i]));
+        ftcell.append(static_cast<double>(modules[i]    ));
+        ftcell.append(static_cast<double>(magnitudes[i] ));
+        ftcell.append(static_cast<double>(phases[i]     ));
+        ftcell.append(static_cast<double>(coherences[i] ));
+        ftcell.append(static_cast<double>(peaks[i]      ));
+        ftcell.append(static_cast<double>(means[i]      ));
 
         ftdata.append(ftcell);
     }
     object["ftdata"] = ftdata;
 
+    auto impulseValues = source->impulseValues();
     QJsonArray impulse;
-    for (unsigned int i = 0; i < timeDomainSize(); ++i) {
+    for (unsigned int i = 0; i < impulseValues.size(); ++i) {
 
         //time, value
         QJsonArray impulsecell;
-        impulsecell.append(static_cast<double>(m_impulseData[i].time));
-        impulsecell.append(static_cast<double>(m_impulseData[i].value.real));
+        impulsecell.append(static_cast<double>(source->Abstract::Source::impulseTime(i)));
+        impulsecell.append(static_cast<double>(impulseValues[i]));
         impulse.append(impulsecell);
     }
     object["impulse"] = impulse;
@@ -107,7 +144,9 @@ QJsonObject Stored::toJSON() const noexcept
 }
 void Stored::fromJSON(QJsonObject data, const SourceList *) noexcept
 {
+    m_cacheDeferred = true;
     Abstract::Source::fromJSON(data);
+    m_compact.reset();
 
     auto ftdata         = data["ftdata"].toArray();
     auto impulse        = data["impulse"].toArray();
@@ -117,19 +156,25 @@ void Stored::fromJSON(QJsonObject data, const SourceList *) noexcept
 
     for (int i = 0; i < ftdata.count(); i++) {
         auto row = ftdata[i].toArray();
-        if (row.count() > 0) m_ftdata[i].frequency    = static_cast<float>(row[0].toDouble());
-        if (row.count() > 1) m_ftdata[i].module       = static_cast<float>(row[1].toDouble());
-        if (row.count() > 2) m_ftdata[i].magnitude    = static_cast<float>(row[2].toDouble());
-        if (row.count() > 3) m_ftdata[i].phase.polar(   static_cast<float>(row[3].toDouble()));
-        if (row.count() > 4) m_ftdata[i].coherence    = static_cast<float>(row[4].toDouble());
-        if (row.count() > 5) m_ftdata[i].peakSquared  = static_cast<float>(row[5].toDouble());
-        if (row.count() > 6) m_ftdata[i].meanSquared  = static_cast<float>(row[6].toDouble());
+        if (row.count() > 0) m_frequency[i]    = static_cast<float>(row[0].toDouble());
+        if (row.count() > 1) m_module[i]       = static_cast<float>(row[1].toDouble());
+        if (row.count() > 2) m_magnitude[i]    = static_cast<float>(row[2].toDouble());
+        if (row.count() > 3) m_phase[i].polar(   static_cast<float>(row[3].toDouble()));
+        if (row.count() > 4) m_coherence[i]    = static_cast<float>(row[4].toDouble());
+        if (row.count() > 5) m_peakSquared[i]  = static_cast<float>(row[5].toDouble());
+        if (row.count() > 6) m_meanSquared[i]  = static_cast<float>(row[6].toDouble());
     }
+    internFrequencies();
 
     for (int i = 0; i < impulse.count(); i++) {
         auto row = impulse[i].toArray();
-        m_impulseData[i].time    = static_cast<float>(row[0].toDouble());
-        m_impulseData[i].value   = static_cast<float>(row[1].toDouble());
+        m_impulse[i] = static_cast<float>(row[1].toDouble());
+    }
+    if (impulse.count() > 1) {
+        auto timeAt = [&impulse](int i) {
+            return static_cast<float>(impulse[i].toArray()[0].toDouble());
+        };
+        setImpulseTimeAxis(timeAt(0), (timeAt(impulse.count() - 1) - timeAt(0)) / (impulse.count() - 1));
     }
 
     setPolarity(data["polarity"].toBool(false));
@@ -138,6 +183,11 @@ void Stored::fromJSON(QJsonObject data, const SourceList *) noexcept
     setDelay(data["delay"].toDouble(0));
     setGain( data["gain" ].toDouble(0));
     setNotes(data["notes"].toString());
+
+    setCompactPointsPerOctave(data["compactPointsPerOctave"].toInt(DEFAULT_COMPACT_PPO));
+    setCompact(data["compact"].toBool(false));
+    m_cacheDeferred = false;
+    updateCache();
 }
 
 bool Stored::save(const QUrl &fileName) const noexcept
@@ -160,6 +210,10 @@ bool Stored::save(const QUrl &fileName) const noexcept
 }
 bool Stored::saveCal(const QUrl &fileName) const noexcept
 {
+    if (m_compact) {
+        return expanded()->saveCal(fileName);
+    }
+
     QFile saveFile(fileName.toLocalFile());
     if (!saveFile.open(QIODevice::WriteOnly)) {
         qWarning("Couldn't open save file.");
@@ -225,17 +279,23 @@ bool Stored::saveCal(const QUrl &fileName) const noexcept
 
 bool Stored::saveFRD(const QUrl &fileName) const noexcept
 {
+    if (m_compact) {
+        return expanded()->saveFRD(fileName);
+    }
+
     QFile saveFile(fileName.toLocalFile());
     if (!saveFile.open(QIODevice::WriteOnly)) {
         qWarning("Couldn't open save file.");
         return false;
     }
     QTextStream out(&saveFile);
-    for (unsigned int i = 0; i < frequencyDomainSize(); ++i) {
+    auto frequencies = this->frequencies();
+    auto phases = phaseDegrees();
+    for (unsigned int i = 0; i < frequencies.size(); ++i) {
         auto m = magnitude(i);
-        auto p = m_ftdata[i].phase.arg() * 180.f / static_cast<float>(M_PI);
+        auto p = phases[i];
         if (std::isnormal(m) && std::isnormal(p)) {
-            out << m_ftdata[i].frequency << " " << m << " " << p << " " << coherence(i) << "\n";
+            out << frequencies[i] << " " << m << " " << p << " " << coherence(i) << "\n";
         }
     }
     saveFile.close();
@@ -243,6 +303,10 @@ bool Stored::saveFRD(const QUrl &fileName) const noexcept
 }
 bool Stored::saveTXT(const QUrl &fileName) const noexcept
 {
+    if (m_compact) {
+        return expanded()->saveTXT(fileName);
+    }
+
     QFile saveFile(fileName.toLocalFile());
     if (!saveFile.open(QIODevice::WriteOnly)) {
         qWarning("Couldn't open save file.");
@@ -251,13 +315,15 @@ bool Stored::saveTXT(const QUrl &fileName) const noexcept
     QTextStream out(&saveFile);
     out << "Created with Open Sound Meter\n\n";
 
-    for (unsigned int i = 0; i < frequencyDomainSize(); ++i) {
+    auto frequencies = this->frequencies();
+    auto phases = phaseDegrees();
+    for (unsigned int i = 0; i < frequencies.size(); ++i) {
         auto m = magnitude(i);
-        auto p = m_ftdata[i].phase.arg() * 180.f / static_cast<float>(M_PI);
+        auto p = phases[i];
         if (std::isnormal(m) && std::isnormal(p)) {
-            out << m_ftdata[i].frequency << "\t" << m << "\t" << p << "\t" << coherence(i) << "\n";
+            out << frequencies[i] << "\t" << m << "\t" << p << "\t" << coherence(i) << "\n";
         } else {
-            out << m_ftdata[i].frequency << "\t*\t*\t" << coherence(i) << "\n";
+            out << frequencies[i] << "\t*\t*\t" << coherence(i) << "\n";
         }
     }
     saveFile.close();
@@ -266,6 +332,10 @@ bool Stored::saveTXT(const QUrl &fileName) const noexcept
 
 bool Stored::saveCSV(const QUrl &fileName) const noexcept
 {
+    if (m_compact) {
+        return expanded()->saveCSV(fileName);
+    }
+
     QFile saveFile(fileName.toLocalFile());
     if (!saveFile.open(QIODevice::WriteOnly)) {
         qWarning("Couldn't open save file.");
@@ -273,13 +343,15 @@ bool Stored::saveCSV(const QUrl &fileName) const noexcept
     }
     QTextStream out(&saveFile);
 
-    for (unsigned int i = 0; i < frequencyDomainSize(); ++i) {
+    auto frequencies = this->frequencies();
+    auto phases = phaseDegrees();
+    for (unsigned int i = 0; i < frequencies.size(); ++i) {
         auto m = magnitude(i);
-        auto p = m_ftdata[i].phase.arg() * 180.f / static_cast<float>(M_PI);
+        auto p = phases[i];
         if (std::isnormal(m) && std::isnormal(p)) {
-            out << m_ftdata[i].frequency << "," << m << "," << p << "," << coherence(i) << "\n";
+            out << frequencies[i] << "," << m << "," << p << "," << coherence(i) << "\n";
         } else {
-            out << m_ftdata[i].frequency << ",*,*," << coherence(i) << "\n";
+            out << frequencies[i] << ",*,*," << coherence(i) << "\n";
         }
     }
     saveFile.close();
@@ -288,36 +360,51 @@ bool Stored::saveCSV(const QUrl &fileName) const noexcept
 
 bool Stored::saveWAV(const QUrl &fileName) const noexcept
 {
+    if (m_compact) {
+        return expanded()->saveWAV(fileName);
+    }
+
     WavFile file;
     QByteArray data;
     data.resize(timeDomainSize() * 4);
     auto dst = data.data();
     for (unsigned int i = 0; i < timeDomainSize(); ++i, dst += 4) {
-        qToLittleEndian(m_impulseData[i].value.real, dst);
+        qToLittleEndian(m_impulse[i], dst);
     }
 
-    int sampleRate = std::round(10 / std::abs(m_impulseData[1].time - m_impulseData[2].time)) * 100;
+    int sampleRate = std::round(10 / std::abs(impulseStep())) * 100;
     return file.save(fileName.toLocalFile(), sampleRate, data);
 }
 
 float Stored::module(unsigned int i) const noexcept {
-    return ::Abstract::Source::module(i) * std::pow(10, gain() / 20.f);
+    if (m_cache.active) {
+        return i < m_cache.module.size() ? m_cache.module[i] : 0;
+    }
+    return rawModule(i);
 }
 
 float Stored::magnitudeRaw(unsigned int i) const noexcept
 {
-    return std::pow(::Abstract::Source::magnitudeRaw(i), (inverse() ? -1 : 1)) * std::pow(10, gain() / 20.f);
+    if (m_cache.active) {
+        return i < m_cache.magnitudeRaw.size() ? m_cache.magnitudeRaw[i] : 0;
+    }
+    return rawMagnitude(i);
 }
 
 float Stored::magnitude(unsigned int i) const noexcept
 {
-    return (inverse() ? -1 : 1) * (::Abstract::Source::magnitude(i) + gain());
+    if (m_cache.active) {
+        return i < m_cache.magnitude.size() ? m_cache.magnitude[i] : 0;
+    }
+    return ::Abstract::Source::magnitude(i);
 }
 
 Complex Stored::phase(unsigned int i) const noexcept
 {
-    auto alpha = (polarity() ? M_PI : 0) - 2 * M_PI * delay() * frequency(i) / 1000.f;
-    return ::Abstract::Source::phase(i).rotate(alpha);
+    if (m_cache.active) {
+        return i < m_cache.phase.size() ? m_cache.phase[i] : 0;
+    }
+    return rawPhase(i);
 }
 
 float Stored::coherence(unsigned int i) const noexcept
@@ -325,7 +412,22 @@ float Stored::coherence(unsigned int i) const noexcept
     if (ignoreCoherence()) {
         return 1.f;
     }
-    return ::Abstract::Source::coherence(i);
+    return rawCoherence(i);
+}
+
+float Stored::peakSquared(unsigned int i) const noexcept
+{
+    return ::Abstract::Source::peakSquared(i);
+}
+
+float Stored::crestFactor(unsigned int i) const noexcept
+{
+    return ::Abstract::Source::crestFactor(i);
+}
+
+unsigned int Stored::timeDomainSize() const noexcept
+{
+    return m_compact ? m_compact->timeDomainSize() : ::Abstract::Source::timeDomainSize();
 }
 
 float Stored::impulseTime(unsigned int i) const noexcept
@@ -335,5 +437,188 @@ float Stored::impulseTime(unsigned int i) const noexcept
 
 float Stored::impulseValue(unsigned int i) const noexcept
 {
-    return (polarity() ? -1 : 1) * ::Abstract::Source::impulseValue(i) * std::pow(10, gain() / 20.f);
+    if (m_cache.active) {
+        if (m_compact) {
+            return rawImpulse(i) * m_cache.impulseFactor;
+        }
+        return i < m_cache.impulse.size() ? m_cache.impulse[i] : 0;
+    }
+    return rawImpulse(i);
+}
+
+void Stored::updateCache()
+{
+    lock();
+    rebuildCache();
+    unlock();
+}
+
+void Stored::rebuildCache()
+{
+    if (m_cacheDeferred) {
+        return;
+    }
+    m_cache.active = polarity() || inverse() || gain() != 0.f || delay() != 0.f;
+    if (!m_cache.active) {
+        m_cache = {};
+        return;
+    }
+
+    auto size = frequencyDomainSize();
+    float gainFactor = std::pow(10, gain() / 20.f);
+    m_cache.module.resize(size);
+    m_cache.magnitudeRaw.resize(size);
+    m_cache.magnitude.resize(size);
+    m_cache.phase.resize(size);
+    for (unsigned int i = 0; i < size; ++i) {
+        auto raw = rawMagnitude(i);
+        m_cache.module[i]       = rawModule(i) * gainFactor;
+        m_cache.magnitudeRaw[i] = std::pow(raw, (inverse() ? -1 : 1)) * gainFactor;
+        m_cache.magnitude[i]    = (inverse() ? -1 : 1) * (20.f * log10f(raw) + gain());
+        m_cache.phase[i]        = rawPhase(i);
+    }
+    math::ComplexKernel::rotateByDelay(m_cache.phase, frequencies(), delay(), polarity() ? M_PI : 0, m_cache.phase);
+
+    //a float copy of a compact impulse would outweigh the float16 one, it's scaled on access
+    m_cache.impulseFactor = (polarity() ? -1 : 1) * gainFactor;
+    if (m_compact) {
+        m_cache.impulse = {};
+        return;
+    }
+    auto timeSize = timeDomainSize();
+    m_cache.impulse.resize(timeSize);
+    for (unsigned int i = 0; i < timeSize; ++i) {
+        m_cache.impulse[i] = rawImpulse(i) * m_cache.impulseFactor;
+    }
+}
+
+bool Stored::compact() const noexcept
+{
+    return m_compact != nullptr;
+}
+
+void Stored::setCompact(bool compact)
+{
+    if (compact == this->compact()) {
+        return;
+    }
+
+    //the page file is written and read without the data lock
+    if (compact) {
+        ::Abstract::Data snapshot;
+        copyTo(snapshot);
+        auto compactData = CompactData::build(snapshot, m_compactPointsPerOctave);
+        if (!compactData) {
+            qWarning("Stored: full resolution couldn't be paged out, the trace isn't compacted.");
+            return;
+        }
+        auto bands = CompactData::bands(snapshot, m_compactPointsPerOctave);
+
+        //bands replace the planes, the impulse is kept by the compact data only
+        lock();
+        m_compact = std::move(compactData);
+        m_frequency   = {};
+        m_module      = {};
+        m_magnitude   = {};
+        m_phase       = {};
+        m_coherence   = {};
+        m_peakSquared = {};
+        m_meanSquared = {};
+        m_impulse     = {};
+        setFrequencyDomainData(std::move(bands));
+        rebuildCache();
+        unlock();
+    } else {
+        std::shared_ptr<const CompactData> compactData;
+        {
+            std::lock_guard<std::mutex> guard(m_dataMutex);
+            compactData = m_compact;
+        }
+        //bands are kept if the full resolution is lost
+        ::Abstract::Data full;
+        copyTo(full);
+        compactData->pageIn(full);
+        full.copyTo(*this);
+
+        lock();
+        m_compact.reset();
+        rebuildCache();
+        unlock();
+    }
+
+    emit compactChanged();
+    emit readyRead();
+}
+
+unsigned int Stored::compactPointsPerOctave() const noexcept
+{
+    return m_compactPointsPerOctave;
+}
+
+void Stored::setCompactPointsPerOctave(unsigned int ppo)
+{
+    if (ppo == 0 || ppo == m_compactPointsPerOctave) {
+        return;
+    }
+
+    bool rebuild = compact();
+    setCompact(false);
+    m_compactPointsPerOctave = ppo;
+    setCompact(rebuild);
+    emit compactPointsPerOctaveChanged();
+}
+
+std::shared_ptr<Stored> Stored::expanded() const
+{
+    auto full = std::make_shared<Stored>();
+    std::shared_ptr<const CompactData> compact;
+    {
+        std::lock_guard<std::mutex> guard(m_dataMutex);
+        compact = m_compact;
+    }
+    copyTo(*full);
+    if (compact) {
+        compact->pageIn(*full);
+    }
+    full->setPolarity(polarity());
+    full->setInverse(inverse());
+    full->setIgnoreCoherence(ignoreCoherence());
+    full->setDelay(delay());
+    full->setGain(gain());
+    return full;
+}
+
+std::vector<float> Stored::phaseDegrees() const
+{
+    std::vector<float> degrees(phases().size());
+    math::ComplexKernel::arg(phases(), degrees);
+    for (auto &value : degrees) {
+        value *= 180.f / static_cast<float>(M_PI);
+    }
+    return degrees;
+}
+
+float Stored::rawModule(unsigned int i) const noexcept
+{
+    return ::Abstract::Source::module(i);
+}
+
+float Stored::rawMagnitude(unsigned int i) const noexcept
+{
+    return ::Abstract::Source::magnitudeRaw(i);
+}
+
+Complex Stored::rawPhase(unsigned int i) const noexcept
+{
+    return ::Abstract::Source::phase(i);
+}
+
+float Stored::rawCoherence(unsigned int i) const noexcept
+{
+    return ::Abstract::Source::coherence(i);
+}
+
+float Stored::rawImpulse(unsigned int i) const noexcept
+{
+    return m_compact ? m_compact->impulseValue(i) : ::Abstract::Source::impulseValue(i);
 }
@@ -21,6 +21,7 @@
 #include <QJsonObject>
 #include "abstract/source.h"
 #include "meta/metastored.h"
+#include "compactdata.h"
 
 class Stored: public Abstract::Source, public Meta::Stored
 {
@@ -32,8 +33,16 @@ class Stored: public Abstract::Source, public Meta::Stored
     Q_PROPERTY(float gain READ gain WRITE setGain NOTIFY gainChanged)
     Q_PROPERTY(float delay READ delay WRITE setDelay NOTIFY delayChanged)
 
+    //local properties
+    Q_PROPERTY(bool compact READ compact WRITE setCompact NOTIFY compactChanged REVISION NO_API_REVISION)
+    Q_PROPERTY(unsigned int compactPointsPerOctave READ compactPointsPerOctave WRITE setCompactPointsPerOctave
+               NOTIFY compactPointsPerOctaveChanged REVISION NO_API_REVISION)
+
 public:
     explicit Stored(QObject *parent = nullptr);
+
+    const static unsigned int DEFAULT_COMPACT_PPO = 48;
+
     Shared::Source clone() const override;
     void build (const Abstract::Source &source);
 
@@ -53,10 +62,20 @@ public:
     float magnitude(unsigned int i) const noexcept override;
     Complex phase(unsigned int i) const noexcept override;
     float coherence(unsigned int i) const noexcept override;
+    float peakSquared(unsigned int i) const noexcept override;
+    float crestFactor(unsigned int i) const noexcept override;
 
+    unsigned int timeDomainSize() const noexcept override;
     float impulseTime(unsigned int i) const noexcept override;
     float impulseValue(unsigned int i) const noexcept override;
 
+    //! keep log-frequency bands with quantized values, full resolution is paged out
+    bool compact() const noexcept;
+    void setCompact(bool compact);
+
+    unsigned int compactPointsPerOctave() const noexcept;
+    void setCompactPointsPerOctave(unsigned int ppo);
+
 signals:
     void notesChanged() override;
     void polarityChanged() override;
@@ -64,6 +83,39 @@ signals:
     void ignoreCoherenceChanged() override;
     void gainChanged() override;
     void delayChanged() override;
+    void compactChanged();
+    void compactPointsPerOctaveChanged();
+
+private slots:
+    void updateCache();
+
+private:
+    //! values adjusted by gain, delay, polarity and inverse, built when they change. Call under lock
+    void rebuildCache();
+
+    //! full resolution copy for exports of a compact trace
+    std::shared_ptr<Stored> expanded() const;
+    //! stored phase of every bin in degrees, for exports
+    std::vector<float> phaseDegrees() const;
+
+    float rawModule(unsigned int i) const noexcept;
+    float rawMagnitude(unsigned int i) const noexcept;
+    Complex rawPhase(unsigned int i) const noexcept;
+    float rawCoherence(unsigned int i) const noexcept;
+    float rawImpulse(unsigned int i) const noexcept;
+
+    struct Cache {
+        bool active = false;
+        float impulseFactor = 1;
+        //! the impulse is not cached for compact traces
+        std::vector<float> module, magnitudeRaw, magnitude, impulse;
+        std::vector<Complex> phase;
+    } m_cache;
+    //! set while fromJSON() and clone() fill the trace in, the cache is built once at the end
+    bool m_cacheDeferred;
+
+    std::shared_ptr<const CompactData> m_compact;
+    unsigned int m_compactPointsPerOctave;
 };
 
 #endif // STORED_H
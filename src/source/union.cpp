@@ -19,6 +19,8 @@
 #include "stored.h"
 #include "sourcelist.h"
 #include "notifier.h"
+#include "common/trace.h"
+#include "math/complexkernel.h"
 #include <QJsonArray>
 #include <cmath>
 
@@ -186,6 +188,7 @@ void Union::calc() noexcept
     if (!active())
         return;
 
+    Trace::Scope trace(Trace::UnionCalc);
     {
         std::lock_guard<std::mutex> callGuard(s_calcmutex);
         std::lock_guard<std::mutex> guard(m_dataMutex);
@@ -226,6 +229,8 @@ void Union::calc() noexcept
         for (auto &s : sources) {
             if (s && s.get() != this) s->lock();
         }
+        //the result is on the frequency axis of the primary source
+        shareFrequencies(*primary);
 
         if (m_operation == Apply) {
             calcApply(primary);
@@ -317,22 +322,22 @@ void Union::calcPolar(unsigned int count, const Shared::Source &primary) noexcep
             phase = {1, 0};
         }
 
-        m_ftdata[i].frequency  = primary->frequency(i);
-        m_ftdata[i].module     = module;
-        m_ftdata[i].phase      = phase.normalize();
-        m_ftdata[i].magnitude  = magnitude;
-        m_ftdata[i].coherence  = coherence;
+        m_module[i]     = module;
+        m_phase[i]      = phase;
+        m_magnitude[i]  = magnitude;
+        m_coherence[i]  = coherence;
     }
+    math::ComplexKernel::normalize(m_phase, m_phase);
 
-    for (unsigned int i = 0; i < primary->timeDomainSize(); i++) {
-        m_impulseData[i].time = primary->impulseTime(i);
-        m_impulseData[i].value = NAN;
-    }
+    setImpulseTimeAxis(primary->impulseTime(0), primary->impulseTime(1) - primary->impulseTime(0));
+    std::fill(m_impulse.begin(), m_impulse.end(), NAN);
 }
 void Union::calcVector(unsigned int count, const Shared::Source &primary) noexcept
 {
     float coherence, coherenceWeight;
     Complex a, m, p;
+    m_moduleVectors.resize(primary->frequencyDomainSize());
+    m_peakVectors.resize(primary->frequencyDomainSize());
 
     for (unsigned int i = 0; i < primary->frequencyDomainSize(); i++) {
         a = primary->phase(i) * primary->module(i);
@@ -383,23 +388,25 @@ void Union::calcVector(unsigned int count, const Shared::Source &primary) noexce
         }
         coherence /= coherenceWeight;
 
-        m_ftdata[i].frequency  = primary->frequency(i);
-        m_ftdata[i].module     = a.abs();
-        m_ftdata[i].phase      = m.normalize();
-        m_ftdata[i].magnitude  = m.abs();
-        m_ftdata[i].coherence  = coherence;
-        m_ftdata[i].peakSquared = p.abs();
+        m_phase[i]      = m;
+        m_coherence[i]  = coherence;
+        m_moduleVectors[i] = a;
+        m_peakVectors[i]   = p;
     }
+    math::ComplexKernel::abs(m_moduleVectors, m_module);
+    math::ComplexKernel::abs(m_peakVectors, m_peakSquared);
+    math::ComplexKernel::abs(m_phase, m_magnitude);
+    math::ComplexKernel::normalize(m_phase, m_phase);
 
     if (primary->timeDomainSize() < 2) {
         return;
     }
 
+    setImpulseTimeAxis(primary->impulseTime(0), primary->impulseTime(1) - primary->impulseTime(0));
     for (unsigned int i = 0; i < primary->timeDomainSize(); i++) {
-        m_impulseData[i].time = primary->impulseTime(i);
-        m_impulseData[i].value = primary->impulseValue(i);
+        m_impulse[i] = primary->impulseValue(i);
     }
-    float dt = m_impulseData[1].time - m_impulseData[0].time;
+    float dt = impulseStep();
 
     for (unsigned int i = 0; i < primary->timeDomainSize(); i++) {
         for (auto it = m_sources.begin(); it != m_sources.end(); ++it) {
@@ -407,23 +414,27 @@ void Union::calcVector(unsigned int count, const Shared::Source &primary) noexce
                 continue;
             }
             float st = (*it)->impulseTime(i);
-            long offseted =  (long)i + (st - m_impulseData[i].time) / dt;
+            long offseted =  (long)i + (st - impulseTime(i)) / dt;
 
             if (*it && it != m_sources.begin() && offseted > 0 && offseted < timeDomainSize()) {
                 switch (m_operation) {
                 case Summation:
                 case Avg:
-                    m_impulseData[offseted].value += (*it)->impulseValue(i);
+                    m_impulse[offseted] += (*it)->impulseValue(i);
                     break;
                 case Subtract:
                 case Diff:
-                    m_impulseData[offseted].value -= (*it)->impulseValue(i);
+                    m_impulse[offseted] -= (*it)->impulseValue(i);
                     break;
                 case Min:
-                    m_impulseData[offseted].value = std::min(m_impulseData[offseted].value, Complex{(*it)->impulseValue(i)});
+                    if (std::abs((*it)->impulseValue(i)) < std::abs(m_impulse[offseted])) {
+                        m_impulse[offseted] = (*it)->impulseValue(i);
+                    }
                     break;
                 case Max:
-                    m_impulseData[offseted].value = std::max(m_impulseData[offseted].value, Complex{(*it)->impulseValue(i)});
+                    if (std::abs(m_impulse[offseted]) < std::abs((*it)->impulseValue(i))) {
+                        m_impulse[offseted] = (*it)->impulseValue(i);
+                    }
                     break;
                 case Apply:
                     //calculated in calcApply
@@ -437,7 +448,7 @@ void Union::calcVector(unsigned int count, const Shared::Source &primary) noexce
 
     if (m_operation == Avg) {
         for (unsigned int i = 0; i < primary->timeDomainSize(); i++) {
-            m_impulseData[i].value /= count;
+            m_impulse[i] /= count;
         }
     }
 }
@@ -510,17 +521,15 @@ void Union::calcdB(unsigned int count, const Shared::Source &primary) noexcept
         magnitude = std::pow(10, magnitude / 20.f);
         module    = std::pow(10, module / 20.f);
 
-        m_ftdata[i].frequency  = primary->frequency(i);
-        m_ftdata[i].module     = module;
-        m_ftdata[i].phase      = phase.normalize();
-        m_ftdata[i].magnitude  = magnitude;
-        m_ftdata[i].coherence  = coherence;
+        m_module[i]     = module;
+        m_phase[i]      = phase;
+        m_magnitude[i]  = magnitude;
+        m_coherence[i]  = coherence;
     }
+    math::ComplexKernel::normalize(m_phase, m_phase);
 
-    for (unsigned int i = 0; i < primary->timeDomainSize(); i++) {
-        m_impulseData[i].time = primary->impulseTime(i);
-        m_impulseData[i].value = NAN;
-    }
+    setImpulseTimeAxis(primary->impulseTime(0), primary->impulseTime(1) - primary->impulseTime(0));
+    std::fill(m_impulse.begin(), m_impulse.end(), NAN);
 }
 
 void Union::calcPower(unsigned int count, const Shared::Source &primary) noexcept
@@ -593,17 +602,15 @@ void Union::calcPower(unsigned int count, const Shared::Source &primary) noexcep
         magnitude = std::sqrt(magnitude);
         module    = std::sqrt(module);
 
-        m_ftdata[i].frequency  = primary->frequency(i);
-        m_ftdata[i].module     = module;
-        m_ftdata[i].phase      = phase.normalize();
-        m_ftdata[i].magnitude  = magnitude;
-        m_ftdata[i].coherence  = coherence;
+        m_module[i]     = module;
+        m_phase[i]      = phase;
+        m_magnitude[i]  = magnitude;
+        m_coherence[i]  = coherence;
     }
+    math::ComplexKernel::normalize(m_phase, m_phase);
 
-    for (unsigned int i = 0; i < primary->timeDomainSize(); i++) {
-        m_impulseData[i].time = primary->impulseTime(i);
-        m_impulseData[i].value = NAN;
-    }
+    setImpulseTimeAxis(primary->impulseTime(0), primary->impulseTime(1) - primary->impulseTime(0));
+    std::fill(m_impulse.begin(), m_impulse.end(), NAN);
 }
 
 void Union::calcApply(const Shared::Source &primary) noexcept
@@ -613,7 +620,7 @@ void Union::calcApply(const Shared::Source &primary) noexcept
 
     for (unsigned int i = 0; i < primary->frequencyDomainSize(); i++) {
         magnitude   = primary->magnitudeRaw(i);
-        phase       = primary->phase(i);
+        phase       = primary->phase(i).abs() > 0 ? primary->phase(i) : Complex {1, 0};
         module      = (primary)->module(i);
         coherence   = primary->coherence(i);
 
@@ -623,24 +630,26 @@ void Union::calcApply(const Shared::Source &primary) noexcept
                 magnitude *= (*it)->magnitudeRaw(i);
                 module    *= (*it)->magnitudeRaw(i);
                 coherence  = std::min(coherence, (*it)->coherence(i));
-                phase.polar(phase.arg() + (*it)->phase(i).arg());
+                //arguments add up, a zero phase has no argument and is skipped instead of zeroing the product
+                auto factor = (*it)->phase(i);
+                if (factor.abs() > 0) {
+                    phase *= factor.normalize();
+                }
             }
         }
         if (std::isnan(phase.real) || std::isnan(phase.imag)) {
             phase = {1, 0};
         }
 
-        m_ftdata[i].frequency  = primary->frequency(i);
-        m_ftdata[i].module     = module;
-        m_ftdata[i].phase      = phase.normalize();
-        m_ftdata[i].magnitude  = magnitude;
-        m_ftdata[i].coherence  = coherence;
+        m_module[i]     = module;
+        m_phase[i]      = phase;
+        m_magnitude[i]  = magnitude;
+        m_coherence[i]  = coherence;
     }
+    math::ComplexKernel::normalize(m_phase, m_phase);
 
-    for (unsigned int i = 0; i < primary->timeDomainSize(); i++) {
-        m_impulseData[i].time = primary->impulseTime(i);
-        m_impulseData[i].value = NAN;
-    }
+    setImpulseTimeAxis(primary->impulseTime(0), primary->impulseTime(1) - primary->impulseTime(0));
+    std::fill(m_impulse.begin(), m_impulse.end(), NAN);
 }
 
 bool Union::autoName() const
@@ -117,6 +117,8 @@ private:
     Operation m_operation;
     Type m_type;
     bool m_autoName;
+    //! module and peak vectors of calcVector, reduced to levels in one pass after the sum
+    std::vector<Complex> m_moduleVectors, m_peakVectors;
 
     static std::mutex s_calcmutex;
 };
@@ -15,12 +15,16 @@
  *  You should have received a copy of the GNU General Public License
  *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
+#include <algorithm>
 #include <qmath.h>
 #include <QUrl>
 #include <QJsonDocument>
 #include <QJsonArray>
+#include <QJsonObject>
 #include <QFile>
 #include <QFileInfo>
+#include <QSaveFile>
+#include <QThreadPool>
 
 #include "common/wavfile.h"
 #include "filtersource.h"
@@ -34,13 +38,243 @@
 #include "remote/items/groupitem.h"
 #include "union.h"
 
+namespace {
+
+//! the list is written as {"type":"sourcelsist","selected":N,"list":[item,...]}
+QByteArray listHeader(int selected)
+{
+    return "{\"type\":\"sourcelsist\",\"selected\":" + QByteArray::number(selected) + ",\"list\":[";
+}
+
+const QByteArray LIST_SEPARATOR = ",";
+const QByteArray LIST_FOOTER    = "]}";
+
+//! loaded items appended to the list per event
+constexpr std::size_t APPEND_BATCH = 8;
+
+QByteArray itemJson(const Shared::Source &item)
+{
+    QJsonObject itemJson;
+    itemJson["type"] = item->objectName();
+    itemJson["data"] = item->toJSON();
+    return QJsonDocument(itemJson).toJson(QJsonDocument::JsonFormat::Compact);
+}
+
+QString saveFilePath(const QUrl &fileName)
+{
+    QFileInfo fileInfo(fileName.toLocalFile());
+    return fileName.toLocalFile() + (fileInfo.completeSuffix().size() == 0 ? ".osm" : "");
+}
+
+/**
+ * @brief finds the items of the top level "list" array without parsing them
+ * @param head the document with an empty list
+ * @return false if there is no list
+ */
+bool splitList(const QByteArray &data, QByteArray &head, std::vector<std::pair<int, int>> &items)
+{
+    int depth = 0, keyStart = -1, itemStart = -1, listBegin = -1, listEnd = -1;
+    bool inString = false, escape = false, key = false, inList = false;
+    QByteArray lastKey;
+
+    for (int i = 0; i < data.size() && listEnd < 0; ++i) {
+        auto c = data.at(i);
+        if (inString) {
+            if (escape) {
+                escape = false;
+            } else if (c == '\\') {
+                escape = true;
+            } else if (c == '"') {
+                inString = false;
+                if (depth == 1 && key) {
+                    lastKey = data.mid(keyStart + 1, i - keyStart - 1);
+                    key = false;
+                }
+            }
+            continue;
+        }
+
+        switch (c) {
+        case '"':
+            inString = true;
+            keyStart = i;
+            break;
+        case ',':
+            key = (depth == 1);
+            break;
+        case '{':
+        case '[':
+            if (depth == 1 && c == '[' && lastKey == "list" && listBegin < 0) {
+                listBegin = i;
+                inList = true;
+            } else if (inList && depth == 2 && c == '{') {
+                itemStart = i;
+            }
+            ++depth;
+            key = (depth == 1);
+            break;
+        case '}':
+        case ']':
+            --depth;
+            if (inList && depth == 2 && c == '}' && itemStart >= 0) {
+                items.push_back({itemStart, i + 1 - itemStart});
+                itemStart = -1;
+            } else if (inList && depth == 1 && c == ']') {
+                listEnd = i + 1;
+            }
+            break;
+        }
+    }
+
+    if (listBegin < 0 || listEnd < 0) {
+        return false;
+    }
+    head = data.left(listBegin) + "[]" + data.mid(listEnd);
+    return true;
+}
+
+//! stored traces and groups of them don't depend on other sources and are built on workers
+bool detached(const QJsonObject &item)
+{
+    auto type = item["type"].toString();
+    if (type == "Stored") {
+        return true;
+    }
+    if (type == "Group") {
+        for (const auto &nested : item["data"].toObject()["list"].toArray()) {
+            if (!detached(nested.toObject())) {
+                return false;
+            }
+        }
+        return true;
+    }
+    return false;
+}
+
+bool detached(const Shared::Source &source)
+{
+    if (std::dynamic_pointer_cast<Stored>(source)) {
+        return true;
+    }
+    if (auto group = std::dynamic_pointer_cast<Source::Group>(source)) {
+        for (const auto &nested : *group->sourceList()) {
+            if (!detached(nested)) {
+                return false;
+            }
+        }
+        return true;
+    }
+    return false;
+}
+
+//! objects built on a worker are moved to the list thread before they are used
+void moveToThread(const Shared::Source &source, QThread *thread)
+{
+    source->moveToThread(thread);
+    if (auto group = std::dynamic_pointer_cast<Source::Group>(source)) {
+        for (const auto &nested : *group->sourceList()) {
+            moveToThread(nested, thread);
+        }
+    }
+}
+
+Shared::Source buildDetached(const QJsonObject &item, QThread *thread)
+{
+    Shared::Source source;
+    if (item["type"].toString() == "Stored") {
+        source = Shared::Source{std::make_shared<Stored>()};
+    } else {
+        source = Shared::Source{std::make_shared<Source::Group>()};
+    }
+    source->fromJSON(item["data"].toObject(), nullptr);
+    moveToThread(source, thread);
+    return source;
+}
+
+//! a copy of a detached source with the same uuid, workers serialize it while the list is edited
+Shared::Source snapshot(const Shared::Source &source)
+{
+    Shared::Source copy;
+    if (auto group = std::dynamic_pointer_cast<Source::Group>(source)) {
+        auto copiedGroup = std::make_shared<Source::Group>();
+        for (const auto &nested : *group->sourceList()) {
+            copiedGroup->sourceList()->appendItem(snapshot(nested));
+        }
+        copiedGroup->setActive(group->active());
+        copiedGroup->setName(group->name());
+        copy = Shared::Source{copiedGroup};
+    } else {
+        copy = source->clone();
+        copy->setParent(nullptr);
+    }
+    copy->setUuid(source->uuid());
+    copy->setColor(source->color());
+    copy->setSampleRate(source->sampleRate());
+    return copy;
+}
+
+} // namespace
+
+struct SourceList::IOTask {
+    QUrl fileName;
+    std::atomic<bool> cancelled {false};
+    std::mutex mutex;
+    std::size_t total = 0;
+
+    //save: sources are serialized one by one on the list thread, snapshots of detached ones on the workers,
+    //chunks are written in the list order by the worker which completes the next one
+    std::unique_ptr<QSaveFile> file;
+    std::size_t serialized = 0;
+    std::vector<QByteArray> chunks;
+    std::vector<bool> ready;
+    std::size_t written = 0;
+    bool failed = false;
+    bool finished = false;
+
+    //load: items replace the list in the file order on the list thread once all are parsed,
+    //a few per event
+    std::vector<QJsonObject> items;
+    std::vector<Shared::Source> sources;
+    std::size_t parsed = 0;
+    std::size_t appended = 0;
+    bool appending = false;
+    int selected = -1;
+
+    //! writes the completed chunks in order, true once when the file is committed or dropped
+    bool writeReady()
+    {
+        if (finished) {
+            return false;
+        }
+        for (; written < total && ready[written]; ++written) {
+            if (!failed && !cancelled) {
+                failed = (written > 0 && file->write(LIST_SEPARATOR) == -1) || file->write(chunks[written]) == -1;
+            }
+            chunks[written].clear();
+        }
+        if (written < total && !failed && !cancelled) {
+            return false;
+        }
+
+        finished = true;
+        if (!failed && !cancelled) {
+            failed = file->write(LIST_FOOTER) == -1 || !file->commit();
+        } else {
+            file->cancelWriting();
+        }
+        return true;
+    }
+};
+
 SourceList::SourceList(QObject *parent, bool appendMeasurement) :
     QObject(parent),
     m_items(0), m_checked(),
     m_currentFile(),
     m_colorIndex(3),
     m_selected(-1),
-    m_mutex()
+    m_mutex(),
+    m_index(), m_nestedConnections(), m_indexMutex(),
+    m_io(), m_ioActive(false), m_ioProgress(0), m_ioPool()
 {
     qRegisterMetaType<SourceList *>("SourceList*");
     m_items.reserve(64);
@@ -49,6 +283,16 @@ SourceList::SourceList(QObject *parent, bool appendMeasurement) :
         add<Measurement>();
     }
 }
+SourceList::~SourceList()
+{
+    if (m_io) {
+        m_io->cancelled = true;
+    }
+    if (m_ioPool) {
+        m_ioPool->waitForDone();
+    }
+}
+
 SourceList *SourceList::clone(QObject *parent, QUuid filter, bool unrollGroups) const
 {
     SourceList *list = new SourceList(parent, false);
@@ -150,26 +394,97 @@ std::lock_guard<std::mutex> SourceList::lock() const
 }
 Shared::Source SourceList::getByUUid(QUuid id) const noexcept
 {
-    for (auto &item : m_items) {
-        if (item && item->uuid() == id) {
-            return item;
-        }
+    std::lock_guard<std::mutex> guard(m_indexMutex);
+    auto it = m_index.constFind(id);
+    if (it != m_index.constEnd()) {
+        return Shared::Source{it->source.lock()};
+    }
+    return {};
+}
 
-        if (auto group = std::dynamic_pointer_cast<Source::Group>(item)) {
-            auto found = group->sourceList()->getByUUid(id);
-            if (found) {
-                return found;
+SourceList *SourceList::nestedList(const Shared::Source &item)
+{
+    if (auto group = std::dynamic_pointer_cast<Source::Group>(item)) {
+        return group->sourceList();
+    }
+    if (auto group = std::dynamic_pointer_cast<remote::GroupItem>(item)) {
+        return group->sourceList();
+    }
+    return nullptr;
+}
+
+void SourceList::index(const Shared::Source &item)
+{
+    if (!item) {
+        return;
+    }
+    indexOne(item);
+
+    if (auto list = nestedList(item)) {
+        std::vector<Shared::Source> nested;
+        {
+            std::lock_guard<std::mutex> guard(list->m_indexMutex);
+            nested.reserve(list->m_index.size());
+            for (auto &entry : list->m_index) {
+                if (auto source = entry.source.lock()) {
+                    nested.push_back(Shared::Source{source});
+                }
             }
         }
-        if (auto group = std::dynamic_pointer_cast<remote::GroupItem>(item)) {
-            auto found = group->sourceList()->getByUUid(id);
-            if (found) {
-                return found;
-            }
+        for (auto &source : nested) {
+            indexOne(source);
         }
+
+        m_nestedConnections[list] = {
+            connect(list, &SourceList::itemIndexed, this, [this](const Shared::Source & source) {
+                indexOne(source);
+            }),
+            connect(list, &SourceList::itemUnindexed, this, [this](QUuid id) {
+                unindexOne(id);
+            })
+        };
     }
+}
 
-    return {};
+void SourceList::unindex(const Shared::Source &item)
+{
+    if (!item) {
+        return;
+    }
+
+    if (auto list = nestedList(item)) {
+        for (auto &connection : m_nestedConnections.take(list)) {
+            disconnect(connection);
+        }
+
+        QList<QUuid> nested;
+        {
+            std::lock_guard<std::mutex> guard(list->m_indexMutex);
+            nested = list->m_index.keys();
+        }
+        for (auto &id : nested) {
+            unindexOne(id);
+        }
+    }
+    unindexOne(item->uuid());
+}
+
+void SourceList::indexOne(const Shared::Source &item)
+{
+    {
+        std::lock_guard<std::mutex> guard(m_indexMutex);
+        m_index.insert(item->uuid(), {item, nestedList(item) != nullptr});
+    }
+    emit itemIndexed(item);
+}
+
+void SourceList::unindexOne(const QUuid &id)
+{
+    {
+        std::lock_guard<std::mutex> guard(m_indexMutex);
+        m_index.remove(id);
+    }
+    emit itemUnindexed(id);
 }
 
 int SourceList::getIndexByUUid(QUuid id) const noexcept
@@ -203,6 +518,7 @@ void SourceList::clean() noexcept
         auto item = get_ref(0);
         emit preItemRemoved(item.uuid());
         m_items.removeAt(0);
+        unindex(item);
         emit postItemRemoved();
         item->destroy();
     }
@@ -289,6 +605,15 @@ QJsonArray SourceList::toJSON() const noexcept
 }
 
 void SourceList::fromJSON(const QJsonArray &list, const SourceList *topList) noexcept
+{
+    clean();
+
+    for (const auto &item : list) {
+        loadItem(item.toObject(), topList);
+    }
+}
+
+bool SourceList::loadItem(const QJsonObject &object, const SourceList *topList)
 {
     enum LoadType {MeasurementType, StoredType, UnionType, StandardLineType, FilterType, WindowingType, GroupType, EqualizerType};
     static std::map<QString, LoadType> typeMap = {
@@ -302,79 +627,69 @@ void SourceList::fromJSON(const QJsonArray &list, const SourceList *topList) noe
         {"Equalizer",    EqualizerType}
     };
 
-    clean();
-
-    for (const auto &item : list) {
-        auto object = item.toObject();
-
-        if (typeMap.find(object["type"].toString()) == typeMap.end())
-            continue;
+    if (typeMap.find(object["type"].toString()) == typeMap.end())
+        return false;
 
-        switch (typeMap.at(object["type"].toString())) {
-        case MeasurementType:
-            loadObject<Measurement>(object["data"].toObject(), topList);
-            break;
+    switch (typeMap.at(object["type"].toString())) {
+    case MeasurementType:
+        return loadObject<Measurement>(object["data"].toObject(), topList);
 
-        case StoredType:
-            loadObject<Stored>(object["data"].toObject(), topList);
-            break;
+    case StoredType:
+        return loadObject<Stored>(object["data"].toObject(), topList);
 
-        case UnionType:
-            loadObject<Union>(object["data"].toObject(), topList);
-            break;
+    case UnionType:
+        return loadObject<Union>(object["data"].toObject(), topList);
 
-        case StandardLineType:
-            loadObject<StandardLine>(object["data"].toObject(), topList);
-            break;
+    case StandardLineType:
+        return loadObject<StandardLine>(object["data"].toObject(), topList);
 
-        case FilterType:
-            loadObject<FilterSource>(object["data"].toObject(), topList);
-            break;
+    case FilterType:
+        return loadObject<FilterSource>(object["data"].toObject(), topList);
 
-        case WindowingType:
-            loadObject<Windowing>(object["data"].toObject(), topList);
-            break;
+    case WindowingType:
+        return loadObject<Windowing>(object["data"].toObject(), topList);
 
-        case GroupType:
-            loadObject<Source::Group>(object["data"].toObject(), topList);
-            break;
+    case GroupType:
+        return loadObject<Source::Group>(object["data"].toObject(), topList);
 
-        case EqualizerType:
-            loadObject<Source::Equalizer>(object["data"].toObject(), topList);
-            break;
-        }
+    case EqualizerType:
+        return loadObject<Source::Equalizer>(object["data"].toObject(), topList);
     }
+    return false;
 }
 
 bool SourceList::save(const QUrl &fileName) const noexcept
 {
-    QString addSuffix = "";
-
-    QFileInfo fileInfo(fileName.toLocalFile());
-    if (fileInfo.completeSuffix().size() == 0) {
-        addSuffix = ".osm";
-    }
-
-    QFile saveFile(fileName.toLocalFile() + addSuffix);
+    QSaveFile saveFile(saveFilePath(fileName));
     if (!saveFile.open(QIODevice::WriteOnly)) {
         qWarning("Couldn't open file");
         return false;
     }
-    auto guard = lock();
-
-    QJsonObject object;
-    object["type"] = "sourcelsist";
 
-    auto data = toJSON();
-    object["list"] = data;
-    object["selected"] = m_selected;
+    QVector<Shared::Source> items;
+    int selected;
+    {
+        auto guard = lock();
+        items = m_items;
+        selected = m_selected;
+    }
 
-    QJsonDocument document(object);
-    if (saveFile.write(document.toJson(QJsonDocument::JsonFormat::Compact)) != -1) {
-        return true;
+    bool first = true;
+    bool success = saveFile.write(listHeader(selected)) != -1;
+    for (const auto &item : items) {
+        if (!item || !success) {
+            continue;
+        }
+        success = (first || saveFile.write(LIST_SEPARATOR) != -1) && saveFile.write(itemJson(item)) != -1;
+        first = false;
     }
+    success = success && saveFile.write(LIST_FOOTER) != -1;
 
-    return false;
+    if (!success) {
+        saveFile.cancelWriting();
+        return false;
+    }
+    return saveFile.commit();
 }
 bool SourceList::load(const QUrl &fileName) noexcept
 {
@@ -413,6 +728,302 @@ bool SourceList::load(const QUrl &fileName) noexcept
     return false;
 }
 
+bool SourceList::saveAsync(const QUrl &fileName) noexcept
+{
+    if (m_ioActive) {
+        return false;
+    }
+
+    auto task = std::make_shared<IOTask>();
+    task->fileName = fileName;
+    task->file = std::make_unique<QSaveFile>(saveFilePath(fileName));
+    if (!task->file->open(QIODevice::WriteOnly)) {
+        qWarning("Couldn't open file");
+        return false;
+    }
+
+    {
+        auto guard = lock();
+        for (const auto &item : m_items) {
+            if (item) {
+                task->sources.push_back(item);
+            }
+        }
+        task->failed = task->file->write(listHeader(m_selected)) == -1;
+    }
+    task->total = task->sources.size();
+    task->chunks.resize(task->total);
+    task->ready.resize(task->total, false);
+    startIO(task);
+
+    if (task->total == 0) {
+        task->writeReady();
+        QMetaObject::invokeMethod(this, [this, task]() {
+            finishSave(task);
+        }, Qt::QueuedConnection);
+        return true;
+    }
+
+    serializeNext(task);
+    return true;
+}
+
+void SourceList::serializeNext(const std::shared_ptr<IOTask> &task)
+{
+    //sources read the list thread state, so they are serialized here, one per event,
+    //stored traces and groups of them are copied here and serialized on the worker
+    auto i = task->serialized++;
+    auto source = std::move(task->sources[i]);
+    QByteArray chunk;
+    Shared::Source copy;
+    if (!task->cancelled) {
+        if (detached(source)) {
+            copy = snapshot(source);
+            moveToThread(copy, nullptr);
+        } else {
+            chunk = itemJson(source);
+        }
+    }
+    source.reset();
+
+    ioPool()->start([this, task, chunk = std::move(chunk), copy = std::move(copy), i]() mutable {
+        if (copy && !task->cancelled) {
+            chunk = itemJson(copy);
+        }
+        copy.reset();
+
+        bool finished;
+        float progress;
+        {
+            std::lock_guard<std::mutex> guard(task->mutex);
+            task->chunks[i] = std::move(chunk);
+            task->ready[i] = true;
+            finished = task->writeReady();
+            progress = static_cast<float>(task->written) / task->total;
+        }
+
+        QMetaObject::invokeMethod(this, [this, task, progress]() {
+            setIOProgress(task, progress);
+        }, Qt::QueuedConnection);
+        if (finished) {
+            QMetaObject::invokeMethod(this, [this, task]() {
+                finishSave(task);
+            }, Qt::QueuedConnection);
+        }
+    });
+
+    if (task->serialized < task->total) {
+        QMetaObject::invokeMethod(this, [this, task]() {
+            serializeNext(task);
+        }, Qt::QueuedConnection);
+    }
+}
+
+void SourceList::finishSave(const std::shared_ptr<IOTask> &task)
+{
+    auto success = !task->failed && !task->cancelled;
+    auto cancelled = task->cancelled.load();
+    finishIO(task);
+    if (success) {
+        emit saved(task->fileName);
+    } else if (!cancelled) {
+        emit ioFailed(task->fileName);
+    }
+}
+
+bool SourceList::loadAsync(const QUrl &fileName) noexcept
+{
+    if (m_ioActive) {
+        return false;
+    }
+
+    auto task = std::make_shared<IOTask>();
+    task->fileName = fileName;
+    startIO(task);
+
+    ioPool()->start([this, task, listThread = thread()]() {
+        auto data = std::make_shared<QByteArray>();
+        QFile file(task->fileName.toLocalFile());
+        if (file.open(QIODevice::ReadOnly)) {
+            *data = file.readAll();
+        }
+
+        QByteArray head;
+        std::vector<std::pair<int, int>> spans;
+        QJsonDocument headDocument;
+        if (splitList(*data, head, spans)) {
+            headDocument = QJsonDocument::fromJson(head);
+        }
+
+        if (task->cancelled) {
+            QMetaObject::invokeMethod(this, [this, task]() {
+                finishIO(task);
+            }, Qt::QueuedConnection);
+            return;
+        }
+
+        //single source files are small, they are loaded the usual way
+        if (headDocument["type"].toString() != "sourcelsist") {
+            QMetaObject::invokeMethod(this, [this, task]() {
+                finishIO(task);
+                if (!load(task->fileName)) {
+                    emit ioFailed(task->fileName);
+                }
+            }, Qt::QueuedConnection);
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> guard(task->mutex);
+            task->total = spans.size();
+            task->items.resize(task->total);
+            task->sources.resize(task->total);
+            task->selected = headDocument["selected"].toInt(-1);
+        }
+        QMetaObject::invokeMethod(this, [this, task]() {
+            appendLoaded(task);
+        }, Qt::QueuedConnection);
+
+        for (std::size_t i = 0; i < spans.size(); ++i) {
+            ioPool()->start([this, task, data, span = spans[i], i, listThread]() {
+                QJsonObject object;
+                Shared::Source source;
+                if (!task->cancelled) {
+                    object = QJsonDocument::fromJson(
+                                 QByteArray::fromRawData(data->constData() + span.first, span.second)).object();
+                    if (detached(object)) {
+                        source = buildDetached(object, listThread);
+                    }
+                }
+                {
+                    std::lock_guard<std::mutex> guard(task->mutex);
+                    task->items[i] = std::move(object);
+                    task->sources[i] = std::move(source);
+                    ++task->parsed;
+                }
+                QMetaObject::invokeMethod(this, [this, task]() {
+                    appendLoaded(task);
+                }, Qt::QueuedConnection);
+            });
+        }
+    });
+    return true;
+}
+
+void SourceList::cancelIO() noexcept
+{
+    if (m_io) {
+        m_io->cancelled = true;
+    }
+}
+
+bool SourceList::ioActive() const noexcept
+{
+    return m_ioActive;
+}
+
+float SourceList::ioProgress() const noexcept
+{
+    return m_ioProgress;
+}
+
+QThreadPool *SourceList::ioPool()
+{
+    if (!m_ioPool) {
+        m_ioPool = std::make_unique<QThreadPool>();
+    }
+    return m_ioPool.get();
+}
+
+void SourceList::startIO(const std::shared_ptr<IOTask> &task)
+{
+    m_io = task;
+    m_ioActive = true;
+    m_ioProgress = 0;
+    emit ioActiveChanged();
+    emit ioProgressChanged();
+}
+
+void SourceList::finishIO(const std::shared_ptr<IOTask> &task)
+{
+    if (m_io != task) {
+        return;
+    }
+    m_io.reset();
+    m_ioActive = false;
+    emit ioActiveChanged();
+}
+
+void SourceList::setIOProgress(const std::shared_ptr<IOTask> &task, float progress)
+{
+    if (m_io != task || qFuzzyCompare(m_ioProgress, progress)) {
+        return;
+    }
+    m_ioProgress = progress;
+    emit ioProgressChanged();
+}
+
+void SourceList::appendLoaded(const std::shared_ptr<IOTask> &task)
+{
+    if (m_io != task || task->appending) {
+        return;
+    }
+    //the current list is kept until the whole file is parsed, a cancelled load leaves it as it was
+    if (task->cancelled) {
+        finishIO(task);
+        return;
+    }
+
+    std::size_t parsed;
+    {
+        std::lock_guard<std::mutex> guard(task->mutex);
+        parsed = task->parsed;
+    }
+    //parsing is the first half of the progress, appending the second
+    if (task->total) {
+        setIOProgress(task, 0.5f * parsed / task->total);
+    }
+    if (parsed < task->total) {
+        return;
+    }
+
+    task->appending = true;
+    clean();
+    m_currentFile = task->fileName;
+    appendNext(task);
+}
+
+void SourceList::appendNext(const std::shared_ptr<IOTask> &task)
+{
+    //the list is already replaced, so the load isn't cancelled from here on
+    auto end = std::min(task->appended + APPEND_BATCH, task->total);
+    for (; task->appended < end; ++task->appended) {
+        auto i = task->appended;
+        if (auto source = std::move(task->sources[i])) {
+            appendItem(source, false);
+            nextColor();
+        } else {
+            loadItem(task->items[i], this);
+        }
+        task->items[i] = {};
+    }
+    if (task->total) {
+        setIOProgress(task, 0.5f + 0.5f * task->appended / task->total);
+    }
+    if (task->appended < task->total) {
+        QMetaObject::invokeMethod(this, [this, task]() {
+            appendNext(task);
+        }, Qt::QueuedConnection);
+        return;
+    }
+    task->items.clear();
+
+    //unions and windowings look for their sources when the whole list is loaded
+    setSelected(task->selected < m_items.size() ? task->selected : -1);
+    emit loaded(task->fileName);
+    finishIO(task);
+}
+
 bool SourceList::import(const QUrl &fileName, int type)
 {
     if (type == -1) {
@@ -789,6 +1400,7 @@ void SourceList::appendItem(const Shared::Source &item, bool autocolor)
         item->setColor(nextColor());
     }
     m_items.append(item);
+    index(item);
     emit postItemAppended(item);
     emit countChanged();
 }
@@ -811,6 +1423,7 @@ void SourceList::removeItem(const Shared::Source &item, bool deleteItem)
             emit preItemRemoved(item.uuid());
             m_items.replace(i, Shared::Source{});
             m_items.removeAt(i);
+            unindex(item);
             if (deleteItem) {
                 item->destroy();
             }
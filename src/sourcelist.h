@@ -18,7 +18,11 @@
 #ifndef SOURCELIST_H
 #define SOURCELIST_H
 
+#include <atomic>
+#include <memory>
+#include <mutex>
 #include <QObject>
+#include <QHash>
 #include <QVector>
 #include <QString>
 #include <QUrl>
@@ -32,6 +36,7 @@ class Stored;
 class StandardLine;
 class FilterSource;
 class Windowing;
+class QThreadPool;
 
 class SourceList : public QObject
 {
@@ -43,11 +48,14 @@ class SourceList : public QObject
     Q_PROPERTY(Shared::Source selected READ selected NOTIFY selectedChanged)
     Q_PROPERTY(QColor highlightColor READ highlightColor NOTIFY selectedChanged)
     Q_PROPERTY(bool isRoot READ isRoot CONSTANT)
+    Q_PROPERTY(bool ioActive READ ioActive NOTIFY ioActiveChanged)
+    Q_PROPERTY(float ioProgress READ ioProgress NOTIFY ioProgressChanged)
     using iterator = QVector<Shared::Source>::iterator;
     using const_iterator = QVector<Shared::Source>::const_iterator;
 
 public:
     explicit SourceList(QObject *parent = nullptr, bool appendMeasurement = true);
+    ~SourceList() override;
     SourceList *clone(QObject *parent, QUuid filter = {}, bool unrollGroups = false) const;
 
     int count() const noexcept;
@@ -63,8 +71,25 @@ public:
     unsigned size() const;
 
     Q_INVOKABLE Shared::Source get(int i) const noexcept;
+    //! finds the source in this list or in nested groups, O(1)
     Q_INVOKABLE Shared::Source getByUUid(QUuid id) const noexcept;
     int getIndexByUUid(QUuid id) const noexcept;
+
+    //! sources of this list and of nested groups except the groups, in no particular order
+    template<typename T = Abstract::Source> std::vector<std::shared_ptr<T>> leaves() const
+    {
+        std::vector<std::shared_ptr<T>> list;
+        std::lock_guard<std::mutex> guard(m_indexMutex);
+        list.reserve(m_index.size());
+        for (auto &entry : m_index) {
+            if (!entry.group) {
+                if (auto source = std::dynamic_pointer_cast<T>(entry.source.lock())) {
+                    list.push_back(std::move(source));
+                }
+            }
+        }
+        return list;
+    }
     //Q_INVOKABLE Shared::Source getGroupByUUid(QUuid id) const noexcept;
     Q_INVOKABLE QUuid getUUid(int id) const noexcept;
     Q_INVOKABLE QUuid firstSource() const noexcept;
@@ -72,6 +97,13 @@ public:
     Q_INVOKABLE void reset() noexcept;
     Q_INVOKABLE bool save(const QUrl &fileName) const noexcept;
     Q_INVOKABLE bool load(const QUrl &fileName) noexcept;
+    //! serializes the sources one by one on the list thread, the file is written on the worker threads
+    Q_INVOKABLE bool saveAsync(const QUrl &fileName) noexcept;
+    //! parses the sources on the worker threads, they replace the list once the whole file is parsed
+    Q_INVOKABLE bool loadAsync(const QUrl &fileName) noexcept;
+    Q_INVOKABLE void cancelIO() noexcept;
+    bool ioActive() const noexcept;
+    float ioProgress() const noexcept;
     Q_INVOKABLE bool import(const QUrl &fileName, int type);
     Q_INVOKABLE bool importImpulse(const QUrl &fileName, QString separator);
     Q_INVOKABLE bool importWav(const QUrl &fileName) ;
@@ -151,16 +183,33 @@ signals:
 
     void selectedChanged();
     void loaded(QUrl fileName);
+    void saved(QUrl fileName);
+    void ioFailed(QUrl fileName);
+    void ioActiveChanged();
+    void ioProgressChanged();
 
     void countChanged();
 
+    //! a source is added to or removed from this list or from a nested group
+    void itemIndexed(const Shared::Source &);
+    void itemUnindexed(QUuid id);
+
 private:
     bool loadList(const QJsonDocument &document, const QUrl &fileName) noexcept;
+    bool loadItem(const QJsonObject &item, const SourceList *topList);
     template<typename T> bool loadObject(const QJsonObject &data, const SourceList *topList);
     template<typename T, typename... Ts> Shared::Source add(Ts...);
     bool importFile(const QUrl &fileName, QString separator);
     void appendItemsFrom(const SourceList *list, QUuid filter, bool unrollGroups);
 
+    //! the list of a group, which is searched by getByUUid
+    static SourceList *nestedList(const Shared::Source &item);
+    //! adds the item and the sources nested in it to the index
+    void index(const Shared::Source &item);
+    void unindex(const Shared::Source &item);
+    void indexOne(const Shared::Source &item);
+    void unindexOne(const QUuid &id);
+
     QVector<Shared::Source> m_items; //TODO: unordered_map<uuid, shared_ptr>
     QList<QUuid> m_checked{};
     QUrl m_currentFile;
@@ -174,6 +223,32 @@ private:
     int m_colorIndex;
     int m_selected;
     mutable std::mutex m_mutex;
+
+    struct IndexEntry {
+        std::weak_ptr<Abstract::Source> source;
+        bool group = false;
+    };
+    //! uuid of every source in the list and nested groups
+    QHash<QUuid, IndexEntry> m_index;
+    QHash<SourceList *, QList<QMetaObject::Connection>> m_nestedConnections;
+    mutable std::mutex m_indexMutex;
+
+    //! state of a running saveAsync or loadAsync, shared with the workers
+    struct IOTask;
+    std::shared_ptr<IOTask> m_io;
+    std::atomic<bool> m_ioActive;
+    float m_ioProgress;
+    QThreadPool *ioPool();
+    void startIO(const std::shared_ptr<IOTask> &task);
+    void finishIO(const std::shared_ptr<IOTask> &task);
+    void setIOProgress(const std::shared_ptr<IOTask> &task, float progress);
+    void serializeNext(const std::shared_ptr<IOTask> &task);
+    void finishSave(const std::shared_ptr<IOTask> &task);
+    void appendLoaded(const std::shared_ptr<IOTask> &task);
+    void appendNext(const std::shared_ptr<IOTask> &task);
+
+    //! destroyed first: waits for the workers while the list is still alive
+    std::unique_ptr<QThreadPool> m_ioPool;
 };
 
 #endif // SOURCELIST_H